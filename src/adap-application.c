@@ -7,6 +7,7 @@
 #include "config.h"
 #include "adap-application.h"
 #include "adap-main-private.h"
+#include "adap-style-manager-private.h"
 
 /**
  * AdapApplication:
@@ -37,14 +38,44 @@
  *
  * - `style-hc-dark.css` contains styles used when the system high contrast
  *   preference is enabled and [property@StyleManager:dark] is `TRUE`.
+ *
+ * When several of them are used at once, they take precedence in the order
+ * they are listed in: `style-hc-dark.css` over `style-hc.css` over
+ * `style-dark.css` over `style.css`.
+ *
+ * Only `style.css` is loaded on startup, the other stylesheets are loaded the
+ * first time they're needed. Use [method@Application.preload_stylesheets] to
+ * load them ahead of time instead.
  */
 
+typedef enum {
+  STYLE_VARIANT_DARK,
+  STYLE_VARIANT_HC,
+  STYLE_VARIANT_HC_DARK,
+  N_STYLE_VARIANTS,
+} StyleVariant;
+
+static const char * const style_variant_files[N_STYLE_VARIANTS] = {
+  "style-dark.css",
+  "style-hc.css",
+  "style-hc-dark.css",
+};
+
+typedef struct {
+  GtkStyleProvider *provider;
+  gboolean loaded;
+  gboolean enabled;
+} StyleVariantData;
+
 typedef struct
 {
   GtkStyleProvider *base_style_provider;
-  GtkStyleProvider *dark_style_provider;
-  GtkStyleProvider *hc_style_provider;
-  GtkStyleProvider *hc_dark_style_provider;
+  StyleVariantData variants[N_STYLE_VARIANTS];
+
+  char *base_path;
+  gboolean started;
+  gboolean preload_requested;
+  guint preload_idle_id;
 } AdapApplicationPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (AdapApplication, adap_application, GTK_TYPE_APPLICATION)
@@ -57,17 +88,40 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
-static inline void
-style_provider_set_enabled (GtkStyleProvider *provider,
-                            gboolean          enabled)
+static GtkStyleProvider *
+load_provider (const char *base_path,
+               const char *filename)
 {
-  if (enabled)
-    gtk_style_context_add_provider_for_display (gdk_display_get_default (),
-                                                provider,
-                                                GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-  else
-    gtk_style_context_remove_provider_for_display (gdk_display_get_default (),
-                                                   provider);
+  GtkCssProvider *provider;
+  char *path;
+
+  path = g_build_path ("/", base_path, filename, NULL);
+
+  if (!g_resources_get_info (path, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL, NULL, NULL)) {
+    g_free (path);
+    return NULL;
+  }
+
+  provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_resource (provider, path);
+
+  g_free (path);
+
+  return GTK_STYLE_PROVIDER (provider);
+}
+
+static void
+ensure_variant_loaded (AdapApplication *self,
+                       StyleVariant     variant)
+{
+  AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
+  StyleVariantData *data = &priv->variants[variant];
+
+  if (data->loaded)
+    return;
+
+  data->provider = load_provider (priv->base_path, style_variant_files[variant]);
+  data->loaded = TRUE;
 }
 
 static void
@@ -75,34 +129,91 @@ update_stylesheet (AdapApplication *self)
 {
   AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
   AdapStyleManager *manager = adap_style_manager_get_default ();
-  gboolean is_dark, is_hc;
+  GdkDisplay *display = gdk_display_get_default ();
+  gboolean enabled[N_STYLE_VARIANTS];
+  gboolean is_dark, is_hc, changed = FALSE;
+  int i;
+
+  if (!priv->base_path)
+    return;
 
   is_dark = adap_style_manager_get_dark (manager);
   is_hc = adap_style_manager_get_high_contrast (manager);
 
-  if (priv->dark_style_provider)
-    style_provider_set_enabled (priv->dark_style_provider, is_dark);
+  enabled[STYLE_VARIANT_DARK] = is_dark;
+  enabled[STYLE_VARIANT_HC] = is_hc;
+  enabled[STYLE_VARIANT_HC_DARK] = is_hc && is_dark;
+
+  for (i = 0; i < N_STYLE_VARIANTS; i++)
+    if (priv->variants[i].enabled != enabled[i])
+      changed = TRUE;
+
+  if (!changed)
+    return;
+
+  /* Providers with the same priority cascade in the order they are added, so
+   * always add the enabled ones in the same order. Otherwise the precedence
+   * of conflicting rules would depend on the order the preferences changed */
+  for (i = 0; i < N_STYLE_VARIANTS; i++) {
+    StyleVariantData *data = &priv->variants[i];
+
+    if (data->enabled && data->provider)
+      gtk_style_context_remove_provider_for_display (display, data->provider);
+  }
+
+  for (i = 0; i < N_STYLE_VARIANTS; i++) {
+    StyleVariantData *data = &priv->variants[i];
+
+    data->enabled = enabled[i];
 
-  if (priv->hc_style_provider)
-    style_provider_set_enabled (priv->hc_style_provider, is_hc);
+    if (!data->enabled)
+      continue;
 
-  if (priv->hc_dark_style_provider)
-    style_provider_set_enabled (priv->hc_dark_style_provider, is_hc && is_dark);
+    ensure_variant_loaded (self, i);
+
+    if (data->provider)
+      gtk_style_context_add_provider_for_display (display,
+                                                  data->provider,
+                                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+  }
 }
 
-static void
-init_provider_from_file (GtkStyleProvider **provider,
-                         GFile             *file)
+static gboolean
+preload_cb (AdapApplication *self)
 {
-  if (!g_file_query_exists (file, NULL)) {
-    g_clear_object (&file);
-    return;
+  AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
+  int i;
+
+  /* Load one stylesheet per iteration to avoid blocking the main loop */
+  for (i = 0; i < N_STYLE_VARIANTS; i++) {
+    if (priv->variants[i].loaded)
+      continue;
+
+    ensure_variant_loaded (self, i);
+
+    return G_SOURCE_CONTINUE;
   }
 
-  *provider = GTK_STYLE_PROVIDER (gtk_css_provider_new ());
-  gtk_css_provider_load_from_file (GTK_CSS_PROVIDER (*provider), file);
+  priv->preload_idle_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+start_preload (AdapApplication *self)
+{
+  AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
+  GdkDisplay *display = gdk_display_get_default ();
+
+  if (display)
+    adap_style_manager_preload_variants (adap_style_manager_get_for_display (display));
+
+  if (!priv->base_path || priv->preload_idle_id)
+    return;
 
-  g_clear_object (&file);
+  priv->preload_idle_id =
+    g_idle_add_full (G_PRIORITY_LOW, G_SOURCE_FUNC (preload_cb), self, NULL);
+  g_source_set_name_by_id (priv->preload_idle_id, "[adap] preload_cb");
 }
 
 static void
@@ -110,30 +221,14 @@ init_providers (AdapApplication *self)
 {
   AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
   const char *base_path;
-  char *base_uri;
-  GFile *base_file;
 
   base_path = g_application_get_resource_base_path (G_APPLICATION (self));
 
-  if (base_path == NULL)
+  if (base_path == NULL || adap_is_granite_present ())
     return;
 
-  base_uri = g_strconcat ("resource://", base_path, NULL);
-  base_file = g_file_new_for_uri (base_uri);
-
-  if (!adap_is_granite_present ()) {
-    init_provider_from_file (&priv->base_style_provider,
-                             g_file_get_child (base_file, "style.css"));
-    init_provider_from_file (&priv->dark_style_provider,
-                             g_file_get_child (base_file, "style-dark.css"));
-    init_provider_from_file (&priv->hc_style_provider,
-                             g_file_get_child (base_file, "style-hc.css"));
-    init_provider_from_file (&priv->hc_dark_style_provider,
-                             g_file_get_child (base_file, "style-hc-dark.css"));
-  }
-
-  g_object_unref (base_file);
-  g_free (base_uri);
+  priv->base_path = g_strdup (base_path);
+  priv->base_style_provider = load_provider (base_path, "style.css");
 }
 
 static void
@@ -172,6 +267,7 @@ static void
 adap_application_startup (GApplication *application)
 {
   AdapApplication *self = ADAP_APPLICATION (application);
+  AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
 
   G_APPLICATION_CLASS (adap_application_parent_class)->startup (application);
 
@@ -179,6 +275,11 @@ adap_application_startup (GApplication *application)
 
   init_providers (self);
   init_styling (self);
+
+  priv->started = TRUE;
+
+  if (priv->preload_requested)
+    start_preload (self);
 }
 
 static void
@@ -186,11 +287,15 @@ adap_application_dispose (GObject *object)
 {
   AdapApplication *self = ADAP_APPLICATION (object);
   AdapApplicationPrivate *priv = adap_application_get_instance_private (self);
+  int i;
 
+  g_clear_handle_id (&priv->preload_idle_id, g_source_remove);
   g_clear_object (&priv->base_style_provider);
-  g_clear_object (&priv->dark_style_provider);
-  g_clear_object (&priv->hc_style_provider);
-  g_clear_object (&priv->hc_dark_style_provider);
+
+  for (i = 0; i < N_STYLE_VARIANTS; i++)
+    g_clear_object (&priv->variants[i].provider);
+
+  g_clear_pointer (&priv->base_path, g_free);
 
   G_OBJECT_CLASS (adap_application_parent_class)->dispose (object);
 }
@@ -288,3 +393,35 @@ adap_application_get_style_manager (AdapApplication *self)
 
   return adap_style_manager_get_default ();
 }
+
+/**
+ * adap_application_preload_stylesheets:
+ * @self: an application
+ *
+ * Loads the dark and high contrast stylesheets of @self in idle time.
+ *
+ * The library's own stylesheets for the other color scheme and high contrast
+ * are preloaded as well.
+ *
+ * By default, `style-dark.css`, `style-hc.css` and `style-hc-dark.css` are
+ * only loaded the first time they're needed, which can cause a delay when
+ * switching to dark or high contrast appearance for the first time with large
+ * stylesheets. Call this function to load them in the background once the
+ * application has started instead.
+ *
+ * Since: 1.6
+ */
+void
+adap_application_preload_stylesheets (AdapApplication *self)
+{
+  AdapApplicationPrivate *priv;
+
+  g_return_if_fail (ADAP_IS_APPLICATION (self));
+
+  priv = adap_application_get_instance_private (self);
+
+  priv->preload_requested = TRUE;
+
+  if (priv->started)
+    start_preload (self);
+}
@@ -42,4 +42,7 @@ AdapApplication *adap_application_new (const char        *application_id,
 ADAP_AVAILABLE_IN_ALL
 AdapStyleManager *adap_application_get_style_manager (AdapApplication *self);
 
+ADAP_AVAILABLE_IN_1_6
+void adap_application_preload_stylesheets (AdapApplication *self);
+
 G_END_DECLS
@@ -15,6 +15,7 @@
 
 #include "adap-avatar.h"
 #include "adap-gizmo-private.h"
+#include "adap-style-manager-private.h"
 
 #define NUMBER_OF_COLORS 14
 
@@ -437,6 +438,8 @@ adap_avatar_class_init (AdapAvatarClass *klass)
   g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
 
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
+
+  adap_style_manager_ensure_fragment ("avatar");
 }
 
 static void
@@ -17,6 +17,7 @@
 #include "adap-gizmo-private.h"
 #include "adap-marshalers.h"
 #include "adap-spring-animation.h"
+#include "adap-style-manager-private.h"
 #include "adap-swipeable.h"
 #include "adap-swipe-tracker-private.h"
 #include "adap-widget-utils-private.h"
@@ -506,6 +507,8 @@ adap_bottom_sheet_class_init (AdapBottomSheetClass *klass)
                                    (GtkWidgetActionActivateFunc) sheet_close_cb);
 
   gtk_widget_class_set_css_name (widget_class, "bottom-sheet");
+
+  adap_style_manager_ensure_fragment ("bottom-sheet");
 }
 
 static void
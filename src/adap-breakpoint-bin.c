@@ -11,6 +11,7 @@
 #include "adap-breakpoint-bin-private.h"
 
 #include "adap-breakpoint-private.h"
+#include "adap-length-unit-private.h"
 #include "adap-widget-utils-private.h"
 
 /**
@@ -131,6 +132,25 @@
  * Since: 1.4
  */
 
+/**
+ * AdapBreakpointTransitionMode:
+ * @ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE: When the breakpoint changes, the
+ *   child is allocated at the new size with the old layout and rendered, and
+ *   that frame is shown until the new layout is ready.
+ * @ADAP_BREAKPOINT_TRANSITION_FAST: When the breakpoint changes, the last
+ *   rendered frame is shown until the new layout is ready. This avoids
+ *   rendering the child an extra time, but the frame may not match the new
+ *   size.
+ *
+ * Describes how [class@BreakpointBin] switches between breakpoints.
+ *
+ * New values may be added to this enumeration over time.
+ *
+ * See [property@BreakpointBin:transition-mode].
+ *
+ * Since: 1.6
+ */
+
 typedef struct {
   gboolean grab_focus;
   GtkDirectionType direction;
@@ -143,7 +163,28 @@ typedef struct
   GList *breakpoints;
   AdapBreakpoint *current_breakpoint;
 
+  /* Sizes for which the breakpoint checks would give range_breakpoint */
+  AdapBreakpointRange range;
+  AdapBreakpoint *range_breakpoint;
+  gboolean range_valid;
+
+  /* Sizes for which the breakpoint checks would give current_breakpoint */
+  AdapBreakpointRange current_range;
+  gboolean current_range_valid;
+
+  int hysteresis;
+  guint settle_frames;
+  guint settle_frame_count;
+  guint settle_tick_cb_id;
+  int settle_width;
+  int settle_height;
+
+  GtkSettings *settings;
+  double dpi;
+
   GskRenderNode *old_node;
+  GskRenderNode *last_node;
+  AdapBreakpointTransitionMode transition_mode;
   gboolean first_allocation;
   guint tick_cb_id;
 
@@ -172,6 +213,9 @@ enum {
   PROP_0,
   PROP_CHILD,
   PROP_CURRENT_BREAKPOINT,
+  PROP_TRANSITION_MODE,
+  PROP_HYSTERESIS,
+  PROP_SETTLE_FRAMES,
   LAST_PROP,
 };
 
@@ -267,6 +311,7 @@ breakpoint_changed_tick_cb (GtkWidget        *widget,
 
   priv->tick_cb_id = 0;
   g_clear_pointer (&priv->old_node, gsk_render_node_unref);
+  g_clear_pointer (&priv->last_node, gsk_render_node_unref);
   gtk_widget_set_child_visible (priv->child, TRUE);
   gtk_widget_queue_resize (GTK_WIDGET (self));
 
@@ -287,9 +332,143 @@ breakpoint_changed_tick_cb (GtkWidget        *widget,
 static void
 breakpoint_notify_condition_cb (AdapBreakpointBin *self)
 {
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+
+  priv->range_valid = FALSE;
+  priv->current_range_valid = FALSE;
+
   gtk_widget_queue_allocate (GTK_WIDGET (self));
 }
 
+static void
+notify_dpi_cb (AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+
+  priv->dpi = -1;
+
+  breakpoint_notify_condition_cb (self);
+}
+
+static double
+get_dpi (AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+  GtkSettings *settings = gtk_widget_get_settings (GTK_WIDGET (self));
+
+  if (settings != priv->settings) {
+    if (priv->settings)
+      g_signal_handlers_disconnect_by_func (priv->settings, notify_dpi_cb, self);
+
+    g_set_object (&priv->settings, settings);
+
+    g_signal_connect_object (settings, "notify::gtk-xft-dpi",
+                             G_CALLBACK (notify_dpi_cb), self,
+                             G_CONNECT_SWAPPED);
+
+    priv->dpi = -1;
+  }
+
+  if (priv->dpi < 0)
+    priv->dpi = adap_length_unit_get_dpi (settings);
+
+  return priv->dpi;
+}
+
+/* During a resize, the size usually stays within the range where the
+ * breakpoint can't change, so the conditions only need to be checked again
+ * when leaving it */
+static AdapBreakpoint *
+find_breakpoint (AdapBreakpointBin *self,
+                 int               width,
+                 int               height)
+{
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+  AdapBreakpoint *breakpoint = NULL;
+  double dpi;
+  GList *l;
+
+  if (priv->range_valid &&
+      width >= priv->range.min_width && width <= priv->range.max_width &&
+      height >= priv->range.min_height && height <= priv->range.max_height)
+    return priv->range_breakpoint;
+
+  dpi = get_dpi (self);
+
+  priv->range.min_width = G_MININT;
+  priv->range.max_width = G_MAXINT;
+  priv->range.min_height = G_MININT;
+  priv->range.max_height = G_MAXINT;
+
+  for (l = priv->breakpoints; l; l = l->next) {
+    if (adap_breakpoint_check_condition (l->data, dpi, width, height, &priv->range)) {
+      breakpoint = l->data;
+      break;
+    }
+  }
+
+  priv->range_breakpoint = breakpoint;
+  priv->range_valid = TRUE;
+
+  return breakpoint;
+}
+
+static gboolean
+settle_tick_cb (GtkWidget        *widget,
+                GdkFrameClock    *frame_clock,
+                AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+
+  if (++priv->settle_frame_count < priv->settle_frames)
+    return G_SOURCE_CONTINUE;
+
+  priv->settle_tick_cb_id = 0;
+  gtk_widget_queue_allocate (widget);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Checks whether switching from the current breakpoint to a different one
+ * should happen at this size, or be held off to avoid flipping back and forth
+ * while resizing */
+static gboolean
+should_switch_breakpoint (AdapBreakpointBin *self,
+                          int               width,
+                          int               height)
+{
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+
+  if (priv->first_allocation)
+    return TRUE;
+
+  if (priv->hysteresis > 0 && priv->current_range_valid &&
+      width + priv->hysteresis >= priv->current_range.min_width &&
+      width - priv->hysteresis <= priv->current_range.max_width &&
+      height + priv->hysteresis >= priv->current_range.min_height &&
+      height - priv->hysteresis <= priv->current_range.max_height)
+    return FALSE;
+
+  if (priv->settle_frames == 0)
+    return TRUE;
+
+  if (width != priv->settle_width || height != priv->settle_height) {
+    priv->settle_width = width;
+    priv->settle_height = height;
+    priv->settle_frame_count = 0;
+
+    if (!priv->settle_tick_cb_id)
+      priv->settle_tick_cb_id =
+        gtk_widget_add_tick_callback (GTK_WIDGET (self),
+                                      (GtkTickCallback) settle_tick_cb,
+                                      self, NULL);
+
+    return FALSE;
+  }
+
+  return priv->settle_frame_count >= priv->settle_frames;
+}
+
 static gboolean
 adap_breakpoint_bin_contains (GtkWidget *widget,
                              double     x,
@@ -316,6 +495,22 @@ adap_breakpoint_bin_snapshot (GtkWidget   *widget,
     return;
   }
 
+  /* Keep the last frame around to show it during the next transition */
+  if (priv->transition_mode == ADAP_BREAKPOINT_TRANSITION_FAST && priv->breakpoints) {
+    GtkSnapshot *child_snapshot = gtk_snapshot_new ();
+
+    GTK_WIDGET_CLASS (adap_breakpoint_bin_parent_class)->snapshot (GTK_WIDGET (self),
+                                                                  child_snapshot);
+
+    g_clear_pointer (&priv->last_node, gsk_render_node_unref);
+    priv->last_node = gtk_snapshot_free_to_node (child_snapshot);
+
+    if (priv->last_node)
+      gtk_snapshot_append_node (snapshot, priv->last_node);
+
+    return;
+  }
+
   GTK_WIDGET_CLASS (adap_breakpoint_bin_parent_class)->snapshot (GTK_WIDGET (self),
                                                                 snapshot);
 }
@@ -386,23 +581,24 @@ adap_breakpoint_bin_size_allocate (GtkWidget *widget,
 {
   AdapBreakpointBin *self = ADAP_BREAKPOINT_BIN (widget);
   AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
-  GList *l;
   GtkSnapshot *snapshot;
-  AdapBreakpoint *new_breakpoint = NULL;
-  GtkSettings *settings;
+  AdapBreakpoint *new_breakpoint;
 
   if (!priv->child)
     return;
 
-  settings = gtk_widget_get_settings (widget);
+  new_breakpoint = find_breakpoint (self, width, height);
 
-  for (l = priv->breakpoints; l; l = l->next) {
-    AdapBreakpoint *breakpoint = l->data;
+  if (new_breakpoint == priv->current_breakpoint) {
+    priv->settle_width = -1;
+    priv->settle_height = -1;
+  } else if (!should_switch_breakpoint (self, width, height)) {
+    new_breakpoint = priv->current_breakpoint;
+  }
 
-    if (adap_breakpoint_check_condition (breakpoint, settings, width, height)) {
-      new_breakpoint = breakpoint;
-      break;
-    }
+  if (new_breakpoint == priv->range_breakpoint) {
+    priv->current_range = priv->range;
+    priv->current_range_valid = TRUE;
   }
 
   if (new_breakpoint == priv->current_breakpoint) {
@@ -413,14 +609,20 @@ adap_breakpoint_bin_size_allocate (GtkWidget *widget,
   }
 
   if (!priv->first_allocation) {
-    priv->block_warnings = TRUE;
-    allocate_child (self, width, height, baseline);
-    priv->block_warnings = FALSE;
-
-    snapshot = gtk_snapshot_new ();
-    adap_breakpoint_bin_snapshot (widget, snapshot);
-
-    priv->old_node = gtk_snapshot_free_to_node (snapshot);
+    /* Skip allocating and rendering the old layout again. Without a previous
+     * frame, fall back to rendering it instead of showing a blank frame. */
+    if (priv->transition_mode == ADAP_BREAKPOINT_TRANSITION_FAST && priv->last_node) {
+      priv->old_node = gsk_render_node_ref (priv->last_node);
+    } else {
+      priv->block_warnings = TRUE;
+      allocate_child (self, width, height, baseline);
+      priv->block_warnings = FALSE;
+
+      snapshot = gtk_snapshot_new ();
+      adap_breakpoint_bin_snapshot (widget, snapshot);
+
+      priv->old_node = gtk_snapshot_free_to_node (snapshot);
+    }
 
     gtk_widget_set_child_visible (priv->child, FALSE);
   }
@@ -453,6 +655,18 @@ adap_breakpoint_bin_map (GtkWidget *widget)
   GTK_WIDGET_CLASS (adap_breakpoint_bin_parent_class)->map (GTK_WIDGET (self));
 }
 
+static void
+adap_breakpoint_bin_unmap (GtkWidget *widget)
+{
+  AdapBreakpointBin *self = ADAP_BREAKPOINT_BIN (widget);
+  AdapBreakpointBinPrivate *priv = adap_breakpoint_bin_get_instance_private (self);
+
+  /* The next allocation after mapping never transitions */
+  g_clear_pointer (&priv->last_node, gsk_render_node_unref);
+
+  GTK_WIDGET_CLASS (adap_breakpoint_bin_parent_class)->unmap (GTK_WIDGET (self));
+}
+
 static gboolean
 adap_breakpoint_bin_focus (GtkWidget        *widget,
                           GtkDirectionType  direction)
@@ -507,12 +721,28 @@ adap_breakpoint_bin_dispose (GObject *object)
     priv->tick_cb_id = 0;
   }
 
+  if (priv->settle_tick_cb_id) {
+    gtk_widget_remove_tick_callback (GTK_WIDGET (self), priv->settle_tick_cb_id);
+    priv->settle_tick_cb_id = 0;
+  }
+
   if (priv->breakpoints) {
     g_list_free_full (priv->breakpoints, g_object_unref);
     priv->breakpoints = NULL;
   }
 
   g_clear_pointer (&priv->delayed_focus, g_array_unref);
+  g_clear_pointer (&priv->old_node, gsk_render_node_unref);
+  g_clear_pointer (&priv->last_node, gsk_render_node_unref);
+
+  if (priv->settings) {
+    g_signal_handlers_disconnect_by_func (priv->settings, notify_dpi_cb, self);
+    g_clear_object (&priv->settings);
+  }
+
+  priv->range_breakpoint = NULL;
+  priv->range_valid = FALSE;
+  priv->current_range_valid = FALSE;
 
   G_OBJECT_CLASS (adap_breakpoint_bin_parent_class)->dispose (object);
 }
@@ -532,6 +762,15 @@ adap_breakpoint_bin_get_property (GObject    *object,
   case PROP_CURRENT_BREAKPOINT:
     g_value_set_object (value, adap_breakpoint_bin_get_current_breakpoint (self));
     break;
+  case PROP_TRANSITION_MODE:
+    g_value_set_enum (value, adap_breakpoint_bin_get_transition_mode (self));
+    break;
+  case PROP_HYSTERESIS:
+    g_value_set_int (value, adap_breakpoint_bin_get_hysteresis (self));
+    break;
+  case PROP_SETTLE_FRAMES:
+    g_value_set_uint (value, adap_breakpoint_bin_get_settle_frames (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -549,6 +788,15 @@ adap_breakpoint_bin_set_property (GObject      *object,
   case PROP_CHILD:
     adap_breakpoint_bin_set_child (self, g_value_get_object (value));
     break;
+  case PROP_TRANSITION_MODE:
+    adap_breakpoint_bin_set_transition_mode (self, g_value_get_enum (value));
+    break;
+  case PROP_HYSTERESIS:
+    adap_breakpoint_bin_set_hysteresis (self, g_value_get_int (value));
+    break;
+  case PROP_SETTLE_FRAMES:
+    adap_breakpoint_bin_set_settle_frames (self, g_value_get_uint (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -571,6 +819,7 @@ adap_breakpoint_bin_class_init (AdapBreakpointBinClass *klass)
   widget_class->compute_expand = adap_widget_compute_expand;
   widget_class->snapshot = adap_breakpoint_bin_snapshot;
   widget_class->map = adap_breakpoint_bin_map;
+  widget_class->unmap = adap_breakpoint_bin_unmap;
   widget_class->focus = adap_breakpoint_bin_focus;
   widget_class->grab_focus = adap_breakpoint_bin_grab_focus;
 
@@ -598,6 +847,63 @@ adap_breakpoint_bin_class_init (AdapBreakpointBinClass *klass)
                          ADAP_TYPE_BREAKPOINT,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdapBreakpointBin:transition-mode: (attributes org.gtk.Property.get=adap_breakpoint_bin_get_transition_mode org.gtk.Property.set=adap_breakpoint_bin_set_transition_mode)
+   *
+   * How to switch between breakpoints.
+   *
+   * Applying a breakpoint changes the layout, which only takes effect on the
+   * next frame, so a frame is shown in the meantime.
+   *
+   * With `ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE`, the child is rendered at the
+   * new size with the old layout to produce that frame. For large layouts,
+   * that can take as much time as a regular frame.
+   *
+   * With `ADAP_BREAKPOINT_TRANSITION_FAST`, the last rendered frame is reused
+   * instead. It may not match the new size, but doesn't require any extra
+   * work.
+   *
+   * Since: 1.6
+   */
+  props[PROP_TRANSITION_MODE] =
+    g_param_spec_enum ("transition-mode", NULL, NULL,
+                       ADAP_TYPE_BREAKPOINT_TRANSITION_MODE,
+                       ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdapBreakpointBin:hysteresis: (attributes org.gtk.Property.get=adap_breakpoint_bin_get_hysteresis org.gtk.Property.set=adap_breakpoint_bin_set_hysteresis)
+   *
+   * How far past a breakpoint's threshold the size must go before switching,
+   * in pixels.
+   *
+   * The current breakpoint is kept as long as the size stays within this
+   * distance of the sizes it applies to. This prevents flipping back and forth
+   * when resizing around a threshold.
+   *
+   * Since: 1.6
+   */
+  props[PROP_HYSTERESIS] =
+    g_param_spec_int ("hysteresis", NULL, NULL,
+                      0, G_MAXINT, 0,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdapBreakpointBin:settle-frames: (attributes org.gtk.Property.get=adap_breakpoint_bin_get_settle_frames org.gtk.Property.set=adap_breakpoint_bin_set_settle_frames)
+   *
+   * How many frames the size must stay the same before switching breakpoints.
+   *
+   * While the bin is being resized, the current breakpoint is kept, and the
+   * new one is only applied once the size has settled. If set to 0,
+   * breakpoints are switched immediately.
+   *
+   * Since: 1.6
+   */
+  props[PROP_SETTLE_FRAMES] =
+    g_param_spec_uint ("settle-frames", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 }
 
@@ -608,6 +914,9 @@ adap_breakpoint_bin_init (AdapBreakpointBin *self)
 
   priv->natural_width = -1;
   priv->natural_height = -1;
+  priv->dpi = -1;
+  priv->settle_width = -1;
+  priv->settle_height = -1;
   priv->enable_min_size_warnings = TRUE;
   priv->enable_overflow_warnings = TRUE;
 
@@ -794,6 +1103,169 @@ adap_breakpoint_bin_get_current_breakpoint (AdapBreakpointBin *self)
   return priv->current_breakpoint;
 }
 
+/**
+ * adap_breakpoint_bin_get_transition_mode: (attributes org.gtk.Method.get_property=transition-mode)
+ * @self: a breakpoint bin
+ *
+ * Gets how @self switches between breakpoints.
+ *
+ * Returns: the transition mode
+ *
+ * Since: 1.6
+ */
+AdapBreakpointTransitionMode
+adap_breakpoint_bin_get_transition_mode (AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_BREAKPOINT_BIN (self), ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE);
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  return priv->transition_mode;
+}
+
+/**
+ * adap_breakpoint_bin_set_transition_mode: (attributes org.gtk.Method.set_property=transition-mode)
+ * @self: a breakpoint bin
+ * @mode: the transition mode
+ *
+ * Sets how @self switches between breakpoints.
+ *
+ * See [property@BreakpointBin:transition-mode].
+ *
+ * Since: 1.6
+ */
+void
+adap_breakpoint_bin_set_transition_mode (AdapBreakpointBin            *self,
+                                        AdapBreakpointTransitionMode  mode)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_if_fail (ADAP_IS_BREAKPOINT_BIN (self));
+  g_return_if_fail (mode <= ADAP_BREAKPOINT_TRANSITION_FAST);
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  if (priv->transition_mode == mode)
+    return;
+
+  priv->transition_mode = mode;
+
+  g_clear_pointer (&priv->last_node, gsk_render_node_unref);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_TRANSITION_MODE]);
+}
+
+/**
+ * adap_breakpoint_bin_get_hysteresis: (attributes org.gtk.Method.get_property=hysteresis)
+ * @self: a breakpoint bin
+ *
+ * Gets how far past a breakpoint's threshold the size must go before switching.
+ *
+ * Returns: the hysteresis margin in pixels
+ *
+ * Since: 1.6
+ */
+int
+adap_breakpoint_bin_get_hysteresis (AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_BREAKPOINT_BIN (self), 0);
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  return priv->hysteresis;
+}
+
+/**
+ * adap_breakpoint_bin_set_hysteresis: (attributes org.gtk.Method.set_property=hysteresis)
+ * @self: a breakpoint bin
+ * @hysteresis: the hysteresis margin in pixels
+ *
+ * Sets how far past a breakpoint's threshold the size must go before switching.
+ *
+ * See [property@BreakpointBin:hysteresis].
+ *
+ * Since: 1.6
+ */
+void
+adap_breakpoint_bin_set_hysteresis (AdapBreakpointBin *self,
+                                   int               hysteresis)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_if_fail (ADAP_IS_BREAKPOINT_BIN (self));
+  g_return_if_fail (hysteresis >= 0);
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  if (priv->hysteresis == hysteresis)
+    return;
+
+  priv->hysteresis = hysteresis;
+
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_HYSTERESIS]);
+}
+
+/**
+ * adap_breakpoint_bin_get_settle_frames: (attributes org.gtk.Method.get_property=settle-frames)
+ * @self: a breakpoint bin
+ *
+ * Gets how many frames the size must stay the same before switching
+ * breakpoints.
+ *
+ * Returns: the number of frames
+ *
+ * Since: 1.6
+ */
+guint
+adap_breakpoint_bin_get_settle_frames (AdapBreakpointBin *self)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_BREAKPOINT_BIN (self), 0);
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  return priv->settle_frames;
+}
+
+/**
+ * adap_breakpoint_bin_set_settle_frames: (attributes org.gtk.Method.set_property=settle-frames)
+ * @self: a breakpoint bin
+ * @settle_frames: the number of frames
+ *
+ * Sets how many frames the size must stay the same before switching
+ * breakpoints.
+ *
+ * See [property@BreakpointBin:settle-frames].
+ *
+ * Since: 1.6
+ */
+void
+adap_breakpoint_bin_set_settle_frames (AdapBreakpointBin *self,
+                                      guint             settle_frames)
+{
+  AdapBreakpointBinPrivate *priv;
+
+  g_return_if_fail (ADAP_IS_BREAKPOINT_BIN (self));
+
+  priv = adap_breakpoint_bin_get_instance_private (self);
+
+  if (priv->settle_frames == settle_frames)
+    return;
+
+  priv->settle_frames = settle_frames;
+
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SETTLE_FRAMES]);
+}
+
 void
 adap_breakpoint_bin_set_warnings (AdapBreakpointBin *self,
                                  gboolean          min_size_warnings,
@@ -17,9 +17,15 @@
 #include <gtk/gtk.h>
 
 #include "adap-breakpoint.h"
+#include "adap-enums.h"
 
 G_BEGIN_DECLS
 
+typedef enum {
+  ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE,
+  ADAP_BREAKPOINT_TRANSITION_FAST,
+} AdapBreakpointTransitionMode;
+
 #define ADAP_TYPE_BREAKPOINT_BIN (adap_breakpoint_bin_get_type())
 
 ADAP_AVAILABLE_IN_1_4
@@ -53,4 +59,22 @@ void adap_breakpoint_bin_remove_breakpoint (AdapBreakpointBin *self,
 ADAP_AVAILABLE_IN_1_4
 AdapBreakpoint *adap_breakpoint_bin_get_current_breakpoint (AdapBreakpointBin *self);
 
+ADAP_AVAILABLE_IN_1_6
+AdapBreakpointTransitionMode adap_breakpoint_bin_get_transition_mode (AdapBreakpointBin            *self);
+ADAP_AVAILABLE_IN_1_6
+void                         adap_breakpoint_bin_set_transition_mode (AdapBreakpointBin            *self,
+                                                                      AdapBreakpointTransitionMode  mode);
+
+ADAP_AVAILABLE_IN_1_6
+int  adap_breakpoint_bin_get_hysteresis (AdapBreakpointBin *self);
+ADAP_AVAILABLE_IN_1_6
+void adap_breakpoint_bin_set_hysteresis (AdapBreakpointBin *self,
+                                        int               hysteresis);
+
+ADAP_AVAILABLE_IN_1_6
+guint adap_breakpoint_bin_get_settle_frames (AdapBreakpointBin *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_breakpoint_bin_set_settle_frames (AdapBreakpointBin *self,
+                                            guint             settle_frames);
+
 G_END_DECLS
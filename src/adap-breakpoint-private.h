@@ -16,12 +16,20 @@
 
 G_BEGIN_DECLS
 
+typedef struct {
+  int min_width;
+  int max_width;
+  int min_height;
+  int max_height;
+} AdapBreakpointRange;
+
 void adap_breakpoint_transition (AdapBreakpoint *from,
                                 AdapBreakpoint *to);
 
-gboolean adap_breakpoint_check_condition (AdapBreakpoint *self,
-                                         GtkSettings   *settings,
-                                         int            width,
-                                         int            height);
+gboolean adap_breakpoint_check_condition (AdapBreakpoint      *self,
+                                         double              dpi,
+                                         int                 width,
+                                         int                 height,
+                                         AdapBreakpointRange *range);
 
 G_END_DECLS
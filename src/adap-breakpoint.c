@@ -11,10 +11,11 @@
 #include "adap-breakpoint-private.h"
 
 #include "adap-gtkbuilder-utils-private.h"
-#include "adap-length-unit.h"
+#include "adap-length-unit-private.h"
 #include "adap-marshalers.h"
 
 #include <gobject/gvaluecollector.h>
+#include <math.h>
 
 /**
  * AdapBreakpoint:
@@ -161,59 +162,150 @@ struct _AdapBreakpointCondition
   } data;
 };
 
+/* Conditions are flattened into an array in prefix order, with lengths
+ * already converted to pixels. For multi conditions, size is the number of
+ * nodes in the subtree, so that the second operand can be skipped. */
+typedef struct {
+  ConditionType type;
+  int op;
+  double value;
+  guint size;
+} CompiledCondition;
+
+static guint
+compile_condition (AdapBreakpointCondition *self,
+                   double                  dpi,
+                   GArray                 *nodes)
+{
+  CompiledCondition node = { self->type, 0, 0, 1 };
+  guint index = nodes->len;
+
+  switch (self->type) {
+  case CONDITION_LENGTH:
+    node.op = self->data.length.type;
+    node.value = adap_length_unit_to_px_for_dpi (self->data.length.unit,
+                                                self->data.length.value,
+                                                dpi);
+    g_array_append_val (nodes, node);
+    break;
+
+  case CONDITION_RATIO:
+    node.op = self->data.ratio.type;
+    node.value = (double) self->data.ratio.width / self->data.ratio.height;
+    g_array_append_val (nodes, node);
+    break;
+
+  case CONDITION_MULTI:
+    node.op = self->data.multi.type;
+    g_array_append_val (nodes, node);
+
+    node.size += compile_condition (self->data.multi.condition_1, dpi, nodes);
+    node.size += compile_condition (self->data.multi.condition_2, dpi, nodes);
+
+    g_array_index (nodes, CompiledCondition, index).size = node.size;
+    break;
+
+  default:
+    g_assert_not_reached ();
+  }
+
+  return node.size;
+}
+
+static inline void
+narrow_range (int  value,
+              int  threshold,
+              int *min,
+              int *max)
+{
+  if (value >= threshold)
+    *min = MAX (*min, threshold);
+  else
+    *max = MIN (*max, threshold - 1);
+}
+
+/* Evaluates a compiled condition, and narrows @range down to the sizes for
+ * which the result stays the same */
 static gboolean
-check_condition (AdapBreakpointCondition *self,
-                 GtkSettings            *settings,
-                 int                     width,
-                 int                     height)
+check_compiled (const CompiledCondition *node,
+                int                      width,
+                int                      height,
+                AdapBreakpointRange      *range)
 {
-  g_assert (self != NULL);
+  double threshold;
 
-  if (self->type == CONDITION_MULTI) {
-    gboolean check_1 = check_condition (self->data.multi.condition_1,
-                                        settings, width, height);
-    gboolean check_2 = check_condition (self->data.multi.condition_2,
-                                        settings, width, height);
+  switch (node->type) {
+  case CONDITION_MULTI:
+    {
+      const CompiledCondition *node_2 = node + 1 + node[1].size;
+      gboolean check_1 = check_compiled (node + 1, width, height, range);
+
+      if (node->op == MULTI_CONDITION_ALL && !check_1)
+        return FALSE;
 
-    if (self->data.multi.type == MULTI_CONDITION_ALL)
-      return check_1 && check_2;
+      if (node->op == MULTI_CONDITION_ANY && check_1)
+        return TRUE;
+
+      return check_compiled (node_2, width, height, range);
+    }
+
+  case CONDITION_LENGTH:
+    /* Sizes are integer, so the result can only change at these values */
+    if (node->op == ADAP_BREAKPOINT_CONDITION_MIN_WIDTH ||
+        node->op == ADAP_BREAKPOINT_CONDITION_MIN_HEIGHT)
+      threshold = ceil (node->value);
     else
-      return check_1 || check_2;
-  }
+      threshold = floor (node->value) + 1;
 
-  if (self->type == CONDITION_LENGTH) {
-    double value_px = adap_length_unit_to_px (self->data.length.unit,
-                                             self->data.length.value,
-                                             settings);
+    threshold = CLAMP (threshold, G_MININT + 1, G_MAXINT);
 
-    switch (self->data.length.type) {
+    switch (node->op) {
     case ADAP_BREAKPOINT_CONDITION_MIN_WIDTH:
-      return width >= value_px;
     case ADAP_BREAKPOINT_CONDITION_MAX_WIDTH:
-      return width <= value_px;
+      if (range)
+        narrow_range (width, threshold, &range->min_width, &range->max_width);
+      break;
     case ADAP_BREAKPOINT_CONDITION_MIN_HEIGHT:
-      return height >= value_px;
     case ADAP_BREAKPOINT_CONDITION_MAX_HEIGHT:
-      return height <= value_px;
+      if (range)
+        narrow_range (height, threshold, &range->min_height, &range->max_height);
+      break;
     default:
       g_assert_not_reached ();
     }
-  }
 
-  if (self->type == CONDITION_RATIO) {
-    double ratio = (double) self->data.ratio.width / self->data.ratio.height;
+    switch (node->op) {
+    case ADAP_BREAKPOINT_CONDITION_MIN_WIDTH:
+      return width >= node->value;
+    case ADAP_BREAKPOINT_CONDITION_MAX_WIDTH:
+      return width <= node->value;
+    case ADAP_BREAKPOINT_CONDITION_MIN_HEIGHT:
+      return height >= node->value;
+    case ADAP_BREAKPOINT_CONDITION_MAX_HEIGHT:
+      return height <= node->value;
+    default:
+      g_assert_not_reached ();
+    }
 
-    switch (self->data.ratio.type) {
+  case CONDITION_RATIO:
+    /* The ratio depends on both dimensions, only the current size is safe */
+    if (range) {
+      range->min_width = range->max_width = width;
+      range->min_height = range->max_height = height;
+    }
+
+    switch (node->op) {
     case ADAP_BREAKPOINT_CONDITION_MIN_ASPECT_RATIO:
-      return (double) width / height >= ratio;
+      return (double) width / height >= node->value;
     case ADAP_BREAKPOINT_CONDITION_MAX_ASPECT_RATIO:
-      return (double) width / height <= ratio;
+      return (double) width / height <= node->value;
     default:
       g_assert_not_reached ();
     }
-  }
 
-  g_assert_not_reached ();
+  default:
+    g_assert_not_reached ();
+  }
 }
 
 /**
@@ -981,6 +1073,9 @@ struct _AdapBreakpoint
   AdapBreakpointCondition *condition;
   GHashTable *setters;
   gboolean active;
+
+  GArray *compiled;
+  double compiled_dpi;
 };
 
 static void adap_breakpoint_buildable_init (GtkBuildableIface *iface);
@@ -1023,6 +1118,40 @@ find_pspec (GObject    *object,
 
 static void free_setter_data (SetterData *data);
 
+/* Sets @value on @object unless it already has it. If @frozen is set, @object
+ * has its notifications frozen and is added to it, so that each object only
+ * emits its notifications once all setters have been applied */
+static void
+apply_setter (SetterData   *setter,
+              const GValue *value,
+              GHashTable   *frozen)
+{
+  GValue current_value = G_VALUE_INIT;
+  gboolean changed;
+
+  g_value_init (&current_value, setter->pspec->value_type);
+  g_object_get_property (setter->object, setter->pspec->name, &current_value);
+  changed = g_param_values_cmp (setter->pspec, &current_value, value) != 0;
+  g_value_unset (&current_value);
+
+  if (!changed)
+    return;
+
+  if (frozen && !g_hash_table_contains (frozen, setter->object)) {
+    g_object_freeze_notify (setter->object);
+    g_hash_table_add (frozen, g_object_ref (setter->object));
+  }
+
+  g_object_set_property (setter->object, setter->pspec->name, value);
+}
+
+static void
+thaw_object (GObject *object)
+{
+  g_object_thaw_notify (object);
+  g_object_unref (object);
+}
+
 static void
 setter_weak_notify (SetterData *setter,
                     GObject    *where_the_object_was)
@@ -1070,6 +1199,7 @@ adap_breakpoint_dispose (GObject *object)
 
   g_clear_pointer (&self->condition, adap_breakpoint_condition_free);
   g_clear_pointer (&self->setters, g_hash_table_unref);
+  g_clear_pointer (&self->compiled, g_array_unref);
 
   G_OBJECT_CLASS (adap_breakpoint_parent_class)->dispose (object);
 }
@@ -1522,6 +1652,7 @@ adap_breakpoint_set_condition (AdapBreakpoint          *self,
     return;
 
   g_clear_pointer (&self->condition, adap_breakpoint_condition_free);
+  g_clear_pointer (&self->compiled, g_array_unref);
 
   if (condition)
     self->condition = adap_breakpoint_condition_copy (condition);
@@ -1641,9 +1772,7 @@ adap_breakpoint_add_setter (AdapBreakpoint *self,
   g_hash_table_insert (self->setters, setter, setter);
 
   if (self->active)
-    g_object_set_property (setter->object,
-                           setter->pspec->name,
-                           &setter->value);
+    apply_setter (setter, &setter->value, NULL);
 }
 
 /**
@@ -1783,12 +1912,16 @@ adap_breakpoint_transition (AdapBreakpoint *from,
 {
   GHashTableIter iter;
   SetterData *setter;
+  GHashTable *frozen;
 
   g_assert (!from || ADAP_IS_BREAKPOINT (from));
   g_assert (!from || from->active);
   g_assert (!to || ADAP_IS_BREAKPOINT (to));
   g_assert (!to || !to->active);
 
+  frozen = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                  (GDestroyNotify) thaw_object, NULL);
+
   if (from) {
     g_signal_emit (from, signals[SIGNAL_UNAPPLY], 0);
     from->active = FALSE;
@@ -1800,36 +1933,62 @@ adap_breakpoint_transition (AdapBreakpoint *from,
       if (to && g_hash_table_contains (to->setters, setter))
         continue;
 
-      g_object_set_property (setter->object,
-                             setter->pspec->name,
-                             &setter->original_value);
+      apply_setter (setter, &setter->original_value, frozen);
     }
   }
 
   if (to) {
     g_hash_table_iter_init (&iter, to->setters);
 
-    while (g_hash_table_iter_next (&iter, NULL, (gpointer) &setter)) {
-      g_object_set_property (setter->object,
-                             setter->pspec->name,
-                             &setter->value);
-    }
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer) &setter))
+      apply_setter (setter, &setter->value, frozen);
+  }
 
+  g_hash_table_unref (frozen);
+
+  if (to) {
     to->active = TRUE;
     g_signal_emit (to, signals[SIGNAL_APPLY], 0);
   }
 }
 
+/*
+ * adap_breakpoint_check_condition:
+ * @self: a breakpoint
+ * @dpi: the DPI to convert pt and sp lengths with
+ * @width: the width to check
+ * @height: the height to check
+ * @range: (nullable) (inout): the range to narrow down
+ *
+ * Checks whether the condition of @self is true for @width and @height.
+ *
+ * If @range is set, it's narrowed down so that the result is the same for any
+ * size within it.
+ *
+ * The condition is compiled the first time it's checked, and again only when
+ * it or @dpi change.
+ */
 gboolean
-adap_breakpoint_check_condition (AdapBreakpoint *self,
-                                GtkSettings   *settings,
-                                int            width,
-                                int            height)
+adap_breakpoint_check_condition (AdapBreakpoint      *self,
+                                double              dpi,
+                                int                 width,
+                                int                 height,
+                                AdapBreakpointRange *range)
 {
   g_assert (ADAP_IS_BREAKPOINT (self));
 
   if (!self->condition)
     return FALSE;
 
-  return check_condition (self->condition, settings, width, height);
+  if (!self->compiled || !G_APPROX_VALUE (self->compiled_dpi, dpi, DBL_EPSILON)) {
+    g_clear_pointer (&self->compiled, g_array_unref);
+
+    self->compiled = g_array_new (FALSE, FALSE, sizeof (CompiledCondition));
+    self->compiled_dpi = dpi;
+
+    compile_condition (self->condition, dpi, self->compiled);
+  }
+
+  return check_compiled (&g_array_index (self->compiled, CompiledCondition, 0),
+                         width, height, range);
 }
@@ -9,10 +9,11 @@
 #include "adap-carousel-indicator-dots.h"
 
 #include "adap-animation-util.h"
-#include "adap-swipeable.h"
+#include "adap-swipeable-private.h"
 #include "adap-timed-animation.h"
 
 #include <math.h>
+#include <string.h>
 
 #define DOTS_RADIUS 3
 #define DOTS_RADIUS_SELECTED 4
@@ -36,6 +37,10 @@
  * larger and more opaque than the others, the transition to the active and
  * inactive state is gradual to match the carousel's position.
  *
+ * For carousels with many pages, [property@CarouselIndicatorDots:max-dots] can
+ * be used to only show the dots around the active page, fading out at the
+ * edges.
+ *
  * See also [class@CarouselIndicatorLines].
  *
  * ## CSS nodes
@@ -53,6 +58,19 @@ struct _AdapCarouselIndicatorDots
 
   AdapAnimation *animation;
   GBinding *duration_binding;
+
+  guint max_dots;
+
+  double *sizes;
+  int n_sizes_allocated;
+
+  /* The inactive dots, drawn at the origin */
+  GskRenderNode *static_node;
+  double *static_sizes;
+  guint static_n_pages;
+  int static_first_active;
+  int static_last_active;
+  GdkRGBA static_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdapCarouselIndicatorDots, adap_carousel_indicator_dots, GTK_TYPE_WIDGET,
@@ -61,35 +79,200 @@ G_DEFINE_FINAL_TYPE_WITH_CODE (AdapCarouselIndicatorDots, adap_carousel_indicato
 enum {
   PROP_0,
   PROP_CAROUSEL,
+  PROP_MAX_DOTS,
 
   /* GtkOrientable */
   PROP_ORIENTATION,
-  LAST_PROP = PROP_CAROUSEL + 1,
+  LAST_PROP = PROP_MAX_DOTS + 1,
 };
 
 static GParamSpec *props[LAST_PROP];
 
+static double *
+get_sizes (AdapCarouselIndicatorDots *self,
+           const double              *points,
+           int                        n_points)
+{
+  int i;
+
+  if (n_points > self->n_sizes_allocated) {
+    self->sizes = g_renew (double, self->sizes, n_points);
+    self->n_sizes_allocated = n_points;
+  }
+
+  if (n_points > 0)
+    self->sizes[0] = points[0] + 1;
+  for (i = 1; i < n_points; i++)
+    self->sizes[i] = points[i] - points[i - 1];
+
+  return self->sizes;
+}
+
+static inline gboolean
+is_windowed (AdapCarouselIndicatorDots *self,
+             guint                      n_pages)
+{
+  return self->max_dots > 0 && n_pages > self->max_dots;
+}
+
 static void
-snapshot_dots (GtkWidget      *widget,
-               GtkSnapshot    *snapshot,
+snapshot_dot (GtkSnapshot    *snapshot,
+              GtkOrientation  orientation,
+              const GdkRGBA  *color,
+              double          pos,
+              double          progress,
+              double          size)
+{
+  double radius, opacity;
+  graphene_rect_t rect;
+  GskRoundedRect clip;
+
+  radius = adap_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * size;
+  opacity = adap_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * size;
+
+  graphene_rect_init (&rect, -DOTS_RADIUS, -DOTS_RADIUS, DOTS_RADIUS * 2, DOTS_RADIUS * 2);
+  gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+
+  gtk_snapshot_save (snapshot);
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (pos, 0));
+  else
+    gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (0, pos));
+
+  gtk_snapshot_scale (snapshot, radius / DOTS_RADIUS, radius / DOTS_RADIUS);
+
+  gtk_snapshot_push_rounded_clip (snapshot, &clip);
+  gtk_snapshot_push_opacity (snapshot, opacity);
+
+  gtk_snapshot_append_color (snapshot, color, &rect);
+
+  gtk_snapshot_pop (snapshot);
+  gtk_snapshot_pop (snapshot);
+
+  gtk_snapshot_restore (snapshot);
+}
+
+/* The dots other than the active ones only change when pages are added or
+ * removed, so they are cached between frames as long as only the position
+ * changes. The node is positioned relative to the start of the first dot. */
+static GskRenderNode *
+get_static_node (AdapCarouselIndicatorDots *self,
+                 const GdkRGBA             *color,
+                 double                    *sizes,
+                 guint                      n_pages,
+                 int                        first_active,
+                 int                        last_active)
+{
+  GtkSnapshot *snapshot;
+  double dot_size, pos;
+  int i;
+
+  if (self->static_node &&
+      self->static_n_pages == n_pages &&
+      self->static_first_active == first_active &&
+      self->static_last_active == last_active &&
+      gdk_rgba_equal (&self->static_color, color) &&
+      !memcmp (self->static_sizes, sizes, sizeof (double) * n_pages))
+    return self->static_node;
+
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
+
+  self->static_sizes = g_renew (double, self->static_sizes, n_pages);
+  memcpy (self->static_sizes, sizes, sizeof (double) * n_pages);
+  self->static_n_pages = n_pages;
+  self->static_first_active = first_active;
+  self->static_last_active = last_active;
+  self->static_color = *color;
+
+  snapshot = gtk_snapshot_new ();
+  dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+  pos = 0;
+
+  for (i = 0; i < n_pages; i++) {
+    pos += dot_size * sizes[i] / 2.0;
+
+    if (i < first_active || i > last_active)
+      snapshot_dot (snapshot, self->orientation, color, pos, 0, sizes[i]);
+
+    pos += dot_size * sizes[i] / 2.0;
+  }
+
+  self->static_node = gtk_snapshot_free_to_node (snapshot);
+
+  return self->static_node;
+}
+
+static void
+snapshot_fade (GtkSnapshot    *snapshot,
                GtkOrientation  orientation,
-               double          position,
-               double         *sizes,
-               guint           n_pages)
+               double          start,
+               double          end,
+               double          thickness,
+               double          fade_start,
+               double          fade_end)
+{
+  double fade_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    double from = i ? end : start;
+    double to = i ? end - fade_size : start + fade_size;
+    double alpha = i ? fade_end : fade_start;
+    graphene_rect_t bounds;
+
+    if (alpha <= 0)
+      continue;
+
+    if (orientation == GTK_ORIENTATION_HORIZONTAL)
+      graphene_rect_init (&bounds, MIN (from, to), 0, fade_size, thickness);
+    else
+      graphene_rect_init (&bounds, 0, MIN (from, to), thickness, fade_size);
+
+    gtk_snapshot_append_linear_gradient (snapshot, &bounds,
+                                         orientation == GTK_ORIENTATION_HORIZONTAL ?
+                                           &GRAPHENE_POINT_INIT (from, 0) :
+                                           &GRAPHENE_POINT_INIT (0, from),
+                                         orientation == GTK_ORIENTATION_HORIZONTAL ?
+                                           &GRAPHENE_POINT_INIT (to, 0) :
+                                           &GRAPHENE_POINT_INIT (0, to),
+                                         (GskColorStop[2]) {
+                                             { 0, { 0, 0, 0, alpha } },
+                                             { 1, { 0, 0, 0, 0 } },
+                                         },
+                                         2);
+  }
+}
+
+static void
+snapshot_dots (AdapCarouselIndicatorDots *self,
+               GtkSnapshot               *snapshot,
+               double                     position,
+               double                    *sizes,
+               guint                      n_pages)
 {
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkOrientation orientation = self->orientation;
   GdkRGBA color;
   int i, widget_length, widget_thickness;
-  double x, y, indicator_length, dot_size, full_size;
-  double current_position, remaining_progress;
-  graphene_rect_t rect;
+  int first_active, last_active;
+  double x, y, indicator_length, visible_length, dot_size, full_size;
+  double current_position, remaining_progress, pos, offset;
+  gboolean windowed;
 
   gtk_widget_get_color (widget, &color);
   dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
+  windowed = is_windowed (self, n_pages);
 
   indicator_length = -DOTS_SPACING;
   for (i = 0; i < n_pages; i++)
     indicator_length += dot_size * sizes[i];
 
+  if (windowed)
+    visible_length = MIN (indicator_length, dot_size * self->max_dots - DOTS_SPACING);
+  else
+    visible_length = indicator_length;
+
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
     widget_thickness = gtk_widget_get_height (widget);
@@ -99,60 +282,102 @@ snapshot_dots (GtkWidget      *widget,
   }
 
   /* Ensure the indicators are aligned to pixel grid when not animating */
-  full_size = round (indicator_length / dot_size) * dot_size;
+  full_size = round (visible_length / dot_size) * dot_size;
   if ((widget_length - (int) full_size) % 2 == 0)
     widget_length--;
 
+  /* Keep the active dot centered, unless that would show empty space */
+  if (windowed) {
+    offset = position * dot_size + (dot_size - DOTS_SPACING - visible_length) / 2.0;
+    offset = CLAMP (offset, 0, indicator_length - visible_length);
+  } else {
+    offset = 0;
+  }
+
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
-    x = (widget_length - indicator_length) / 2.0;
+    x = (widget_length - visible_length) / 2.0 - offset;
     y = widget_thickness / 2;
   } else {
     x = widget_thickness / 2;
-    y = (widget_length - indicator_length) / 2.0;
+    y = (widget_length - visible_length) / 2.0 - offset;
   }
 
+  /* Only the dots next to the position are partially active */
+  first_active = -1;
+  last_active = -2;
   current_position = 0;
   remaining_progress = 1;
 
-  graphene_rect_init (&rect, -DOTS_RADIUS, -DOTS_RADIUS, DOTS_RADIUS * 2, DOTS_RADIUS * 2);
+  for (i = 0; i < n_pages && remaining_progress > 0; i++) {
+    current_position += sizes[i];
 
-  for (i = 0; i < n_pages; i++) {
-    double progress, radius, opacity;
-    GskRoundedRect clip;
+    if (CLAMP (current_position - position, 0, remaining_progress) > 0) {
+      if (first_active < 0)
+        first_active = i;
+
+      last_active = i;
+      remaining_progress -= CLAMP (current_position - position, 0, remaining_progress);
+    }
+  }
+
+  if (windowed) {
+    double start = (orientation == GTK_ORIENTATION_HORIZONTAL ? x : y) + offset + DOTS_SPACING / 2.0;
 
     if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
+      gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (start, 0, visible_length, widget_thickness));
     else
-      y += dot_size * sizes[i] / 2.0;
+      gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (0, start, widget_thickness, visible_length));
+
+    gtk_snapshot_push_mask (snapshot, GSK_MASK_MODE_INVERTED_ALPHA);
+    snapshot_fade (snapshot, orientation, start, start + visible_length,
+                   widget_thickness,
+                   MIN (offset / dot_size, 1),
+                   MIN ((indicator_length - visible_length - offset) / dot_size, 1));
+    gtk_snapshot_pop (snapshot);
+  }
+
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
 
+  if (!windowed)
+    gtk_snapshot_append_node (snapshot, get_static_node (self, &color, sizes, n_pages,
+                                                         first_active, last_active));
+
+  current_position = 0;
+  remaining_progress = 1;
+  pos = 0;
+
+  for (i = 0; i < n_pages; i++) {
+    double progress;
+
+    pos += dot_size * sizes[i] / 2.0;
     current_position += sizes[i];
 
     progress = CLAMP (current_position - position, 0, remaining_progress);
     remaining_progress -= progress;
 
-    radius = adap_lerp (DOTS_RADIUS, DOTS_RADIUS_SELECTED, progress) * sizes[i];
-    opacity = adap_lerp (DOTS_OPACITY, DOTS_OPACITY_SELECTED, progress) * sizes[i];
+    /* Skip the dots outside of the window */
+    if (windowed) {
+      if (pos < offset - dot_size) {
+        pos += dot_size * sizes[i] / 2.0;
+        continue;
+      }
 
-    gsk_rounded_rect_init_from_rect (&clip, &rect, radius);
+      if (pos > offset + visible_length + dot_size)
+        break;
+    }
 
-    gtk_snapshot_save (snapshot);
-    gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
-    gtk_snapshot_scale (snapshot, radius / DOTS_RADIUS, radius / DOTS_RADIUS);
+    if (windowed || (i >= first_active && i <= last_active))
+      snapshot_dot (snapshot, orientation, &color, pos, progress, sizes[i]);
 
-    gtk_snapshot_push_rounded_clip (snapshot, &clip);
-    gtk_snapshot_push_opacity (snapshot, opacity);
+    pos += dot_size * sizes[i] / 2.0;
+  }
 
-    gtk_snapshot_append_color (snapshot, &color, &rect);
+  gtk_snapshot_restore (snapshot);
 
+  if (windowed) {
     gtk_snapshot_pop (snapshot);
     gtk_snapshot_pop (snapshot);
-
-    gtk_snapshot_restore (snapshot);
-
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      x += dot_size * sizes[i] / 2.0;
-    else
-      y += dot_size * sizes[i] / 2.0;
   }
 }
 
@@ -178,27 +403,23 @@ adap_carousel_indicator_dots_measure (GtkWidget      *widget,
   if (orientation == self->orientation) {
     int i, n_points = 0;
     double indicator_length, dot_size;
-    double *points = NULL, *sizes;
+    const double *points = NULL;
+    double *sizes;
 
     if (self->carousel)
-      points = adap_swipeable_get_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
+      points = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
 
-    sizes = g_new0 (double, n_points);
-
-    if (n_points > 0)
-      sizes[0] = points[0] + 1;
-    for (i = 1; i < n_points; i++)
-      sizes[i] = points[i] - points[i - 1];
+    sizes = get_sizes (self, points, n_points);
 
     dot_size = 2 * DOTS_RADIUS_SELECTED + DOTS_SPACING;
     indicator_length = 0;
     for (i = 0; i < n_points; i++)
       indicator_length += dot_size * sizes[i];
 
-    size = ceil (indicator_length);
+    if (is_windowed (self, n_points))
+      indicator_length = MIN (indicator_length, dot_size * self->max_dots);
 
-    g_free (points);
-    g_free (sizes);
+    size = ceil (indicator_length);
   } else {
     size = 2 * DOTS_RADIUS_SELECTED;
   }
@@ -223,36 +444,27 @@ adap_carousel_indicator_dots_snapshot (GtkWidget   *widget,
                                       GtkSnapshot *snapshot)
 {
   AdapCarouselIndicatorDots *self = ADAP_CAROUSEL_INDICATOR_DOTS (widget);
-  int i, n_points;
+  int n_points;
   double position;
-  double *points, *sizes;
+  const double *points;
+  double *sizes;
 
   if (!self->carousel)
     return;
 
-  points = adap_swipeable_get_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
+  points = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
   position = adap_carousel_get_position (self->carousel);
 
-  if (n_points < 2) {
-    g_free (points);
-
+  if (n_points < 2)
     return;
-  }
 
   if (self->orientation == GTK_ORIENTATION_HORIZONTAL &&
       gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
     position = points[n_points - 1] - position;
 
-  sizes = g_new0 (double, n_points);
-
-  sizes[0] = points[0] + 1;
-  for (i = 1; i < n_points; i++)
-    sizes[i] = points[i] - points[i - 1];
+  sizes = get_sizes (self, points, n_points);
 
-  snapshot_dots (widget, snapshot, self->orientation, position, sizes, n_points);
-
-  g_free (sizes);
-  g_free (points);
+  snapshot_dots (self, snapshot, position, sizes, n_points);
 }
 
 static void
@@ -267,6 +479,18 @@ adap_carousel_dispose (GObject *object)
   G_OBJECT_CLASS (adap_carousel_indicator_dots_parent_class)->dispose (object);
 }
 
+static void
+adap_carousel_indicator_dots_finalize (GObject *object)
+{
+  AdapCarouselIndicatorDots *self = ADAP_CAROUSEL_INDICATOR_DOTS (object);
+
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
+  g_free (self->static_sizes);
+  g_free (self->sizes);
+
+  G_OBJECT_CLASS (adap_carousel_indicator_dots_parent_class)->finalize (object);
+}
+
 static void
 adap_carousel_indicator_dots_get_property (GObject    *object,
                                           guint       prop_id,
@@ -280,6 +504,10 @@ adap_carousel_indicator_dots_get_property (GObject    *object,
     g_value_set_object (value, adap_carousel_indicator_dots_get_carousel (self));
     break;
 
+  case PROP_MAX_DOTS:
+    g_value_set_uint (value, adap_carousel_indicator_dots_get_max_dots (self));
+    break;
+
   case PROP_ORIENTATION:
     g_value_set_enum (value, self->orientation);
     break;
@@ -302,11 +530,16 @@ adap_carousel_indicator_dots_set_property (GObject      *object,
     adap_carousel_indicator_dots_set_carousel (self, g_value_get_object (value));
     break;
 
+  case PROP_MAX_DOTS:
+    adap_carousel_indicator_dots_set_max_dots (self, g_value_get_uint (value));
+    break;
+
   case PROP_ORIENTATION:
     {
       GtkOrientation orientation = g_value_get_enum (value);
       if (orientation != self->orientation) {
         self->orientation = orientation;
+        g_clear_pointer (&self->static_node, gsk_render_node_unref);
         gtk_widget_queue_resize (GTK_WIDGET (self));
         g_object_notify (G_OBJECT (self), "orientation");
       }
@@ -325,6 +558,7 @@ adap_carousel_indicator_dots_class_init (AdapCarouselIndicatorDotsClass *klass)
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
   object_class->dispose = adap_carousel_dispose;
+  object_class->finalize = adap_carousel_indicator_dots_finalize;
   object_class->get_property = adap_carousel_indicator_dots_get_property;
   object_class->set_property = adap_carousel_indicator_dots_set_property;
 
@@ -341,6 +575,23 @@ adap_carousel_indicator_dots_class_init (AdapCarouselIndicatorDotsClass *klass)
                          ADAP_TYPE_CAROUSEL,
                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdapCarouselIndicatorDots:max-dots: (attributes org.gtk.Property.get=adap_carousel_indicator_dots_get_max_dots org.gtk.Property.set=adap_carousel_indicator_dots_set_max_dots)
+   *
+   * The maximum number of dots to show.
+   *
+   * If the carousel has more pages than that, only the dots around the active
+   * page are shown, and the dots at the edges are faded out.
+   *
+   * If set to 0, a dot is shown for every page.
+   *
+   * Since: 1.6
+   */
+  props[PROP_MAX_DOTS] =
+    g_param_spec_uint ("max-dots", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_override_property (object_class,
                                     PROP_ORIENTATION,
                                     "orientation");
@@ -436,3 +687,51 @@ adap_carousel_indicator_dots_set_carousel (AdapCarouselIndicatorDots *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CAROUSEL]);
 }
+
+/**
+ * adap_carousel_indicator_dots_get_max_dots: (attributes org.gtk.Method.get_property=max-dots)
+ * @self: an indicator
+ *
+ * Gets the maximum number of dots to show.
+ *
+ * Returns: the maximum number of dots
+ *
+ * Since: 1.6
+ */
+guint
+adap_carousel_indicator_dots_get_max_dots (AdapCarouselIndicatorDots *self)
+{
+  g_return_val_if_fail (ADAP_IS_CAROUSEL_INDICATOR_DOTS (self), 0);
+
+  return self->max_dots;
+}
+
+/**
+ * adap_carousel_indicator_dots_set_max_dots: (attributes org.gtk.Method.set_property=max-dots)
+ * @self: an indicator
+ * @max_dots: the maximum number of dots, or 0
+ *
+ * Sets the maximum number of dots to show.
+ *
+ * If the carousel has more pages than that, only the dots around the active
+ * page are shown, and the dots at the edges are faded out.
+ *
+ * If set to 0, a dot is shown for every page.
+ *
+ * Since: 1.6
+ */
+void
+adap_carousel_indicator_dots_set_max_dots (AdapCarouselIndicatorDots *self,
+                                          guint                      max_dots)
+{
+  g_return_if_fail (ADAP_IS_CAROUSEL_INDICATOR_DOTS (self));
+
+  if (self->max_dots == max_dots)
+    return;
+
+  self->max_dots = max_dots;
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_DOTS]);
+}
@@ -31,4 +31,10 @@ ADAP_AVAILABLE_IN_ALL
 void         adap_carousel_indicator_dots_set_carousel (AdapCarouselIndicatorDots *self,
                                                        AdapCarousel              *carousel);
 
+ADAP_AVAILABLE_IN_1_6
+guint adap_carousel_indicator_dots_get_max_dots (AdapCarouselIndicatorDots *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_carousel_indicator_dots_set_max_dots (AdapCarouselIndicatorDots *self,
+                                                guint                      max_dots);
+
 G_END_DECLS
@@ -8,10 +8,11 @@
 
 #include "adap-carousel-indicator-lines.h"
 
-#include "adap-swipeable.h"
+#include "adap-swipeable-private.h"
 #include "adap-timed-animation.h"
 
 #include <math.h>
+#include <string.h>
 
 #define LINE_WIDTH 3
 #define LINE_LENGTH 35
@@ -34,6 +35,10 @@
  * a given [class@Carousel]. The carousel's active page is shown as another line
  * that moves between them to match the carousel's position.
  *
+ * For carousels with many pages,
+ * [property@CarouselIndicatorLines:max-lines] can be used to only show the
+ * lines around the active page, fading out at the edges.
+ *
  * See also [class@CarouselIndicatorDots].
  *
  * ## CSS nodes
@@ -51,6 +56,17 @@ struct _AdapCarouselIndicatorLines
 
   AdapAnimation *animation;
   GBinding *duration_binding;
+
+  guint max_lines;
+
+  double *sizes;
+  int n_sizes_allocated;
+
+  /* The inactive lines, drawn at the origin */
+  GskRenderNode *static_node;
+  double *static_sizes;
+  guint static_n_pages;
+  GdkRGBA static_color;
 };
 
 G_DEFINE_FINAL_TYPE_WITH_CODE (AdapCarouselIndicatorLines, adap_carousel_indicator_lines, GTK_TYPE_WIDGET,
@@ -59,35 +75,173 @@ G_DEFINE_FINAL_TYPE_WITH_CODE (AdapCarouselIndicatorLines, adap_carousel_indicat
 enum {
   PROP_0,
   PROP_CAROUSEL,
+  PROP_MAX_LINES,
 
   /* GtkOrientable */
   PROP_ORIENTATION,
-  LAST_PROP = PROP_CAROUSEL + 1,
+  LAST_PROP = PROP_MAX_LINES + 1,
 };
 
 static GParamSpec *props[LAST_PROP];
 
+static double *
+get_sizes (AdapCarouselIndicatorLines *self,
+           const double               *points,
+           int                         n_points)
+{
+  int i;
+
+  if (n_points > self->n_sizes_allocated) {
+    self->sizes = g_renew (double, self->sizes, n_points);
+    self->n_sizes_allocated = n_points;
+  }
+
+  if (n_points > 0)
+    self->sizes[0] = points[0] + 1;
+  for (i = 1; i < n_points; i++)
+    self->sizes[i] = points[i] - points[i - 1];
+
+  return self->sizes;
+}
+
+static inline gboolean
+is_windowed (AdapCarouselIndicatorLines *self,
+             guint                       n_pages)
+{
+  return self->max_lines > 0 && n_pages > self->max_lines;
+}
+
 static void
-snapshot_lines (GtkWidget      *widget,
-                GtkSnapshot    *snapshot,
-                GtkOrientation  orientation,
-                double          position,
-                double         *sizes,
-                guint           n_pages)
+snapshot_line (GtkSnapshot    *snapshot,
+               GtkOrientation  orientation,
+               const GdkRGBA  *color,
+               double          pos,
+               double          size)
 {
+  double length = (LINE_LENGTH + LINE_SPACING) * size - LINE_SPACING;
+
+  if (length <= 0)
+    return;
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+    gtk_snapshot_append_color (snapshot, color,
+                               &GRAPHENE_RECT_INIT (pos, 0, length, LINE_WIDTH));
+  else
+    gtk_snapshot_append_color (snapshot, color,
+                               &GRAPHENE_RECT_INIT (0, pos, LINE_WIDTH, length));
+}
+
+/* The inactive lines only change when pages are added or removed, so they are
+ * cached between frames as long as only the position changes. The node is
+ * positioned relative to the start of the first line. */
+static GskRenderNode *
+get_static_node (AdapCarouselIndicatorLines *self,
+                 const GdkRGBA              *color,
+                 double                     *sizes,
+                 guint                       n_pages)
+{
+  GtkSnapshot *snapshot;
+  double pos;
+  int i;
+
+  if (self->static_node &&
+      self->static_n_pages == n_pages &&
+      gdk_rgba_equal (&self->static_color, color) &&
+      !memcmp (self->static_sizes, sizes, sizeof (double) * n_pages))
+    return self->static_node;
+
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
+
+  self->static_sizes = g_renew (double, self->static_sizes, n_pages);
+  memcpy (self->static_sizes, sizes, sizeof (double) * n_pages);
+  self->static_n_pages = n_pages;
+  self->static_color = *color;
+
+  snapshot = gtk_snapshot_new ();
+
+  pos = 0;
+  for (i = 0; i < n_pages; i++) {
+    snapshot_line (snapshot, self->orientation, color, pos, sizes[i]);
+
+    pos += (LINE_LENGTH + LINE_SPACING) * sizes[i];
+  }
+
+  self->static_node = gtk_snapshot_free_to_node (snapshot);
+
+  return self->static_node;
+}
+
+static void
+snapshot_fade (GtkSnapshot    *snapshot,
+               GtkOrientation  orientation,
+               double          start,
+               double          end,
+               double          thickness,
+               double          fade_start,
+               double          fade_end)
+{
+  double fade_size = LINE_LENGTH + LINE_SPACING;
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    double from = i ? end : start;
+    double to = i ? end - fade_size : start + fade_size;
+    double alpha = i ? fade_end : fade_start;
+    graphene_rect_t bounds;
+
+    if (alpha <= 0)
+      continue;
+
+    if (orientation == GTK_ORIENTATION_HORIZONTAL)
+      graphene_rect_init (&bounds, MIN (from, to), 0, fade_size, thickness);
+    else
+      graphene_rect_init (&bounds, 0, MIN (from, to), thickness, fade_size);
+
+    gtk_snapshot_append_linear_gradient (snapshot, &bounds,
+                                         orientation == GTK_ORIENTATION_HORIZONTAL ?
+                                           &GRAPHENE_POINT_INIT (from, 0) :
+                                           &GRAPHENE_POINT_INIT (0, from),
+                                         orientation == GTK_ORIENTATION_HORIZONTAL ?
+                                           &GRAPHENE_POINT_INIT (to, 0) :
+                                           &GRAPHENE_POINT_INIT (0, to),
+                                         (GskColorStop[2]) {
+                                             { 0, { 0, 0, 0, alpha } },
+                                             { 1, { 0, 0, 0, 0 } },
+                                         },
+                                         2);
+  }
+}
+
+static void
+snapshot_lines (AdapCarouselIndicatorLines *self,
+                GtkSnapshot                *snapshot,
+                double                      position,
+                double                     *sizes,
+                guint                       n_pages)
+{
+  GtkWidget *widget = GTK_WIDGET (self);
+  GtkOrientation orientation = self->orientation;
   GdkRGBA color;
   int i, widget_length, widget_thickness;
-  double indicator_length, full_size, line_size;
-  double x = 0, y = 0, pos;
+  double indicator_length, visible_length, full_size, line_size;
+  double x = 0, y = 0, pos, offset;
+  gboolean windowed;
 
   gtk_widget_get_color (widget, &color);
   color.alpha *= LINE_OPACITY;
 
   line_size = LINE_LENGTH + LINE_SPACING;
+  windowed = is_windowed (self, n_pages);
+
   indicator_length = -LINE_SPACING;
   for (i = 0; i < n_pages; i++)
     indicator_length += line_size * sizes[i];
 
+  if (windowed)
+    visible_length = MIN (indicator_length, line_size * self->max_lines - LINE_SPACING);
+  else
+    visible_length = indicator_length;
+
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
     widget_length = gtk_widget_get_width (widget);
     widget_thickness = gtk_widget_get_height (widget);
@@ -97,48 +251,81 @@ snapshot_lines (GtkWidget      *widget,
   }
 
   /* Ensure the indicators are aligned to pixel grid when not animating */
-  full_size = round (indicator_length / line_size) * line_size;
+  full_size = round (visible_length / line_size) * line_size;
   if ((widget_length - (int) full_size) % 2 == 0)
     widget_length--;
 
+  /* Keep the active line centered, unless that would show empty space */
+  if (windowed) {
+    offset = position * line_size + (LINE_LENGTH - visible_length) / 2.0;
+    offset = CLAMP (offset, 0, indicator_length - visible_length);
+  } else {
+    offset = 0;
+  }
+
   if (orientation == GTK_ORIENTATION_HORIZONTAL) {
-    x = (widget_length - indicator_length) / 2.0;
+    x = (widget_length - visible_length) / 2.0 - offset;
     y = (widget_thickness - LINE_WIDTH) / 2;
   } else {
     x = (widget_thickness - LINE_WIDTH) / 2;
-    y = (widget_length - indicator_length) / 2.0;
+    y = (widget_length - visible_length) / 2.0 - offset;
   }
 
-  pos = 0;
-  for (i = 0; i < n_pages; i++) {
-    double length;
-    graphene_rect_t rectangle;
+  if (windowed) {
+    double start = (orientation == GTK_ORIENTATION_HORIZONTAL ? x : y) + offset;
 
-    length = (LINE_LENGTH + LINE_SPACING) * sizes[i] - LINE_SPACING;
+    if (orientation == GTK_ORIENTATION_HORIZONTAL)
+      gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (start, 0, visible_length, widget_thickness));
+    else
+      gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (0, start, widget_thickness, visible_length));
 
-    if (length > 0) {
-      if (orientation == GTK_ORIENTATION_HORIZONTAL)
-        graphene_rect_init (&rectangle, x + pos, y, length, LINE_WIDTH);
-      else
-        graphene_rect_init (&rectangle, x, y + pos, LINE_WIDTH, length);
-    }
+    gtk_snapshot_push_mask (snapshot, GSK_MASK_MODE_INVERTED_ALPHA);
+    snapshot_fade (snapshot, orientation, start, start + visible_length,
+                   widget_thickness,
+                   MIN (offset / line_size, 1),
+                   MIN ((indicator_length - visible_length - offset) / line_size, 1));
+    gtk_snapshot_pop (snapshot);
+  }
 
-    gtk_snapshot_append_color (snapshot, &color, &rectangle);
+  gtk_snapshot_save (snapshot);
+  gtk_snapshot_translate (snapshot, &GRAPHENE_POINT_INIT (x, y));
 
-    pos += (LINE_LENGTH + LINE_SPACING) * sizes[i];
+  if (windowed) {
+    /* Only draw the lines inside the window */
+    pos = 0;
+    for (i = 0; i < n_pages; i++) {
+      double next_pos = pos + line_size * sizes[i];
+
+      if (pos > offset + visible_length)
+        break;
+
+      if (next_pos >= offset)
+        snapshot_line (snapshot, orientation, &color, pos, sizes[i]);
+
+      pos = next_pos;
+    }
+  } else {
+    gtk_snapshot_append_node (snapshot, get_static_node (self, &color, sizes, n_pages));
   }
 
   gtk_widget_get_color (widget, &color);
   color.alpha *= LINE_OPACITY_ACTIVE;
 
-  pos = position * (LINE_LENGTH + LINE_SPACING);
+  pos = position * line_size;
 
   if (orientation == GTK_ORIENTATION_HORIZONTAL)
     gtk_snapshot_append_color (snapshot, &color,
-                               &GRAPHENE_RECT_INIT (x + pos, y, LINE_LENGTH, LINE_WIDTH));
+                               &GRAPHENE_RECT_INIT (pos, 0, LINE_LENGTH, LINE_WIDTH));
   else
     gtk_snapshot_append_color (snapshot, &color,
-                               &GRAPHENE_RECT_INIT (x, y + pos, LINE_WIDTH, LINE_LENGTH));
+                               &GRAPHENE_RECT_INIT (0, pos, LINE_WIDTH, LINE_LENGTH));
+
+  gtk_snapshot_restore (snapshot);
+
+  if (windowed) {
+    gtk_snapshot_pop (snapshot);
+    gtk_snapshot_pop (snapshot);
+  }
 }
 
 static void
@@ -163,27 +350,23 @@ adap_carousel_indicator_lines_measure (GtkWidget      *widget,
   if (orientation == self->orientation) {
     int i, n_points = 0;
     double indicator_length, line_size;
-    double *points = NULL, *sizes;
+    const double *points = NULL;
+    double *sizes;
 
     if (self->carousel)
-      points = adap_swipeable_get_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
+      points = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
 
-    sizes = g_new0 (double, n_points);
-
-    if (n_points > 0)
-      sizes[0] = points[0] + 1;
-    for (i = 1; i < n_points; i++)
-      sizes[i] = points[i] - points[i - 1];
+    sizes = get_sizes (self, points, n_points);
 
     line_size = LINE_LENGTH + LINE_SPACING;
     indicator_length = 0;
     for (i = 0; i < n_points; i++)
       indicator_length += line_size * sizes[i];
 
-    size = ceil (indicator_length);
+    if (is_windowed (self, n_points))
+      indicator_length = MIN (indicator_length, line_size * self->max_lines);
 
-    g_free (points);
-    g_free (sizes);
+    size = ceil (indicator_length);
   } else {
     size = LINE_WIDTH;
   }
@@ -208,36 +391,27 @@ adap_carousel_indicator_lines_snapshot (GtkWidget   *widget,
                                        GtkSnapshot *snapshot)
 {
   AdapCarouselIndicatorLines *self = ADAP_CAROUSEL_INDICATOR_LINES (widget);
-  int i, n_points;
+  int n_points;
   double position;
-  double *points, *sizes;
+  const double *points;
+  double *sizes;
 
   if (!self->carousel)
     return;
 
-  points = adap_swipeable_get_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
+  points = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (self->carousel), &n_points);
   position = adap_carousel_get_position (self->carousel);
 
-  if (n_points < 2) {
-    g_free (points);
-
+  if (n_points < 2)
     return;
-  }
 
   if (self->orientation == GTK_ORIENTATION_HORIZONTAL &&
       gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
     position = points[n_points - 1] - position;
 
-  sizes = g_new0 (double, n_points);
-
-  sizes[0] = points[0] + 1;
-  for (i = 1; i < n_points; i++)
-    sizes[i] = points[i] - points[i - 1];
-
-  snapshot_lines (widget, snapshot, self->orientation, position, sizes, n_points);
+  sizes = get_sizes (self, points, n_points);
 
-  g_free (sizes);
-  g_free (points);
+  snapshot_lines (self, snapshot, position, sizes, n_points);
 }
 
 static void
@@ -252,6 +426,18 @@ adap_carousel_dispose (GObject *object)
   G_OBJECT_CLASS (adap_carousel_indicator_lines_parent_class)->dispose (object);
 }
 
+static void
+adap_carousel_indicator_lines_finalize (GObject *object)
+{
+  AdapCarouselIndicatorLines *self = ADAP_CAROUSEL_INDICATOR_LINES (object);
+
+  g_clear_pointer (&self->static_node, gsk_render_node_unref);
+  g_free (self->static_sizes);
+  g_free (self->sizes);
+
+  G_OBJECT_CLASS (adap_carousel_indicator_lines_parent_class)->finalize (object);
+}
+
 static void
 adap_carousel_indicator_lines_get_property (GObject    *object,
                                            guint       prop_id,
@@ -265,6 +451,10 @@ adap_carousel_indicator_lines_get_property (GObject    *object,
     g_value_set_object (value, adap_carousel_indicator_lines_get_carousel (self));
     break;
 
+  case PROP_MAX_LINES:
+    g_value_set_uint (value, adap_carousel_indicator_lines_get_max_lines (self));
+    break;
+
   case PROP_ORIENTATION:
     g_value_set_enum (value, self->orientation);
     break;
@@ -287,11 +477,16 @@ adap_carousel_indicator_lines_set_property (GObject      *object,
     adap_carousel_indicator_lines_set_carousel (self, g_value_get_object (value));
     break;
 
+  case PROP_MAX_LINES:
+    adap_carousel_indicator_lines_set_max_lines (self, g_value_get_uint (value));
+    break;
+
   case PROP_ORIENTATION:
     {
       GtkOrientation orientation = g_value_get_enum (value);
       if (orientation != self->orientation) {
         self->orientation = orientation;
+        g_clear_pointer (&self->static_node, gsk_render_node_unref);
         gtk_widget_queue_resize (GTK_WIDGET (self));
         g_object_notify (G_OBJECT (self), "orientation");
       }
@@ -310,6 +505,7 @@ adap_carousel_indicator_lines_class_init (AdapCarouselIndicatorLinesClass *klass
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
   object_class->dispose = adap_carousel_dispose;
+  object_class->finalize = adap_carousel_indicator_lines_finalize;
   object_class->get_property = adap_carousel_indicator_lines_get_property;
   object_class->set_property = adap_carousel_indicator_lines_set_property;
 
@@ -326,6 +522,23 @@ adap_carousel_indicator_lines_class_init (AdapCarouselIndicatorLinesClass *klass
                          ADAP_TYPE_CAROUSEL,
                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdapCarouselIndicatorLines:max-lines: (attributes org.gtk.Property.get=adap_carousel_indicator_lines_get_max_lines org.gtk.Property.set=adap_carousel_indicator_lines_set_max_lines)
+   *
+   * The maximum number of lines to show.
+   *
+   * If the carousel has more pages than that, only the lines around the active
+   * page are shown, and the lines at the edges are faded out.
+   *
+   * If set to 0, a line is shown for every page.
+   *
+   * Since: 1.6
+   */
+  props[PROP_MAX_LINES] =
+    g_param_spec_uint ("max-lines", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_override_property (object_class,
                                     PROP_ORIENTATION,
                                     "orientation");
@@ -421,3 +634,51 @@ adap_carousel_indicator_lines_set_carousel (AdapCarouselIndicatorLines *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CAROUSEL]);
 }
+
+/**
+ * adap_carousel_indicator_lines_get_max_lines: (attributes org.gtk.Method.get_property=max-lines)
+ * @self: an indicator
+ *
+ * Gets the maximum number of lines to show.
+ *
+ * Returns: the maximum number of lines
+ *
+ * Since: 1.6
+ */
+guint
+adap_carousel_indicator_lines_get_max_lines (AdapCarouselIndicatorLines *self)
+{
+  g_return_val_if_fail (ADAP_IS_CAROUSEL_INDICATOR_LINES (self), 0);
+
+  return self->max_lines;
+}
+
+/**
+ * adap_carousel_indicator_lines_set_max_lines: (attributes org.gtk.Method.set_property=max-lines)
+ * @self: an indicator
+ * @max_lines: the maximum number of lines, or 0
+ *
+ * Sets the maximum number of lines to show.
+ *
+ * If the carousel has more pages than that, only the lines around the active
+ * page are shown, and the lines at the edges are faded out.
+ *
+ * If set to 0, a line is shown for every page.
+ *
+ * Since: 1.6
+ */
+void
+adap_carousel_indicator_lines_set_max_lines (AdapCarouselIndicatorLines *self,
+                                            guint                       max_lines)
+{
+  g_return_if_fail (ADAP_IS_CAROUSEL_INDICATOR_LINES (self));
+
+  if (self->max_lines == max_lines)
+    return;
+
+  self->max_lines = max_lines;
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_LINES]);
+}
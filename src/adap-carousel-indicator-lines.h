@@ -31,4 +31,10 @@ ADAP_AVAILABLE_IN_ALL
 void         adap_carousel_indicator_lines_set_carousel (AdapCarouselIndicatorLines *self,
                                                         AdapCarousel               *carousel);
 
+ADAP_AVAILABLE_IN_1_6
+guint adap_carousel_indicator_lines_get_max_lines (AdapCarouselIndicatorLines *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_carousel_indicator_lines_set_max_lines (AdapCarouselIndicatorLines *self,
+                                                  guint                       max_lines);
+
 G_END_DECLS
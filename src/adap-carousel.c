@@ -13,13 +13,16 @@
 #include "adap-navigation-direction.h"
 #include "adap-spring-animation.h"
 #include "adap-swipe-tracker.h"
-#include "adap-swipeable.h"
+#include "adap-swipeable-private.h"
 #include "adap-timed-animation.h"
 #include "adap-widget-utils-private.h"
 
 #include <math.h>
+#include <string.h>
 
 #define SCROLL_TIMEOUT_DURATION 150
+#define MODEL_PAGE_NEIGHBOURS 1
+#define MAX_RECYCLED_PAGES (2 * MODEL_PAGE_NEIGHBOURS)
 
 /**
  * AdapCarousel:
@@ -37,6 +40,15 @@
  * [class@CarouselIndicatorDots] and [class@CarouselIndicatorLines] can be used
  * to provide page indicators for `AdapCarousel`.
  *
+ * ## Binding a Model
+ *
+ * Instead of adding pages manually, a [iface@Gio.ListModel] can be bound to the
+ * carousel with [method@Carousel.bind_model]. In that case the carousel has a
+ * page for every item in the model, but only creates widgets for the current
+ * page and its immediate neighbors, releasing them again once they are
+ * scrolled away. This allows to have carousels with a large number of pages,
+ * for example a photo viewer.
+ *
  * ## CSS nodes
  *
  * `AdapCarousel` has a single CSS node with name `carousel`.
@@ -44,6 +56,8 @@
 
 typedef struct {
   GtkWidget *widget;
+  GList *link;
+  GObject *item;
   int position;
   gboolean visible;
   double size;
@@ -53,13 +67,29 @@ typedef struct {
 
   gboolean shift_position;
   AdapAnimation *resize_animation;
+
+  /* Last measurement along the orientation, see measure_child() */
+  gboolean measure_valid;
+  GtkOrientation measure_orientation;
+  int measure_for_size;
+  int measure_min;
+  int measure_nat;
 } ChildInfo;
 
+/* A widget that was scrolled away from, kept around in case its item is
+ * scrolled back to, see update_model_pages() */
+typedef struct {
+  GObject *item;
+  GtkWidget *widget;
+} RecycledPage;
+
 struct _AdapCarousel
 {
   GtkWidget parent_instance;
 
   GList *children;
+  /* Pages that aren't being removed, in order */
+  GPtrArray *pages;
   double distance;
   double position;
   guint spacing;
@@ -79,6 +109,15 @@ struct _AdapCarousel
   guint scroll_timeout_id;
   gboolean can_scroll;
   gboolean is_being_allocated;
+
+  GListModel *model;
+  AdapCarouselCreatePageFunc create_page_func;
+  gpointer create_page_func_data;
+  GDestroyNotify create_page_func_data_destroy;
+  guint update_pages_idle_id;
+  /* Pages of the model that currently have a widget */
+  GPtrArray *model_pages;
+  GQueue recycled_pages;
 };
 
 static void adap_carousel_buildable_init (GtkBuildableIface *iface);
@@ -132,50 +171,23 @@ find_child_info (AdapCarousel *self,
   return NULL;
 }
 
-static int
-find_child_index (AdapCarousel *self,
-                  GtkWidget   *widget,
-                  gboolean     count_removing)
+static ChildInfo *
+get_nth_child (AdapCarousel *self,
+               guint        n)
 {
-  GList *l;
-  int i;
-
-  i = 0;
-  for (l = self->children; l; l = l->next) {
-    ChildInfo *info = l->data;
-
-    if (info->removing && !count_removing)
-      continue;
-
-    if (widget == info->widget)
-      return i;
-
-    i++;
-  }
+  if (n >= self->pages->len)
+    return NULL;
 
-  return -1;
+  return g_ptr_array_index (self->pages, n);
 }
 
 static GList *
 get_nth_link (AdapCarousel *self,
-              int          n)
+              guint        n)
 {
+  ChildInfo *info = get_nth_child (self, n);
 
-  GList *l;
-  int i;
-
-  i = n;
-  for (l = self->children; l; l = l->next) {
-    ChildInfo *info = l->data;
-
-    if (info->removing)
-      continue;
-
-    if (i-- == 0)
-      return l;
-  }
-
-  return NULL;
+  return info ? info->link : NULL;
 }
 
 static ChildInfo *
@@ -220,23 +232,61 @@ get_range (AdapCarousel *self,
     *upper = MAX (0, self->position_shift + (child ? child->snap_point : 0));
 }
 
-static GtkWidget *
-get_page_at_position (AdapCarousel *self,
-                      double       position)
+/* Snap points only grow along the pages, so the closest one can be bisected */
+static int
+get_page_index_at_position (AdapCarousel *self,
+                            double       position)
 {
   double lower = 0, upper = 0;
+  guint start, end;
   ChildInfo *child;
 
+  if (self->pages->len == 0)
+    return -1;
+
   get_range (self, &lower, &upper);
 
   position = CLAMP (position, lower, upper);
 
-  child = get_closest_child_at (self, position, TRUE, FALSE);
+  start = 0;
+  end = self->pages->len;
+
+  while (start < end) {
+    guint mid = start + (end - start) / 2;
+
+    child = g_ptr_array_index (self->pages, mid);
+
+    if (child->snap_point < position)
+      start = mid + 1;
+    else
+      end = mid;
+  }
+
+  if (start == self->pages->len)
+    return start - 1;
+
+  if (start > 0) {
+    ChildInfo *prev_child = g_ptr_array_index (self->pages, start - 1);
+
+    child = g_ptr_array_index (self->pages, start);
+
+    if (ABS (prev_child->snap_point - position) <= ABS (child->snap_point - position))
+      return start - 1;
+  }
 
-  if (!child)
+  return start;
+}
+
+static ChildInfo *
+get_page_at_position (AdapCarousel *self,
+                      double       position)
+{
+  int index = get_page_index_at_position (self, position);
+
+  if (index < 0)
     return NULL;
 
-  return child->widget;
+  return g_ptr_array_index (self->pages, index);
 }
 
 static void
@@ -308,9 +358,11 @@ resize_animation_done_cb (ChildInfo *child)
     child->adding = FALSE;
 
   if (child->removing) {
-    self->children = g_list_remove (self->children, child);
+    self->children = g_list_delete_link (self->children, child->link);
 
     g_free (child);
+
+    adap_swipeable_invalidate_snap_points (ADAP_SWIPEABLE (self));
   }
 
   gtk_widget_queue_allocate (GTK_WIDGET (self));
@@ -350,36 +402,370 @@ animate_child_resize (AdapCarousel *self,
   adap_animation_play (child->resize_animation);
 }
 
+static void
+update_snap_points (AdapCarousel *self)
+{
+  GList *l;
+  double snap_point = 0;
+
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+
+    child->snap_point = snap_point + child->size - 1;
+
+    snap_point += child->size;
+  }
+
+  adap_swipeable_invalidate_snap_points (ADAP_SWIPEABLE (self));
+}
+
+static GtkWidget *
+find_next_sibling (GList *next_link)
+{
+  GList *l;
+
+  for (l = next_link; l; l = l->next) {
+    ChildInfo *next_info = l->data;
+
+    if (next_info->widget)
+      return next_info->widget;
+  }
+
+  return NULL;
+}
+
+/* Pages are only animated when a single one is added or removed, so filling or
+ * clearing a carousel doesn't start an animation for each page. Without an
+ * animation, shift_position_for_pages() must be called before the change. */
+static void
+shift_position_for_pages (AdapCarousel *self,
+                          guint        index,
+                          guint        removed,
+                          guint        added)
+{
+  int current_index = get_page_index_at_position (self, self->position +
+                                                        self->position_shift);
+
+  if (current_index < (int) index)
+    return;
+
+  /* Stay on the current page, or move to the first one that replaced it */
+  if (current_index >= (int) (index + removed))
+    self->position_shift += (double) added - removed;
+  else
+    self->position_shift += (double) index - current_index;
+}
+
+static void
+insert_pages (AdapCarousel *self,
+              GtkWidget   *widget,
+              guint        index,
+              guint        n_pages,
+              gboolean     animate)
+{
+  GList *next_link, *first = NULL, *last = NULL;
+  guint old_len, i;
+
+  g_assert (widget == NULL || n_pages == 1);
+
+  if (n_pages == 0)
+    return;
+
+  index = MIN (index, self->pages->len);
+  next_link = get_nth_link (self, index);
+
+  old_len = self->pages->len;
+  g_ptr_array_set_size (self->pages, old_len + n_pages);
+  memmove (&self->pages->pdata[index + n_pages],
+           &self->pages->pdata[index],
+           (old_len - index) * sizeof (gpointer));
+
+  for (i = 0; i < n_pages; i++) {
+    ChildInfo *info = g_new0 (ChildInfo, 1);
+    GList *link = g_list_alloc ();
+
+    info->widget = widget;
+    info->size = animate ? 0 : 1;
+    info->adding = animate;
+    info->link = link;
+
+    link->data = info;
+    link->prev = last;
+    link->next = NULL;
+
+    if (last)
+      last->next = link;
+    else
+      first = link;
+
+    last = link;
+
+    self->pages->pdata[index + i] = info;
+  }
+
+  if (next_link) {
+    first->prev = next_link->prev;
+    last->next = next_link;
+
+    if (next_link->prev)
+      next_link->prev->next = first;
+    else
+      self->children = first;
+
+    next_link->prev = last;
+  } else {
+    GList *tail = g_list_last (self->children);
+
+    first->prev = tail;
+
+    if (tail)
+      tail->next = first;
+    else
+      self->children = first;
+  }
+
+  update_snap_points (self);
+
+  if (widget)
+    gtk_widget_insert_before (widget, GTK_WIDGET (self),
+                              find_next_sibling (next_link));
+
+  self->is_being_allocated = TRUE;
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+  if (animate) {
+    GList *l;
+
+    for (l = first; l != last->next; l = l->next)
+      animate_child_resize (self, l->data, 1, self->reveal_duration);
+  }
+}
+
+static void
+remove_pages (AdapCarousel *self,
+              guint        index,
+              guint        n_pages,
+              gboolean     animate)
+{
+  guint i;
+
+  if (index >= self->pages->len)
+    return;
+
+  n_pages = MIN (n_pages, self->pages->len - index);
+
+  if (n_pages == 0)
+    return;
+
+  for (i = index; i < index + n_pages; i++) {
+    ChildInfo *info = g_ptr_array_index (self->pages, i);
+
+    if (info->widget) {
+      g_ptr_array_remove_fast (self->model_pages, info);
+
+      gtk_widget_unparent (info->widget);
+      info->widget = NULL;
+    }
+
+    g_clear_object (&info->item);
+
+    if (animate) {
+      info->removing = TRUE;
+
+      if (!gtk_widget_in_destruction (GTK_WIDGET (self)))
+        animate_child_resize (self, info, 0, self->reveal_duration);
+
+      continue;
+    }
+
+    /* Finish revealing the page first, so it can be freed right away */
+    if (info->resize_animation)
+      adap_animation_skip (info->resize_animation);
+
+    if (self->animation_target_child == info)
+      self->animation_target_child = NULL;
+
+    self->children = g_list_delete_link (self->children, info->link);
+    g_free (info);
+  }
+
+  g_ptr_array_remove_range (self->pages, index, n_pages);
+
+  update_snap_points (self);
+
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+}
+
+static void
+recycled_page_free (RecycledPage *page)
+{
+  gtk_widget_unparent (page->widget);
+  g_object_unref (page->item);
+  g_free (page);
+}
+
+static void
+clear_recycled_pages (AdapCarousel *self)
+{
+  g_queue_clear_full (&self->recycled_pages, (GDestroyNotify) recycled_page_free);
+}
+
+/* The widget stays parented, so scrolling back to its item doesn't need to
+ * create or realize it again */
+static void
+recycle_model_page (AdapCarousel *self,
+                    ChildInfo   *info)
+{
+  RecycledPage *page = g_new0 (RecycledPage, 1);
+
+  page->item = g_steal_pointer (&info->item);
+  page->widget = g_steal_pointer (&info->widget);
+
+  gtk_widget_set_child_visible (page->widget, FALSE);
+
+  g_queue_push_head (&self->recycled_pages, page);
+
+  if (g_queue_get_length (&self->recycled_pages) > MAX_RECYCLED_PAGES)
+    recycled_page_free (g_queue_pop_tail (&self->recycled_pages));
+}
+
+static void
+create_model_page (AdapCarousel *self,
+                   ChildInfo   *info,
+                   guint        index,
+                   GtkWidget   *next_sibling)
+{
+  GObject *item = g_list_model_get_item (self->model, index);
+  GList *l;
+
+  info->item = item;
+  info->measure_valid = FALSE;
+
+  for (l = self->recycled_pages.head; l; l = l->next) {
+    RecycledPage *page = l->data;
+
+    if (page->item != item)
+      continue;
+
+    info->widget = page->widget;
+
+    g_object_unref (page->item);
+    g_free (page);
+    g_queue_delete_link (&self->recycled_pages, l);
+
+    gtk_widget_insert_before (info->widget, GTK_WIDGET (self), next_sibling);
+    gtk_widget_set_child_visible (info->widget, TRUE);
+
+    return;
+  }
+
+  info->widget = self->create_page_func (item, self->create_page_func_data);
+
+  if (g_object_is_floating (info->widget))
+    g_object_ref_sink (info->widget);
+
+  gtk_widget_insert_before (info->widget, GTK_WIDGET (self), next_sibling);
+  g_object_unref (info->widget);
+}
+
+/* With a model, only the current page and its neighbors have widgets */
+static void
+update_model_pages (AdapCarousel *self)
+{
+  int current_index, first, last, i;
+  guint j;
+
+  g_clear_handle_id (&self->update_pages_idle_id, g_source_remove);
+
+  if (!self->model)
+    return;
+
+  current_index = get_page_index_at_position (self, self->position +
+                                                    self->position_shift);
+
+  if (current_index >= 0) {
+    first = MAX (current_index - MODEL_PAGE_NEIGHBOURS, 0);
+    last = MIN (current_index + MODEL_PAGE_NEIGHBOURS, (int) self->pages->len - 1);
+  } else {
+    first = 0;
+    last = -1;
+  }
+
+  /* Reuse recycled widgets before recycling more of them */
+  for (i = last; i >= first; i--) {
+    ChildInfo *info = g_ptr_array_index (self->pages, i);
+    ChildInfo *next_info = get_nth_child (self, i + 1);
+
+    if (info->widget)
+      continue;
+
+    create_model_page (self, info, i,
+                       next_info && i < last ? next_info->widget : NULL);
+    g_ptr_array_add (self->model_pages, info);
+  }
+
+  for (j = 0; j < self->model_pages->len;) {
+    ChildInfo *info = g_ptr_array_index (self->model_pages, j);
+    gboolean in_range = FALSE;
+
+    for (i = first; i <= last; i++) {
+      if (g_ptr_array_index (self->pages, i) == info) {
+        in_range = TRUE;
+        break;
+      }
+    }
+
+    if (in_range) {
+      j++;
+      continue;
+    }
+
+    recycle_model_page (self, info);
+    g_ptr_array_remove_index_fast (self->model_pages, j);
+  }
+}
+
 static void
 scroll_animation_value_cb (double       value,
                            AdapCarousel *self)
 {
   set_position (self, value);
+  update_model_pages (self);
 
   gtk_widget_queue_allocate (GTK_WIDGET (self));
 }
 
+static void
+invalidate_measurements (AdapCarousel *self)
+{
+  GList *l;
+
+  for (l = self->children; l; l = l->next) {
+    ChildInfo *child = l->data;
+
+    child->measure_valid = FALSE;
+  }
+}
+
 static void
 scroll_animation_done_cb (AdapCarousel *self)
 {
-  GtkWidget *child;
   int index;
 
   self->animation_source_position = 0;
   self->animation_target_child = NULL;
 
-  child = get_page_at_position (self, self->position);
-  index = find_child_index (self, child, FALSE);
+  index = get_page_index_at_position (self, self->position);
 
   g_signal_emit (self, signals[SIGNAL_PAGE_CHANGED], 0, index);
 }
 
 static void
 scroll_to (AdapCarousel *self,
-           GtkWidget   *widget,
+           ChildInfo   *child,
            double       velocity)
 {
-  self->animation_target_child = find_child_info (self, widget);
+  self->animation_target_child = child;
 
   if (self->animation_target_child == NULL)
     return;
@@ -420,6 +806,7 @@ update_swipe_cb (AdapSwipeTracker *tracker,
                  AdapCarousel     *self)
 {
   set_position (self, progress);
+  update_model_pages (self);
 }
 
 static void
@@ -428,7 +815,7 @@ end_swipe_cb (AdapSwipeTracker *tracker,
               double           to,
               AdapCarousel     *self)
 {
-  GtkWidget *child = get_page_at_position (self, to);
+  ChildInfo *child = get_page_at_position (self, to);
 
   scroll_to (self, child, velocity);
 }
@@ -482,7 +869,6 @@ scroll_cb (AdapCarousel              *self,
   int index;
   gboolean allow_vertical;
   GtkOrientation orientation;
-  GtkWidget *child;
 
   if (!self->allow_scroll_wheel)
     return GDK_EVENT_PROPAGATE;
@@ -525,12 +911,10 @@ scroll_cb (AdapCarousel              *self,
   if (index == 0)
     return GDK_EVENT_PROPAGATE;
 
-  child = get_page_at_position (self, self->position);
-
-  index += find_child_index (self, child, FALSE);
+  index += get_page_index_at_position (self, self->position);
   index = CLAMP (index, 0, (int) adap_carousel_get_n_pages (self) - 1);
 
-  scroll_to (self, adap_carousel_get_nth_page (self, index), 0);
+  scroll_to (self, get_nth_child (self, index), 0);
 
   self->can_scroll = FALSE;
   self->scroll_timeout_id =
@@ -541,6 +925,46 @@ scroll_cb (AdapCarousel              *self,
   return GDK_EVENT_STOP;
 }
 
+/* Allocations happen on every frame while swiping or animating the position,
+ * so the children's sizes along the orientation are cached, keyed by
+ * orientation and for-size. The cache is dropped in adap_carousel_measure(),
+ * see validate_measurements(). Children that didn't queue a resize are then
+ * measured from GTK's own size request cache. */
+static void
+measure_child (AdapCarousel *self,
+               ChildInfo   *child,
+               int          for_size,
+               int         *minimum,
+               int         *natural)
+{
+  if (!child->measure_valid ||
+      child->measure_orientation != self->orientation ||
+      child->measure_for_size != for_size) {
+    gtk_widget_measure (child->widget, self->orientation, for_size,
+                        &child->measure_min, &child->measure_nat,
+                        NULL, NULL);
+
+    child->measure_orientation = self->orientation;
+    child->measure_for_size = for_size;
+    child->measure_valid = TRUE;
+  }
+
+  *minimum = child->measure_min;
+  *natural = child->measure_nat;
+}
+
+/* GTK only calls adap_carousel_measure() again after a resize was queued on
+ * the carousel or one of its descendants, and parents may allocate without
+ * measuring. Measuring the carousel itself is a cache hit in GTK unless that
+ * happened, so it's a cheap way to find out whether any child changed. */
+static void
+validate_measurements (AdapCarousel *self,
+                       int          for_size)
+{
+  gtk_widget_measure (GTK_WIDGET (self), self->orientation, for_size,
+                      NULL, NULL, NULL, NULL);
+}
+
 static void
 adap_carousel_measure (GtkWidget      *widget,
                       GtkOrientation  orientation,
@@ -563,12 +987,14 @@ adap_carousel_measure (GtkWidget      *widget,
   if (natural_baseline)
     *natural_baseline = -1;
 
+  invalidate_measurements (self);
+
   for (children = self->children; children; children = children->next) {
     ChildInfo *child_info = children->data;
     GtkWidget *child = child_info->widget;
     int child_min, child_nat;
 
-    if (child_info->removing)
+    if (child_info->removing || !child)
       continue;
 
     if (!gtk_widget_get_visible (child))
@@ -595,14 +1021,23 @@ adap_carousel_size_allocate (GtkWidget *widget,
   GList *children;
   double x, y, offset;
   gboolean is_rtl;
-  double snap_point;
 
   if (!G_APPROX_VALUE (self->position_shift, 0, DBL_EPSILON)) {
     set_position (self, self->position + self->position_shift);
     adap_swipe_tracker_shift_position (self->tracker, self->position_shift);
     self->position_shift = 0;
+
+    /* We can't add or remove children during allocation */
+    if (self->model && !self->update_pages_idle_id)
+      self->update_pages_idle_id =
+        g_idle_add_once ((GSourceOnceFunc) update_model_pages, self);
   }
 
+  if (self->orientation == GTK_ORIENTATION_HORIZONTAL)
+    validate_measurements (self, height);
+  else
+    validate_measurements (self, width);
+
   size = 0;
   for (children = self->children; children; children = children->next) {
     ChildInfo *child_info = children->data;
@@ -610,19 +1045,17 @@ adap_carousel_size_allocate (GtkWidget *widget,
     int min, nat;
     int child_size;
 
-    if (child_info->removing)
+    if (child_info->removing || !child)
       continue;
 
     if (self->orientation == GTK_ORIENTATION_HORIZONTAL) {
-      gtk_widget_measure (child, self->orientation,
-                          height, &min, &nat, NULL, NULL);
+      measure_child (self, child_info, height, &min, &nat);
       if (gtk_widget_get_hexpand (child))
         child_size = width;
       else
         child_size = CLAMP (nat, min, width);
     } else {
-      gtk_widget_measure (child, self->orientation,
-                          width, &min, &nat, NULL, NULL);
+      measure_child (self, child_info, width, &min, &nat);
       if (gtk_widget_get_vexpand (child))
         child_size = height;
       else
@@ -642,19 +1075,11 @@ adap_carousel_size_allocate (GtkWidget *widget,
     child_height = size;
   }
 
-  snap_point = 0;
+  update_snap_points (self);
 
-  for (children = self->children; children; children = children->next) {
-    ChildInfo *child_info = children->data;
-
-    child_info->snap_point = snap_point + child_info->size - 1;
-
-    snap_point += child_info->size;
-
-    if (child_info == self->animation_target_child)
-      adap_spring_animation_set_value_to (ADAP_SPRING_ANIMATION (self->animation),
-                                         child_info->snap_point);
-  }
+  if (self->animation_target_child)
+    adap_spring_animation_set_value_to (ADAP_SPRING_ANIMATION (self->animation),
+                                       self->animation_target_child->snap_point);
 
   x = 0;
   y = 0;
@@ -677,7 +1102,7 @@ adap_carousel_size_allocate (GtkWidget *widget,
     ChildInfo *child_info = children->data;
     GskTransform *transform = gsk_transform_new ();
 
-    if (!child_info->removing) {
+    if (!child_info->removing && child_info->widget) {
       if (!gtk_widget_get_visible (child_info->widget))
         continue;
 
@@ -733,11 +1158,7 @@ adap_carousel_dispose (GObject *object)
 {
   AdapCarousel *self = ADAP_CAROUSEL (object);
 
-  while (self->children) {
-    ChildInfo *info = self->children->data;
-
-    adap_carousel_remove (self, info->widget);
-  }
+  adap_carousel_bind_model (self, NULL, NULL, NULL, NULL);
 
   g_clear_object (&self->tracker);
   g_clear_object (&self->animation);
@@ -752,6 +1173,8 @@ adap_carousel_finalize (GObject *object)
   AdapCarousel *self = ADAP_CAROUSEL (object);
 
   g_list_free_full (self->children, (GDestroyNotify) g_free);
+  g_ptr_array_unref (self->pages);
+  g_ptr_array_unref (self->model_pages);
 
   G_OBJECT_CLASS (adap_carousel_parent_class)->finalize (object);
 }
@@ -1043,12 +1466,18 @@ adap_carousel_init (AdapCarousel *self)
 
   self->allow_scroll_wheel = TRUE;
 
+  self->pages = g_ptr_array_new ();
+  self->model_pages = g_ptr_array_new ();
+  g_queue_init (&self->recycled_pages);
+
   gtk_widget_set_overflow (GTK_WIDGET (self), GTK_OVERFLOW_HIDDEN);
 
   self->orientation = GTK_ORIENTATION_HORIZONTAL;
   self->reveal_duration = 0;
   self->can_scroll = TRUE;
 
+  adap_swipeable_invalidate_snap_points (ADAP_SWIPEABLE (self));
+
   self->tracker = adap_swipe_tracker_new (ADAP_SWIPEABLE (self));
   adap_swipe_tracker_set_allow_mouse_drag (self->tracker, TRUE);
 
@@ -1216,36 +1645,16 @@ adap_carousel_insert (AdapCarousel *self,
                      GtkWidget   *widget,
                      int          position)
 {
-  ChildInfo *info;
-  GList *next_link = NULL;
-
   g_return_if_fail (ADAP_IS_CAROUSEL (self));
   g_return_if_fail (GTK_IS_WIDGET (widget));
   g_return_if_fail (gtk_widget_get_parent (widget) == NULL);
   g_return_if_fail (position >= -1);
+  g_return_if_fail (self->model == NULL);
 
-  info = g_new0 (ChildInfo, 1);
-  info->widget = widget;
-  info->size = 0;
-  info->adding = TRUE;
+  if (position < 0)
+    position = self->pages->len;
 
-  if (position >= 0)
-    next_link = get_nth_link (self, position);
-
-  self->children = g_list_insert_before (self->children, next_link, info);
-
-  if (next_link) {
-    ChildInfo *next_sibling = next_link->data;
-
-    gtk_widget_insert_before (widget, GTK_WIDGET (self), next_sibling->widget);
-  } else {
-    gtk_widget_set_parent (widget, GTK_WIDGET (self));
-  }
-
-  self->is_being_allocated = TRUE;
-  gtk_widget_queue_allocate (GTK_WIDGET (self));
-
-  animate_child_resize (self, info, 1, self->reveal_duration);
+  insert_pages (self, widget, position, 1, TRUE);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
 }
@@ -1268,16 +1677,18 @@ adap_carousel_reorder (AdapCarousel *self,
   ChildInfo *info, *next_info = NULL;
   GList *link, *next_link;
   int old_position, n_pages;
+  guint old_index;
   double closest_point, old_point, new_point;
 
   g_return_if_fail (ADAP_IS_CAROUSEL (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (position >= -1);
+  g_return_if_fail (self->model == NULL);
 
   closest_point = get_closest_snap_point (self);
 
   info = find_child_info (self, child);
-  link = g_list_find (self->children, info);
+  link = info->link;
   old_position = g_list_position (self->children, link);
 
   if (position == old_position)
@@ -1325,10 +1736,18 @@ adap_carousel_reorder (AdapCarousel *self,
   } else {
     self->children = g_list_append (self->children, info);
     g_list_free (link);
+    info->link = g_list_last (self->children);
 
     gtk_widget_insert_before (child, GTK_WIDGET (self), NULL);
   }
 
+  if (g_ptr_array_find (self->pages, info, &old_index)) {
+    g_ptr_array_remove_index (self->pages, old_index);
+    g_ptr_array_insert (self->pages, MIN (position, n_pages - 1), info);
+  }
+
+  adap_swipeable_invalidate_snap_points (ADAP_SWIPEABLE (self));
+
   if (G_APPROX_VALUE (closest_point, old_point, DBL_EPSILON))
     self->position_shift += new_point - old_point;
   else if ((G_APPROX_VALUE (old_point, closest_point, DBL_EPSILON) || old_point > closest_point) &&
@@ -1354,33 +1773,31 @@ adap_carousel_remove (AdapCarousel *self,
                      GtkWidget   *child)
 {
   ChildInfo *info;
+  guint index;
 
   g_return_if_fail (ADAP_IS_CAROUSEL (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
   g_return_if_fail (gtk_widget_get_parent (child) == GTK_WIDGET (self));
+  g_return_if_fail (self->model == NULL);
 
   info = find_child_info (self, child);
 
   g_assert_nonnull (info);
 
-  info->removing = TRUE;
-
-  gtk_widget_unparent (child);
-
-  info->widget = NULL;
+  if (!g_ptr_array_find (self->pages, info, &index))
+    g_assert_not_reached ();
 
-  if (!gtk_widget_in_destruction (GTK_WIDGET (self)))
-    animate_child_resize (self, info, 0, self->reveal_duration);
+  remove_pages (self, index, 1, TRUE);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
 }
 
 static void
 do_scroll_to (AdapCarousel *self,
-              GtkWidget   *widget,
+              ChildInfo   *child,
               gboolean     animate)
 {
-  scroll_to (self, widget, 0);
+  scroll_to (self, child, 0);
 
   if (!animate)
     adap_animation_skip (self->animation);
@@ -1389,19 +1806,58 @@ do_scroll_to (AdapCarousel *self,
 typedef struct {
   AdapCarousel *carousel;
   GtkWidget *widget;
+  guint index;
   gboolean animate;
 } ScrollData;
 
 static void
 scroll_to_idle_cb (ScrollData *data)
 {
-  do_scroll_to (data->carousel, data->widget, data->animate);
+  ChildInfo *child = NULL;
+
+  if (data->widget) {
+    child = find_child_info (data->carousel, data->widget);
+  } else {
+    child = get_nth_child (data->carousel, data->index);
+  }
+
+  do_scroll_to (data->carousel, child, data->animate);
 
   g_object_unref (data->carousel);
-  g_object_unref (data->widget);
+  g_clear_object (&data->widget);
   g_free (data);
 }
 
+static void
+scroll_to_child (AdapCarousel *self,
+                 GtkWidget   *widget,
+                 guint        index,
+                 gboolean     animate)
+{
+  if (self->is_being_allocated) {
+    /* 'self' is still being allocated/resized by GTK
+     * async machinery (initiated from a previous adap_carousel_insert() call)
+     * So in this case let's do the scroll in an idle handler so
+     * it gets executed when everything is in place i.e. after GTK
+     * calls our adap_carousel_size_allocate() function - issue #597 */
+    ScrollData *data;
+
+    data = g_new (ScrollData, 1);
+    data->carousel = g_object_ref (self);
+    data->widget = widget ? g_object_ref (widget) : NULL;
+    data->index = index;
+    data->animate = animate;
+
+    g_idle_add_once ((GSourceOnceFunc) scroll_to_idle_cb, data);
+    return;
+  }
+
+  if (widget)
+    do_scroll_to (self, find_child_info (self, widget), animate);
+  else
+    do_scroll_to (self, get_nth_child (self, index), animate);
+}
+
 /**
  * adap_carousel_scroll_to:
  * @self: a carousel
@@ -1421,24 +1877,33 @@ adap_carousel_scroll_to (AdapCarousel *self,
   g_return_if_fail (GTK_IS_WIDGET (widget));
   g_return_if_fail (gtk_widget_get_parent (widget) == GTK_WIDGET (self));
 
-  if (self->is_being_allocated) {
-    /* 'self' is still being allocated/resized by GTK
-     * async machinery (initiated from a previous adap_carousel_insert() call)
-     * So in this case let's do the scroll in an idle handler so
-     * it gets executed when everything is in place i.e. after GTK
-     * calls our adap_carousel_size_allocate() function - issue #597 */
-    ScrollData *data;
-
-    data = g_new (ScrollData, 1);
-    data->carousel = g_object_ref (self);
-    data->widget = g_object_ref (widget);
-    data->animate = animate;
+  scroll_to_child (self, widget, 0, animate);
+}
 
-    g_idle_add_once ((GSourceOnceFunc) scroll_to_idle_cb, data);
-    return;
-  }
+/**
+ * adap_carousel_scroll_to_nth_page:
+ * @self: a carousel
+ * @n: index of the page
+ * @animate: whether to animate the transition
+ *
+ * Scrolls to the page at position @n.
+ *
+ * Unlike [method@Carousel.scroll_to], this works for pages that don't have a
+ * widget yet when a model is bound with [method@Carousel.bind_model].
+ *
+ * If @animate is `TRUE`, the transition will be animated.
+ *
+ * Since: 1.6
+ */
+void
+adap_carousel_scroll_to_nth_page (AdapCarousel *self,
+                                 guint        n,
+                                 gboolean     animate)
+{
+  g_return_if_fail (ADAP_IS_CAROUSEL (self));
+  g_return_if_fail (n < adap_carousel_get_n_pages (self));
 
-  do_scroll_to (self, widget, animate);
+  scroll_to_child (self, NULL, n, animate);
 }
 
 /**
@@ -1448,7 +1913,10 @@ adap_carousel_scroll_to (AdapCarousel *self,
  *
  * Gets the page at position @n.
  *
- * Returns: (transfer none): the page
+ * If a model is bound with [method@Carousel.bind_model], only the current page
+ * and its neighbors have widgets, and `NULL` is returned for other pages.
+ *
+ * Returns: (transfer none) (nullable): the page
  */
 GtkWidget *
 adap_carousel_get_nth_page (AdapCarousel *self,
@@ -1459,7 +1927,7 @@ adap_carousel_get_nth_page (AdapCarousel *self,
   g_return_val_if_fail (ADAP_IS_CAROUSEL (self), NULL);
   g_return_val_if_fail (n < adap_carousel_get_n_pages (self), NULL);
 
-  info = get_nth_link (self, n)->data;
+  info = get_nth_child (self, n);
 
   return info->widget;
 }
@@ -1475,20 +1943,9 @@ adap_carousel_get_nth_page (AdapCarousel *self,
 guint
 adap_carousel_get_n_pages (AdapCarousel *self)
 {
-  GList *l;
-  guint n_pages;
-
   g_return_val_if_fail (ADAP_IS_CAROUSEL (self), 0);
 
-  n_pages = 0;
-  for (l = self->children; l; l = l->next) {
-    ChildInfo *child = l->data;
-
-    if (!child->removing)
-      n_pages++;
-  }
-
-  return n_pages;
+  return self->pages->len;
 }
 
 /**
@@ -1795,3 +2252,108 @@ adap_carousel_set_reveal_duration (AdapCarousel *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_REVEAL_DURATION]);
 }
+
+static void
+items_changed_cb (AdapCarousel *self,
+                  guint        position,
+                  guint        removed,
+                  guint        added,
+                  GListModel  *model)
+{
+  gboolean animate = removed + added == 1;
+
+  /* Recycled widgets may belong to the removed items */
+  if (removed > 0)
+    clear_recycled_pages (self);
+
+  if (!animate)
+    shift_position_for_pages (self, position, removed, added);
+
+  remove_pages (self, position, removed, animate);
+  insert_pages (self, NULL, position, added, animate);
+
+  update_model_pages (self);
+
+  if (removed != added)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
+}
+
+/**
+ * adap_carousel_bind_model:
+ * @self: a carousel
+ * @model: (nullable): the model to be bound to @self
+ * @create_page_func: (nullable) (scope notified) (closure user_data) (destroy user_data_free_func): a function that creates widgets for items
+ * @user_data: user data passed to @create_page_func
+ * @user_data_free_func: function for freeing @user_data
+ *
+ * Binds @model to @self.
+ *
+ * If @self was already bound to a model, that previous binding is destroyed.
+ *
+ * The contents of @self are cleared and then filled with a page for each item
+ * in @model. The pages are updated whenever @model changes.
+ *
+ * Widgets are only created with @create_page_func for the current page and
+ * its immediate neighbors, and are released again when they are scrolled
+ * away, so the number of widgets doesn't depend on the number of items. The
+ * last few released widgets are kept and reused if their items are scrolled
+ * back to.
+ *
+ * If @model is `NULL`, @self is left empty.
+ *
+ * It is undefined to add or remove pages directly (for example, with
+ * [method@Carousel.append] or [method@Carousel.remove]) while @self is bound
+ * to a model.
+ *
+ * Since: 1.6
+ */
+void
+adap_carousel_bind_model (AdapCarousel               *self,
+                         GListModel                *model,
+                         AdapCarouselCreatePageFunc  create_page_func,
+                         gpointer                   user_data,
+                         GDestroyNotify             user_data_free_func)
+{
+  guint old_n_pages;
+
+  g_return_if_fail (ADAP_IS_CAROUSEL (self));
+  g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
+  g_return_if_fail (model == NULL || create_page_func != NULL);
+
+  if (self->model) {
+    if (self->create_page_func_data_destroy)
+      self->create_page_func_data_destroy (self->create_page_func_data);
+
+    g_signal_handlers_disconnect_by_func (self->model, items_changed_cb, self);
+    g_clear_object (&self->model);
+  }
+
+  g_clear_handle_id (&self->update_pages_idle_id, g_source_remove);
+
+  self->create_page_func = NULL;
+  self->create_page_func_data = NULL;
+  self->create_page_func_data_destroy = NULL;
+
+  clear_recycled_pages (self);
+
+  old_n_pages = self->pages->len;
+
+  shift_position_for_pages (self, 0, old_n_pages, 0);
+  remove_pages (self, 0, old_n_pages, FALSE);
+
+  if (model) {
+    self->model = g_object_ref (model);
+    self->create_page_func = create_page_func;
+    self->create_page_func_data = user_data;
+    self->create_page_func_data_destroy = user_data_free_func;
+
+    g_signal_connect_swapped (self->model, "items-changed",
+                              G_CALLBACK (items_changed_cb), self);
+
+    insert_pages (self, NULL, 0, g_list_model_get_n_items (model), FALSE);
+    update_model_pages (self);
+  }
+
+  if (self->pages->len != old_n_pages)
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_N_PAGES]);
+}
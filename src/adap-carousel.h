@@ -23,6 +23,21 @@ G_BEGIN_DECLS
 ADAP_AVAILABLE_IN_ALL
 G_DECLARE_FINAL_TYPE (AdapCarousel, adap_carousel, ADAP, CAROUSEL, GtkWidget)
 
+/**
+ * AdapCarouselCreatePageFunc:
+ * @item: (type GObject): the item from the model for which to create a page
+ * @user_data: (closure): user data
+ *
+ * Called for carousels bound to a model with [method@Carousel.bind_model] to
+ * create a page for @item when it's about to be shown.
+ *
+ * Returns: (transfer full): a widget that represents @item
+ *
+ * Since: 1.6
+ */
+typedef GtkWidget *(*AdapCarouselCreatePageFunc) (gpointer item,
+                                                  gpointer user_data);
+
 ADAP_AVAILABLE_IN_ALL
 GtkWidget *adap_carousel_new (void) G_GNUC_WARN_UNUSED_RESULT;
 
@@ -46,10 +61,21 @@ ADAP_AVAILABLE_IN_ALL
 void adap_carousel_remove (AdapCarousel *self,
                           GtkWidget   *child);
 
-ADAP_AVAILABLE_IN_ALL
-void adap_carousel_scroll_to (AdapCarousel *self,
-                             GtkWidget   *widget,
-                             gboolean     animate);
+ADAP_AVAILABLE_IN_1_6
+void adap_carousel_bind_model (AdapCarousel               *self,
+                              GListModel                *model,
+                              AdapCarouselCreatePageFunc  create_page_func,
+                              gpointer                   user_data,
+                              GDestroyNotify             user_data_free_func);
+
+ADAP_AVAILABLE_IN_ALL
+void adap_carousel_scroll_to          (AdapCarousel *self,
+                                      GtkWidget   *widget,
+                                      gboolean     animate);
+ADAP_AVAILABLE_IN_1_6
+void adap_carousel_scroll_to_nth_page (AdapCarousel *self,
+                                      guint        n,
+                                      gboolean     animate);
 
 ADAP_AVAILABLE_IN_ALL
 GtkWidget *adap_carousel_get_nth_page (AdapCarousel *self,
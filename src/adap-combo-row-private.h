@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADAPTA_INSIDE) && !defined(ADAPTA_COMPILATION)
+#error "Only <adapta.h> can be included directly."
+#endif
+
+#include "adap-combo-row.h"
+
+G_BEGIN_DECLS
+
+ADAP_AVAILABLE_IN_ALL
+void        adap_combo_row_set_search_text     (AdapComboRow *self,
+                                                const char   *text);
+ADAP_AVAILABLE_IN_ALL
+GListModel *adap_combo_row_get_search_results (AdapComboRow *self);
+
+G_END_DECLS
@@ -11,7 +11,7 @@
  */
 
 #include "config.h"
-#include "adap-combo-row.h"
+#include "adap-combo-row-private.h"
 
 /**
  * AdapComboRow:
@@ -84,6 +84,9 @@ typedef struct
   GtkListItemFactory *list_factory;
   GListModel *model;
   GListModel *filter_model;
+  GtkFilter *filter;
+  char *search_key;
+  GHashTable *item_keys;
   GtkSelectionModel *selection;
   GtkSelectionModel *popup_selection;
   GtkSelectionModel *current_selection;
@@ -129,12 +132,107 @@ get_item_representation (AdapComboRow *self,
   return NULL;
 }
 
+/* Same normalization as GtkStringFilter with ignore-case */
+static char *
+make_search_key (const char *text)
+{
+  char *normalized = g_utf8_normalize (text, -1, G_NORMALIZE_ALL);
+  char *key = g_utf8_casefold (normalized, -1);
+
+  g_free (normalized);
+
+  return key;
+}
+
+/* Evaluating the expression for every item on every keystroke is slow for
+ * large models, so the keys are cached until the popup is closed or the model
+ * or expression change */
+static const char *
+get_item_search_key (AdapComboRow *self,
+                     gpointer      item)
+{
+  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
+  char *key;
+
+  if (g_hash_table_lookup_extended (priv->item_keys, item, NULL, (gpointer *) &key))
+    return key;
+
+  key = get_item_representation (self, item);
+
+  if (key) {
+    char *tmp = key;
+
+    key = make_search_key (tmp);
+
+    g_free (tmp);
+  }
+
+  g_hash_table_insert (priv->item_keys, g_object_ref (item), key);
+
+  return key;
+}
+
+static gboolean
+filter_item (gpointer      item,
+             AdapComboRow *self)
+{
+  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
+  const char *key;
+
+  /* Without an expression there's nothing to search, keep every item */
+  if (!priv->search_key || !priv->expression)
+    return TRUE;
+
+  key = get_item_search_key (self, item);
+
+  return key && strstr (key, priv->search_key);
+}
+
+static void
+set_search (AdapComboRow *self,
+            const char   *text)
+{
+  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  char *old_key;
+
+  old_key = priv->search_key;
+  priv->search_key = text && *text ? make_search_key (text) : NULL;
+
+  if (!g_strcmp0 (old_key, priv->search_key)) {
+    g_free (old_key);
+    return;
+  }
+
+  if (!priv->filter_model) {
+    g_free (old_key);
+    return;
+  }
+
+  if (!priv->search_key) {
+    /* Dropping the filter is synchronous even in incremental mode, so
+     * positions are 1-1 with the model right away */
+    gtk_filter_list_model_set_filter (GTK_FILTER_LIST_MODEL (priv->filter_model), NULL);
+  } else if (!old_key) {
+    gtk_filter_list_model_set_filter (GTK_FILTER_LIST_MODEL (priv->filter_model), priv->filter);
+  } else {
+    /* Typing more can only remove results, deleting can only add them */
+    if (strstr (priv->search_key, old_key))
+      change = GTK_FILTER_CHANGE_MORE_STRICT;
+    else if (strstr (old_key, priv->search_key))
+      change = GTK_FILTER_CHANGE_LESS_STRICT;
+
+    gtk_filter_changed (priv->filter, change);
+  }
+
+  g_free (old_key);
+}
+
 static void
 selection_changed (AdapComboRow *self)
 {
   AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
   guint selected;
-  GtkFilter *filter;
 
   if (!GTK_IS_SINGLE_SELECTION (priv->selection))
     return;
@@ -142,9 +240,7 @@ selection_changed (AdapComboRow *self)
   selected = gtk_single_selection_get_selected (GTK_SINGLE_SELECTION (priv->selection));
 
   /* reset the filter so positions are 1-1 */
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (priv->filter_model));
-  if (GTK_IS_STRING_FILTER (filter))
-    gtk_string_filter_set_search (GTK_STRING_FILTER (filter), "");
+  set_search (self, NULL);
   gtk_single_selection_set_selected (GTK_SINGLE_SELECTION (priv->popup_selection), selected);
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SELECTED]);
@@ -187,14 +283,11 @@ static void
 row_activated_cb (AdapComboRow *self)
 {
   AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
-  GtkFilter *filter;
 
   gtk_popover_popdown (GTK_POPOVER (priv->popover));
 
   /* reset the filter so positions are 1-1 */
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (priv->filter_model));
-  if (GTK_IS_STRING_FILTER (filter))
-    gtk_string_filter_set_search (GTK_STRING_FILTER (filter), "");
+  set_search (self, NULL);
   adap_combo_row_set_selected (self, gtk_single_selection_get_selected (GTK_SINGLE_SELECTION (priv->popup_selection)));
 }
 
@@ -208,6 +301,9 @@ notify_popover_visible_cb (AdapComboRow *self)
   } else {
     gtk_widget_remove_css_class (GTK_WIDGET (self), "has-open-popup");
     gtk_editable_set_text (GTK_EDITABLE (priv->search_entry), "");
+
+    /* Items may change while the popup is closed */
+    g_hash_table_remove_all (priv->item_keys);
   }
 }
 
@@ -215,32 +311,18 @@ static void
 update_filter (AdapComboRow *self)
 {
   AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
-  
-  if (priv->filter_model) {
-      GtkFilter *filter;
-
-      if (priv->expression) 
-        filter = GTK_FILTER (gtk_string_filter_new (gtk_expression_ref (priv->expression)));
-      else 
-        filter = GTK_FILTER (gtk_every_filter_new ());
-      gtk_filter_list_model_set_filter (GTK_FILTER_LIST_MODEL (priv->filter_model), filter);
-      g_object_unref (filter);
-  }
+
+  g_hash_table_remove_all (priv->item_keys);
+
+  if (priv->search_key)
+    gtk_filter_changed (priv->filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 static void
 search_changed_cb (GtkSearchEntry *entry,
                    AdapComboRow    *self)
 {
-  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
-  const char *text;
-  GtkFilter *filter;
-
-  text = gtk_editable_get_text (GTK_EDITABLE (entry));
-
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (priv->filter_model));
-  if (GTK_IS_STRING_FILTER (filter))
-    gtk_string_filter_set_search (GTK_STRING_FILTER (filter), text);
+  set_search (self, gtk_editable_get_text (GTK_EDITABLE (entry)));
 }
 
 static void
@@ -249,15 +331,10 @@ search_stop_cb (GtkSearchEntry *entry,
 {
   AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
 
-  GtkFilter *filter;
-
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (priv->filter_model));
-  if (GTK_IS_STRING_FILTER (filter)) {
-    if (gtk_string_filter_get_search (GTK_STRING_FILTER (filter)))
-      gtk_string_filter_set_search (GTK_STRING_FILTER (filter), NULL);
-    else
-      gtk_popover_popdown (GTK_POPOVER (priv->popover));
-  }
+  if (priv->search_key)
+    set_search (self, NULL);
+  else
+    gtk_popover_popdown (GTK_POPOVER (priv->popover));
 }
 
 static void
@@ -506,12 +583,25 @@ adap_combo_row_dispose (GObject *object)
   g_clear_object (&priv->factory);
   g_clear_object (&priv->list_factory);
   g_clear_object (&priv->filter_model);
+  g_clear_object (&priv->filter);
 
   g_clear_object (&priv->model);
 
   G_OBJECT_CLASS (adap_combo_row_parent_class)->dispose (object);
 }
 
+static void
+adap_combo_row_finalize (GObject *object)
+{
+  AdapComboRow *self = ADAP_COMBO_ROW (object);
+  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
+
+  g_free (priv->search_key);
+  g_hash_table_unref (priv->item_keys);
+
+  G_OBJECT_CLASS (adap_combo_row_parent_class)->finalize (object);
+}
+
 static void
 adap_combo_row_size_allocate (GtkWidget *widget,
                              int        width,
@@ -549,6 +639,7 @@ adap_combo_row_class_init (AdapComboRowClass *klass)
   object_class->get_property = adap_combo_row_get_property;
   object_class->set_property = adap_combo_row_set_property;
   object_class->dispose = adap_combo_row_dispose;
+  object_class->finalize = adap_combo_row_finalize;
 
   widget_class->size_allocate = adap_combo_row_size_allocate;
   widget_class->focus = adap_combo_row_focus;
@@ -685,6 +776,11 @@ adap_combo_row_class_init (AdapComboRowClass *klass)
 static void
 adap_combo_row_init (AdapComboRow *self)
 {
+  AdapComboRowPrivate *priv = adap_combo_row_get_instance_private (self);
+
+  priv->filter = GTK_FILTER (gtk_custom_filter_new ((GtkCustomFilterFunc) filter_item, self, NULL));
+  priv->item_keys = g_hash_table_new_full (NULL, NULL, g_object_unref, g_free);
+
   gtk_widget_init_template (GTK_WIDGET (self));
 
   adap_preferences_row_set_use_markup (ADAP_PREFERENCES_ROW (self), FALSE);
@@ -838,11 +934,15 @@ adap_combo_row_set_model (AdapComboRow *self,
     GListModel *filter_model;
     GListModel *current_model;
 
+    g_hash_table_remove_all (priv->item_keys);
+
+    /* Filter in chunks so that searching very large models doesn't block */
     filter_model = G_LIST_MODEL (gtk_filter_list_model_new (g_object_ref (model), NULL));
+    gtk_filter_list_model_set_incremental (GTK_FILTER_LIST_MODEL (filter_model), TRUE);
+    if (priv->search_key)
+      gtk_filter_list_model_set_filter (GTK_FILTER_LIST_MODEL (filter_model), priv->filter);
     g_set_object (&priv->filter_model, filter_model);
 
-    update_filter (self);
-
     selection = GTK_SELECTION_MODEL (gtk_single_selection_new (g_object_ref (filter_model)));
     g_set_object (&priv->popup_selection, selection);
     gtk_list_view_set_model (priv->list, selection);
@@ -1148,3 +1248,24 @@ adap_combo_row_set_enable_search (AdapComboRow *self,
 
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ENABLE_SEARCH]);
 }
+
+void
+adap_combo_row_set_search_text (AdapComboRow *self,
+                                const char   *text)
+{
+  g_return_if_fail (ADAP_IS_COMBO_ROW (self));
+
+  set_search (self, text);
+}
+
+GListModel *
+adap_combo_row_get_search_results (AdapComboRow *self)
+{
+  AdapComboRowPrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_COMBO_ROW (self), NULL);
+
+  priv = adap_combo_row_get_instance_private (self);
+
+  return priv->filter_model;
+}
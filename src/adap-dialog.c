@@ -162,6 +162,8 @@ enum {
   PROP_FOCUS_WIDGET,
   PROP_DEFAULT_WIDGET,
   PROP_CURRENT_BREAKPOINT,
+  PROP_BREAKPOINT_HYSTERESIS,
+  PROP_BREAKPOINT_SETTLE_FRAMES,
   LAST_PROP
 };
 
@@ -973,6 +975,12 @@ adap_dialog_get_property (GObject    *object,
   case PROP_CURRENT_BREAKPOINT:
     g_value_set_object (value, adap_dialog_get_current_breakpoint (self));
     break;
+  case PROP_BREAKPOINT_HYSTERESIS:
+    g_value_set_int (value, adap_dialog_get_breakpoint_hysteresis (self));
+    break;
+  case PROP_BREAKPOINT_SETTLE_FRAMES:
+    g_value_set_uint (value, adap_dialog_get_breakpoint_settle_frames (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1014,6 +1022,12 @@ adap_dialog_set_property (GObject      *object,
   case PROP_FOLLOWS_CONTENT_SIZE:
     adap_dialog_set_follows_content_size (self, g_value_get_boolean (value));
     break;
+  case PROP_BREAKPOINT_HYSTERESIS:
+    adap_dialog_set_breakpoint_hysteresis (self, g_value_get_int (value));
+    break;
+  case PROP_BREAKPOINT_SETTLE_FRAMES:
+    adap_dialog_set_breakpoint_settle_frames (self, g_value_get_uint (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1190,6 +1204,36 @@ adap_dialog_class_init (AdapDialogClass *klass)
                          ADAP_TYPE_BREAKPOINT,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdapDialog:breakpoint-hysteresis: (attributes org.gtk.Property.get=adap_dialog_get_breakpoint_hysteresis org.gtk.Property.set=adap_dialog_set_breakpoint_hysteresis)
+   *
+   * How far past a breakpoint's threshold the dialog size must go before
+   * switching, in pixels.
+   *
+   * See [property@BreakpointBin:hysteresis].
+   *
+   * Since: 1.6
+   */
+  props[PROP_BREAKPOINT_HYSTERESIS] =
+    g_param_spec_int ("breakpoint-hysteresis", NULL, NULL,
+                      0, G_MAXINT, 0,
+                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdapDialog:breakpoint-settle-frames: (attributes org.gtk.Property.get=adap_dialog_get_breakpoint_settle_frames org.gtk.Property.set=adap_dialog_set_breakpoint_settle_frames)
+   *
+   * How many frames the dialog size must stay the same before switching
+   * breakpoints.
+   *
+   * See [property@BreakpointBin:settle-frames].
+   *
+   * Since: 1.6
+   */
+  props[PROP_BREAKPOINT_SETTLE_FRAMES] =
+    g_param_spec_uint ("breakpoint-settle-frames", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -2014,6 +2058,121 @@ adap_dialog_get_current_breakpoint (AdapDialog *self)
   return adap_breakpoint_bin_get_current_breakpoint (bin);
 }
 
+/**
+ * adap_dialog_get_breakpoint_hysteresis: (attributes org.gtk.Method.get_property=breakpoint-hysteresis)
+ * @self: a dialog
+ *
+ * Gets how far past a breakpoint's threshold the size of @self must go before
+ * switching.
+ *
+ * Returns: the hysteresis margin in pixels
+ *
+ * Since: 1.6
+ */
+int
+adap_dialog_get_breakpoint_hysteresis (AdapDialog *self)
+{
+  AdapDialogPrivate *priv;
+  AdapBreakpointBin *bin;
+
+  g_return_val_if_fail (ADAP_IS_DIALOG (self), 0);
+
+  priv = adap_dialog_get_instance_private (self);
+  bin = ADAP_BREAKPOINT_BIN (priv->child_breakpoint_bin);
+
+  return adap_breakpoint_bin_get_hysteresis (bin);
+}
+
+/**
+ * adap_dialog_set_breakpoint_hysteresis: (attributes org.gtk.Method.set_property=breakpoint-hysteresis)
+ * @self: a dialog
+ * @hysteresis: the hysteresis margin in pixels
+ *
+ * Sets how far past a breakpoint's threshold the size of @self must go before
+ * switching.
+ *
+ * See [property@BreakpointBin:hysteresis].
+ *
+ * Since: 1.6
+ */
+void
+adap_dialog_set_breakpoint_hysteresis (AdapDialog *self,
+                                      int        hysteresis)
+{
+  AdapDialogPrivate *priv;
+  AdapBreakpointBin *bin;
+
+  g_return_if_fail (ADAP_IS_DIALOG (self));
+  g_return_if_fail (hysteresis >= 0);
+
+  priv = adap_dialog_get_instance_private (self);
+  bin = ADAP_BREAKPOINT_BIN (priv->child_breakpoint_bin);
+
+  if (adap_breakpoint_bin_get_hysteresis (bin) == hysteresis)
+    return;
+
+  adap_breakpoint_bin_set_hysteresis (bin, hysteresis);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_BREAKPOINT_HYSTERESIS]);
+}
+
+/**
+ * adap_dialog_get_breakpoint_settle_frames: (attributes org.gtk.Method.get_property=breakpoint-settle-frames)
+ * @self: a dialog
+ *
+ * Gets how many frames the size of @self must stay the same before switching
+ * breakpoints.
+ *
+ * Returns: the number of frames
+ *
+ * Since: 1.6
+ */
+guint
+adap_dialog_get_breakpoint_settle_frames (AdapDialog *self)
+{
+  AdapDialogPrivate *priv;
+  AdapBreakpointBin *bin;
+
+  g_return_val_if_fail (ADAP_IS_DIALOG (self), 0);
+
+  priv = adap_dialog_get_instance_private (self);
+  bin = ADAP_BREAKPOINT_BIN (priv->child_breakpoint_bin);
+
+  return adap_breakpoint_bin_get_settle_frames (bin);
+}
+
+/**
+ * adap_dialog_set_breakpoint_settle_frames: (attributes org.gtk.Method.set_property=breakpoint-settle-frames)
+ * @self: a dialog
+ * @settle_frames: the number of frames
+ *
+ * Sets how many frames the size of @self must stay the same before switching
+ * breakpoints.
+ *
+ * See [property@BreakpointBin:settle-frames].
+ *
+ * Since: 1.6
+ */
+void
+adap_dialog_set_breakpoint_settle_frames (AdapDialog *self,
+                                         guint      settle_frames)
+{
+  AdapDialogPrivate *priv;
+  AdapBreakpointBin *bin;
+
+  g_return_if_fail (ADAP_IS_DIALOG (self));
+
+  priv = adap_dialog_get_instance_private (self);
+  bin = ADAP_BREAKPOINT_BIN (priv->child_breakpoint_bin);
+
+  if (adap_breakpoint_bin_get_settle_frames (bin) == settle_frames)
+    return;
+
+  adap_breakpoint_bin_set_settle_frames (bin, settle_frames);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_BREAKPOINT_SETTLE_FRAMES]);
+}
+
 static AdapDialogHost *
 find_dialog_host (GtkWidget *widget)
 {
@@ -113,6 +113,18 @@ void adap_dialog_add_breakpoint (AdapDialog     *self,
 ADAP_AVAILABLE_IN_1_5
 AdapBreakpoint *adap_dialog_get_current_breakpoint (AdapDialog *self);
 
+ADAP_AVAILABLE_IN_1_6
+int  adap_dialog_get_breakpoint_hysteresis (AdapDialog *self);
+ADAP_AVAILABLE_IN_1_6
+void adap_dialog_set_breakpoint_hysteresis (AdapDialog *self,
+                                           int        hysteresis);
+
+ADAP_AVAILABLE_IN_1_6
+guint adap_dialog_get_breakpoint_settle_frames (AdapDialog *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_dialog_set_breakpoint_settle_frames (AdapDialog *self,
+                                               guint      settle_frames);
+
 ADAP_AVAILABLE_IN_1_5
 void adap_dialog_present (AdapDialog *self,
                          GtkWidget *parent);
@@ -10,6 +10,7 @@
 #include "adap-indicator-bin-private.h"
 
 #include "adap-gizmo-private.h"
+#include "adap-style-manager-private.h"
 #include "adap-widget-utils-private.h"
 
 /**
@@ -259,6 +260,8 @@ adap_indicator_bin_class_init (AdapIndicatorBinClass *klass)
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "indicatorbin");
+
+  adap_style_manager_ensure_fragment ("view-switcher");
 }
 
 static void
@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2023 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ *
+ * Author: Alice Mikhaylenko <alice.mikhaylenko@puri.sm>
+ */
+
+#pragma once
+
+#if !defined(_ADAPTA_INSIDE) && !defined(ADAPTA_COMPILATION)
+#error "Only <adapta.h> can be included directly."
+#endif
+
+#include "adap-length-unit.h"
+
+G_BEGIN_DECLS
+
+double adap_length_unit_get_dpi (GtkSettings *settings);
+
+double adap_length_unit_to_px_for_dpi (AdapLengthUnit unit,
+                                      double        value,
+                                      double        dpi);
+
+G_END_DECLS
@@ -8,7 +8,7 @@
 
 #include "config.h"
 
-#include "adap-length-unit.h"
+#include "adap-length-unit-private.h"
 
 /**
  * AdapLengthUnit:
@@ -69,16 +69,10 @@ adap_length_unit_to_px (AdapLengthUnit  unit,
   if (!settings)
     return 0;
 
-  switch (unit) {
-  case ADAP_LENGTH_UNIT_PX:
+  if (unit == ADAP_LENGTH_UNIT_PX)
     return value;
-  case ADAP_LENGTH_UNIT_PT:
-    return value * get_dpi (settings) / 72.0;
-  case ADAP_LENGTH_UNIT_SP:
-    return value * get_dpi (settings) / 96.0;
-  default:
-    g_assert_not_reached ();
-  }
+
+  return adap_length_unit_to_px_for_dpi (unit, value, get_dpi (settings));
 }
 
 /**
@@ -119,3 +113,30 @@ adap_length_unit_from_px (AdapLengthUnit  unit,
     g_assert_not_reached ();
   }
 }
+
+double
+adap_length_unit_get_dpi (GtkSettings *settings)
+{
+  g_return_val_if_fail (GTK_IS_SETTINGS (settings), 96.0);
+
+  return get_dpi (settings);
+}
+
+/* Same as adap_length_unit_to_px(), but with a DPI value the caller already
+ * has, to avoid looking it up for each conversion */
+double
+adap_length_unit_to_px_for_dpi (AdapLengthUnit unit,
+                               double        value,
+                               double        dpi)
+{
+  switch (unit) {
+  case ADAP_LENGTH_UNIT_PX:
+    return value;
+  case ADAP_LENGTH_UNIT_PT:
+    return value * dpi / 72.0;
+  case ADAP_LENGTH_UNIT_SP:
+    return value * dpi / 96.0;
+  default:
+    g_assert_not_reached ();
+  }
+}
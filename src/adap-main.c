@@ -12,8 +12,39 @@
 #include <glib/gi18n-lib.h>
 #include <gtk/gtk.h>
 
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
 static int adap_initialized = FALSE;
 
+/* Startup phases are reported as sysprof marks when built with profiling
+ * enabled, and printed when ADAP_DEBUG_STARTUP is set */
+static void
+startup_mark (gint64      begin_time,
+              const char *name)
+{
+  static gsize init = 0;
+  static gboolean debug = FALSE;
+  gint64 end_time = g_get_monotonic_time ();
+
+  if (g_once_init_enter (&init)) {
+    debug = !!g_getenv ("ADAP_DEBUG_STARTUP");
+    g_once_init_leave (&init, 1);
+  }
+
+#ifdef HAVE_SYSPROF
+  sysprof_collector_mark (begin_time * 1000,
+                          (end_time - begin_time) * 1000,
+                          "Adapta",
+                          name,
+                          NULL);
+#endif
+
+  if (debug)
+    g_message ("Startup: %s: %.3f ms", name, (end_time - begin_time) / 1000.0);
+}
+
 /**
  * adap_init:
  *
@@ -26,34 +57,56 @@ static int adap_initialized = FALSE;
  *
  * If Libadapta has already been initialized, the function will simply return.
  *
- * This makes sure translations, types, themes, and icons for the Adapta
+ * This makes sure translations, themes, and icons for the Adapta
  * library are set up properly.
  */
 void
 adap_init (void)
 {
+  gint64 init_time, begin_time;
+
   if (adap_initialized)
     return;
 
+  init_time = begin_time = g_get_monotonic_time ();
+
   gtk_init ();
 
+  startup_mark (begin_time, "Initialize GTK");
+  begin_time = g_get_monotonic_time ();
+
   bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
   bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
-  adap_init_public_types ();
+
+  startup_mark (begin_time, "Bind text domain");
 
   if (!adap_is_granite_present ()) {
+    begin_time = g_get_monotonic_time ();
+
     gtk_icon_theme_add_resource_path (gtk_icon_theme_get_for_display (gdk_display_get_default ()),
                                       "/org/gnome/Adapta/icons");
 
+    startup_mark (begin_time, "Add icon resource path");
+    begin_time = g_get_monotonic_time ();
+
     adap_style_manager_ensure ();
 
+    startup_mark (begin_time, "Create style manager");
+    begin_time = g_get_monotonic_time ();
+
+    /* This only adds the type to the extension point, the page is created
+     * when the inspector is opened */
     if (g_io_extension_point_lookup ("gtk-inspector-page"))
       g_io_extension_point_implement ("gtk-inspector-page",
                                       ADAP_TYPE_INSPECTOR_PAGE,
                                       "libadapta",
                                       10);
+
+    startup_mark (begin_time, "Register inspector page");
   }
 
+  startup_mark (init_time, "Initialize Adapta");
+
   adap_initialized = TRUE;
 }
 
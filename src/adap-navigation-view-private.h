@@ -18,6 +18,8 @@ G_BEGIN_DECLS
 
 AdapNavigationView *adap_navigation_page_get_child_view (AdapNavigationPage *self);
 
+GdkPaintable *adap_navigation_page_get_transition_image (AdapNavigationPage *self);
+
 void adap_navigation_page_showing (AdapNavigationPage *self);
 void adap_navigation_page_shown   (AdapNavigationPage *self);
 void adap_navigation_page_hiding  (AdapNavigationPage *self);
@@ -17,6 +17,9 @@
 #include "adap-swipe-tracker.h"
 #include "adap-widget-utils-private.h"
 
+/* Preloaded pages that haven't been pushed yet, kept apart from popped ones */
+#define MAX_PRELOADED_PAGES 3
+
 /**
  * AdapNavigationView:
  *
@@ -102,6 +105,28 @@
  * [property@NavigationPage:can-pop] can be used to disable them, along with the
  * header bar back buttons.
  *
+ * ## Page Retention and Preloading
+ *
+ * Pages that haven't been added with [method@NavigationView.add] are removed
+ * once they are popped. Set [property@NavigationView:max-retained-pages] to
+ * keep the most recently popped of them around instead, so that pushing them
+ * again, for example via [method@NavigationView.find_page] from a
+ * [signal@NavigationView::get-next-page] handler, doesn't need to build them
+ * from scratch.
+ *
+ * Use [method@NavigationView.preload] or [method@NavigationView.preload_tag]
+ * to prepare a page that is likely to be pushed next, such as the detail page
+ * for a hovered list row. Its style and size are computed in idle time, so the
+ * push transition starts with a page that is ready to be drawn.
+ *
+ * ## Transition Cache
+ *
+ * By default, both pages are redrawn on every frame of a transition. For
+ * pages that are expensive to draw, such as maps or long lists, set
+ * [property@NavigationView:transition-cache] to draw them once when the
+ * transition starts and move that image instead. If a cached page changes
+ * during the transition, it's drawn live again until the transition ends.
+ *
  * ## Actions
  *
  * `AdapNavigationView` defines actions for controlling the navigation stack.
@@ -214,6 +239,26 @@
  * Since: 1.4
  */
 
+/**
+ * AdapNavigationTransitionCache:
+ * @ADAP_NAVIGATION_TRANSITION_CACHE_NONE: Both pages are redrawn on every frame
+ *   of the transition
+ * @ADAP_NAVIGATION_TRANSITION_CACHE_HIDING: The hiding page is drawn once when
+ *   the transition starts, and the showing page is redrawn on every frame
+ * @ADAP_NAVIGATION_TRANSITION_CACHE_ALL: Both pages are drawn once when the
+ *   transition starts
+ *
+ * Describes which pages [class@NavigationView] draws only once during a
+ * transition.
+ *
+ * A cached page that changes during the transition is drawn live again until
+ * the transition ends.
+ *
+ * See [property@NavigationView:transition-cache].
+ *
+ * Since: 1.6
+ */
+
 typedef struct
 {
   GtkWidget *child;
@@ -229,6 +274,10 @@ typedef struct
   AdapNavigationView *child_view;
 
   int nav_split_views;
+
+  GdkPaintable *transition_paintable;
+  GdkPaintable *transition_image;
+  gboolean transition_image_invalid;
 } AdapNavigationPagePrivate;
 
 static void adap_navigation_page_buildable_init (GtkBuildableIface *iface);
@@ -283,6 +332,15 @@ struct _AdapNavigationView
 
   GtkWidget *shield;
 
+  AdapNavigationTransitionCache transition_cache;
+
+  guint max_retained_pages;
+  GQueue retained_pages;
+  GQueue preloaded_pages;
+
+  GQueue preload_queue;
+  guint preload_idle_id;
+
   GListModel *navigation_stack_model;
 };
 
@@ -299,6 +357,8 @@ enum {
   PROP_ANIMATE_TRANSITIONS,
   PROP_POP_ON_ESCAPE,
   PROP_NAVIGATION_STACK,
+  PROP_TRANSITION_CACHE,
+  PROP_MAX_RETAINED_PAGES,
   LAST_PROP
 };
 
@@ -411,12 +471,43 @@ adap_navigation_page_realize (GtkWidget *widget)
   }
 }
 
+static void
+transition_image_invalidated_cb (AdapNavigationPage *self)
+{
+  AdapNavigationPagePrivate *priv = adap_navigation_page_get_instance_private (self);
+
+  /* The page has changed, draw it live for the rest of the transition. The
+   * paintable is emitting this signal, so it's only released along with the
+   * rest of the cache once the transition ends */
+  g_signal_handlers_disconnect_by_func (priv->transition_paintable,
+                                        transition_image_invalidated_cb, self);
+  g_clear_object (&priv->transition_image);
+  priv->transition_image_invalid = TRUE;
+}
+
+static void
+clear_transition_image (AdapNavigationPage *self)
+{
+  AdapNavigationPagePrivate *priv = adap_navigation_page_get_instance_private (self);
+
+  if (priv->transition_paintable) {
+    g_signal_handlers_disconnect_by_func (priv->transition_paintable,
+                                          transition_image_invalidated_cb, self);
+    g_clear_object (&priv->transition_paintable);
+  }
+
+  g_clear_object (&priv->transition_image);
+  priv->transition_image_invalid = FALSE;
+}
+
 static void
 adap_navigation_page_dispose (GObject *object)
 {
   AdapNavigationPage *self = ADAP_NAVIGATION_PAGE (object);
   AdapNavigationPagePrivate *priv = adap_navigation_page_get_instance_private (self);
 
+  clear_transition_image (self);
+
   g_clear_pointer (&priv->child, gtk_widget_unparent);
 
   if (priv->child_view) {
@@ -716,6 +807,56 @@ adap_navigation_page_buildable_init (GtkBuildableIface *iface)
   iface->add_child = adap_navigation_page_buildable_add_child;
 }
 
+static void
+trim_retained_pages (AdapNavigationView *self,
+                     guint               max_pages)
+{
+  while (self->retained_pages.length > max_pages) {
+    AdapNavigationPage *page = g_queue_pop_tail (&self->retained_pages);
+
+    adap_navigation_view_remove (self, page);
+  }
+}
+
+/* Stops keeping @page around as a popped or preloaded page, returns whether
+ * it was kept */
+static gboolean
+unretain_page (AdapNavigationView *self,
+               AdapNavigationPage *page)
+{
+  return g_queue_remove (&self->retained_pages, page) ||
+         g_queue_remove (&self->preloaded_pages, page);
+}
+
+/* Called for popped pages that haven't been added with
+ * adap_navigation_view_add() */
+static void
+discard_page (AdapNavigationView *self,
+              AdapNavigationPage *page)
+{
+  if (self->max_retained_pages == 0) {
+    adap_navigation_view_remove (self, page);
+    return;
+  }
+
+  gtk_widget_set_child_visible (GTK_WIDGET (page), FALSE);
+
+  unretain_page (self, page);
+  g_queue_push_head (&self->retained_pages, page);
+
+  trim_retained_pages (self, self->max_retained_pages);
+}
+
+static void
+clear_transition_cache (AdapNavigationView *self)
+{
+  if (self->hiding_page)
+    clear_transition_image (self->hiding_page);
+
+  if (self->showing_page)
+    clear_transition_image (self->showing_page);
+}
+
 static void
 switch_page (AdapNavigationView *self,
              AdapNavigationPage *prev_page,
@@ -741,6 +882,8 @@ switch_page (AdapNavigationView *self,
   if (self->transition_cancel)
     adap_animation_skip (self->transition);
 
+  clear_transition_cache (self);
+
   if (focus && prev_page && gtk_widget_is_ancestor (focus, GTK_WIDGET (prev_page))) {
     AdapNavigationPagePrivate *priv = adap_navigation_page_get_instance_private (prev_page);
 
@@ -765,7 +908,7 @@ switch_page (AdapNavigationView *self,
     adap_animation_reset (self->transition);
 
     if (self->transition_pop && get_remove_on_pop (hiding_page))
-      adap_navigation_view_remove (self, hiding_page);
+      discard_page (self, hiding_page);
     else
       gtk_widget_set_child_visible (GTK_WIDGET (hiding_page), FALSE);
 
@@ -843,6 +986,7 @@ push_to_stack (AdapNavigationView *self,
     return;
   }
 
+  unretain_page (self, page);
   g_list_store_append (self->navigation_stack, page);
 
   switch_page (self, previous_page, page, FALSE, animate, velocity);
@@ -893,7 +1037,7 @@ pop_from_stack (AdapNavigationView *self,
     g_signal_emit (self, signals[SIGNAL_POPPED], 0, c);
 
     if (c != old_page && get_remove_on_pop (c))
-      adap_navigation_view_remove (self, c);
+      discard_page (self, c);
   }
 
   if (self->navigation_stack_model)
@@ -915,6 +1059,8 @@ transition_cb (double             value,
 static void
 transition_done_cb (AdapNavigationView *self)
 {
+  clear_transition_cache (self);
+
   if (self->hiding_page) {
     AdapNavigationPage *hiding_page = g_steal_pointer (&self->hiding_page);
 
@@ -926,7 +1072,7 @@ transition_done_cb (AdapNavigationView *self)
       adap_navigation_page_hidden (hiding_page);
 
       if (self->transition_pop && get_remove_on_pop (hiding_page))
-        adap_navigation_view_remove (self, hiding_page);
+        discard_page (self, hiding_page);
       else
         gtk_widget_set_child_visible (GTK_WIDGET (hiding_page), FALSE);
     }
@@ -941,7 +1087,7 @@ transition_done_cb (AdapNavigationView *self)
       adap_navigation_page_hidden (showing_page);
 
       if (!self->transition_pop && get_remove_on_pop (showing_page))
-        adap_navigation_view_remove (self, showing_page);
+        discard_page (self, showing_page);
       else
         gtk_widget_set_child_visible (GTK_WIDGET (showing_page), FALSE);
     } else {
@@ -1216,9 +1362,68 @@ remove_page (AdapNavigationView *self,
   if (tag)
     g_hash_table_remove (self->tag_mapping, tag);
 
+  unretain_page (self, page);
+  clear_transition_image (page);
+
   gtk_widget_unparent (GTK_WIDGET (page));
 }
 
+static gboolean
+preload_cb (AdapNavigationView *self)
+{
+  AdapNavigationPage *page = g_queue_pop_head (&self->preload_queue);
+
+  /* Measuring resolves the page's style and fills its size request cache, so
+   * the first frame of the push transition doesn't have to */
+  if (gtk_widget_get_parent (GTK_WIDGET (page)) == GTK_WIDGET (self)) {
+    int width = gtk_widget_get_width (GTK_WIDGET (self));
+    int min_width;
+
+    gtk_widget_measure (GTK_WIDGET (page), GTK_ORIENTATION_HORIZONTAL, -1,
+                        &min_width, NULL, NULL, NULL);
+    gtk_widget_measure (GTK_WIDGET (page), GTK_ORIENTATION_VERTICAL,
+                        MAX (width, min_width), NULL, NULL, NULL, NULL);
+  }
+
+  g_object_unref (page);
+
+  if (!g_queue_is_empty (&self->preload_queue))
+    return G_SOURCE_CONTINUE;
+
+  self->preload_idle_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+preload_page (AdapNavigationView *self,
+              AdapNavigationPage *page)
+{
+  /* Pages that aren't on the stack are kept until they are pushed. They have
+   * their own limit, so that preloading neither evicts popped pages nor is
+   * undone by a low max-retained-pages */
+  if (get_remove_on_pop (page) &&
+      !g_list_store_find (self->navigation_stack, page, NULL)) {
+    unretain_page (self, page);
+    g_queue_push_head (&self->preloaded_pages, page);
+
+    while (self->preloaded_pages.length > MAX_PRELOADED_PAGES)
+      adap_navigation_view_remove (self, g_queue_pop_tail (&self->preloaded_pages));
+  }
+
+  if (g_queue_find (&self->preload_queue, page))
+    return;
+
+  g_queue_push_tail (&self->preload_queue, g_object_ref (page));
+
+  if (self->preload_idle_id)
+    return;
+
+  self->preload_idle_id =
+    g_idle_add_full (G_PRIORITY_LOW, G_SOURCE_FUNC (preload_cb), self, NULL);
+  g_source_set_name_by_id (self->preload_idle_id, "[adap] preload_cb");
+}
+
 static void
 prepare_cb (AdapSwipeTracker        *tracker,
             AdapNavigationDirection  direction,
@@ -1246,6 +1451,8 @@ prepare_cb (AdapSwipeTracker        *tracker,
     if (!new_page || !maybe_add_page (self, new_page))
       return;
 
+    unretain_page (self, new_page);
+
     remove_on_pop = get_remove_on_pop (new_page);
     set_remove_on_pop (new_page, FALSE);
   }
@@ -1493,6 +1700,46 @@ adap_navigation_view_size_allocate (GtkWidget *widget,
   }
 }
 
+static void
+snapshot_transition_page (AdapNavigationView *self,
+                          AdapNavigationPage *page,
+                          GtkSnapshot        *snapshot)
+{
+  AdapNavigationPagePrivate *priv = adap_navigation_page_get_instance_private (page);
+  gboolean cache;
+
+  cache = self->transition_cache == ADAP_NAVIGATION_TRANSITION_CACHE_ALL ||
+          (self->transition_cache == ADAP_NAVIGATION_TRANSITION_CACHE_HIDING &&
+           page == self->hiding_page);
+
+  if (cache && !priv->transition_image && !priv->transition_image_invalid) {
+    priv->transition_paintable = gtk_widget_paintable_new (GTK_WIDGET (page));
+    priv->transition_image = gdk_paintable_get_current_image (priv->transition_paintable);
+
+    g_signal_connect_swapped (priv->transition_paintable, "invalidate-contents",
+                              G_CALLBACK (transition_image_invalidated_cb), page);
+  }
+
+  if (priv->transition_image) {
+    graphene_matrix_t transform;
+
+    /* The image is in page coordinates, so draw it where the page is
+     * currently allocated, same as gtk_widget_snapshot_child() would */
+    gtk_snapshot_save (snapshot);
+
+    if (gtk_widget_compute_transform (GTK_WIDGET (page), GTK_WIDGET (self), &transform))
+      gtk_snapshot_transform_matrix (snapshot, &transform);
+
+    gdk_paintable_snapshot (priv->transition_image, snapshot,
+                            gtk_widget_get_width (GTK_WIDGET (page)),
+                            gtk_widget_get_height (GTK_WIDGET (page)));
+
+    gtk_snapshot_restore (snapshot);
+  } else {
+    gtk_widget_snapshot_child (GTK_WIDGET (self), GTK_WIDGET (page), snapshot);
+  }
+}
+
 static void
 adap_navigation_view_snapshot (GtkWidget   *widget,
                               GtkSnapshot *snapshot)
@@ -1545,7 +1792,7 @@ adap_navigation_view_snapshot (GtkWidget   *widget,
 
   if (static_page) {
     gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (clip_x, 0, clip_width, height));
-    gtk_widget_snapshot_child (widget, static_page, snapshot);
+    snapshot_transition_page (self, ADAP_NAVIGATION_PAGE (static_page), snapshot);
     gtk_snapshot_pop (snapshot);
   }
 
@@ -1558,7 +1805,7 @@ adap_navigation_view_snapshot (GtkWidget   *widget,
 
   if (moving_page) {
     gtk_snapshot_push_clip (snapshot, &GRAPHENE_RECT_INIT (clip_x, 0, clip_width, height));
-    gtk_widget_snapshot_child (widget, moving_page, snapshot);
+    snapshot_transition_page (self, ADAP_NAVIGATION_PAGE (moving_page), snapshot);
     gtk_snapshot_pop (snapshot);
   }
 
@@ -1617,6 +1864,11 @@ adap_navigation_view_dispose (GObject *object)
 
   g_clear_pointer (&self->shield, gtk_widget_unparent);
 
+  g_clear_handle_id (&self->preload_idle_id, g_source_remove);
+  g_queue_clear_full (&self->preload_queue, g_object_unref);
+  g_queue_clear (&self->retained_pages);
+  g_queue_clear (&self->preloaded_pages);
+
   while ((child = gtk_widget_get_first_child (GTK_WIDGET (self))))
     gtk_widget_unparent (child);
 
@@ -1660,6 +1912,12 @@ adap_navigation_view_get_property (GObject    *object,
   case PROP_NAVIGATION_STACK:
     g_value_take_object (value, adap_navigation_view_get_navigation_stack (self));
     break;
+  case PROP_TRANSITION_CACHE:
+    g_value_set_enum (value, adap_navigation_view_get_transition_cache (self));
+    break;
+  case PROP_MAX_RETAINED_PAGES:
+    g_value_set_uint (value, adap_navigation_view_get_max_retained_pages (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1680,6 +1938,12 @@ adap_navigation_view_set_property (GObject      *object,
   case PROP_POP_ON_ESCAPE:
     adap_navigation_view_set_pop_on_escape (self, g_value_get_boolean (value));
     break;
+  case PROP_TRANSITION_CACHE:
+    adap_navigation_view_set_transition_cache (self, g_value_get_enum (value));
+    break;
+  case PROP_MAX_RETAINED_PAGES:
+    adap_navigation_view_set_max_retained_pages (self, g_value_get_uint (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -1775,6 +2039,43 @@ adap_navigation_view_class_init (AdapNavigationViewClass *klass)
                          G_TYPE_LIST_MODEL,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdapNavigationView:transition-cache: (attributes org.gtk.Property.get=adap_navigation_view_get_transition_cache org.gtk.Property.set=adap_navigation_view_set_transition_cache)
+   *
+   * Which pages to draw only once during transitions.
+   *
+   * Cached pages are drawn when the transition starts, and that image is
+   * moved instead of redrawing the page every frame. If a cached page changes
+   * during the transition, it's drawn live again until the transition ends.
+   *
+   * Since: 1.6
+   */
+  props[PROP_TRANSITION_CACHE] =
+    g_param_spec_enum ("transition-cache", NULL, NULL,
+                       ADAP_TYPE_NAVIGATION_TRANSITION_CACHE,
+                       ADAP_NAVIGATION_TRANSITION_CACHE_NONE,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdapNavigationView:max-retained-pages: (attributes org.gtk.Property.get=adap_navigation_view_get_max_retained_pages org.gtk.Property.set=adap_navigation_view_set_max_retained_pages)
+   *
+   * The maximum number of popped pages to keep.
+   *
+   * Pages that haven't been added with [method@NavigationView.add] are
+   * normally removed once they are popped. Up to this many of them are kept
+   * instead, dropping the least recently popped ones first. Kept pages can
+   * still be found with [method@NavigationView.find_page] and pushed again.
+   *
+   * Pages preloaded with [method@NavigationView.preload] don't count towards
+   * this limit, see that method.
+   *
+   * Since: 1.6
+   */
+  props[PROP_MAX_RETAINED_PAGES] =
+    g_param_spec_uint ("max-retained-pages", NULL, NULL,
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   /**
@@ -1915,6 +2216,10 @@ adap_navigation_view_init (AdapNavigationView *self)
 
   self->navigation_stack = g_list_store_new (ADAP_TYPE_NAVIGATION_PAGE);
 
+  g_queue_init (&self->retained_pages);
+  g_queue_init (&self->preloaded_pages);
+  g_queue_init (&self->preload_queue);
+
   self->tag_mapping = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 
   target = adap_callback_animation_target_new ((AdapAnimationTargetFunc) transition_cb,
@@ -2364,6 +2669,18 @@ adap_navigation_page_get_child_view (AdapNavigationPage *self)
   return priv->child_view;
 }
 
+GdkPaintable *
+adap_navigation_page_get_transition_image (AdapNavigationPage *self)
+{
+  AdapNavigationPagePrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_NAVIGATION_PAGE (self), NULL);
+
+  priv = adap_navigation_page_get_instance_private (self);
+
+  return priv->transition_image;
+}
+
 void
 adap_navigation_page_showing (AdapNavigationPage *self)
 {
@@ -2491,7 +2808,8 @@ adap_navigation_view_add (AdapNavigationView *self,
 
   if (get_remove_on_pop (page) &&
       gtk_widget_get_parent (GTK_WIDGET (page)) == GTK_WIDGET (self) &&
-      g_list_store_find (self->navigation_stack, page, NULL)) {
+      (g_list_store_find (self->navigation_stack, page, NULL) ||
+       unretain_page (self, page))) {
     set_remove_on_pop (page, FALSE);
     return;
   }
@@ -2612,6 +2930,73 @@ adap_navigation_view_push_by_tag (AdapNavigationView *self,
   push_to_stack (self, page, self->animate_transitions, 0, TRUE);
 }
 
+/**
+ * adap_navigation_view_preload:
+ * @self: a navigation view
+ * @page: the page to preload
+ *
+ * Prepares @page to be pushed onto the navigation stack.
+ *
+ * If @page hasn't been added to @self, it's added the same way as with
+ * [method@NavigationView.push], without pushing it. It's kept until it's
+ * pushed, regardless of [property@NavigationView:max-retained-pages]. Only a
+ * few pages are kept this way, so preloading more of them removes the least
+ * recently preloaded ones.
+ *
+ * The style and size of @page are computed in idle time, so that a later push
+ * transition starts with a page that is ready to be drawn.
+ *
+ * See [method@NavigationView.preload_tag].
+ *
+ * Since: 1.6
+ */
+void
+adap_navigation_view_preload (AdapNavigationView *self,
+                              AdapNavigationPage *page)
+{
+  g_return_if_fail (ADAP_IS_NAVIGATION_VIEW (self));
+  g_return_if_fail (ADAP_IS_NAVIGATION_PAGE (page));
+
+  if (!maybe_add_page (self, page))
+    return;
+
+  preload_page (self, page);
+}
+
+/**
+ * adap_navigation_view_preload_tag:
+ * @self: a navigation view
+ * @tag: the page tag
+ *
+ * Prepares the page with the tag @tag to be pushed onto the navigation stack.
+ *
+ * The page must have been added to @self, or retained after being popped, see
+ * [property@NavigationView:max-retained-pages].
+ *
+ * See [method@NavigationView.preload] and [property@NavigationPage:tag].
+ *
+ * Since: 1.6
+ */
+void
+adap_navigation_view_preload_tag (AdapNavigationView *self,
+                                  const char         *tag)
+{
+  AdapNavigationPage *page;
+
+  g_return_if_fail (ADAP_IS_NAVIGATION_VIEW (self));
+  g_return_if_fail (tag != NULL);
+
+  page = adap_navigation_view_find_page (self, tag);
+
+  if (page == NULL) {
+    g_critical ("No page with the tag '%s' found in AdapNavigationView %p",
+                tag, self);
+    return;
+  }
+
+  preload_page (self, page);
+}
+
 /**
  * adap_navigation_view_pop:
  * @self: a navigation view
@@ -2754,7 +3139,8 @@ adap_navigation_view_pop_to_tag (AdapNavigationView *self,
  * Replacing the navigation stack has no animation.
  *
  * If [method@NavigationView.add] hasn't been called for any pages that are no
- * longer in the navigation stack, they are automatically removed.
+ * longer in the navigation stack, they are removed the same way as popped
+ * pages, see [property@NavigationView:max-retained-pages].
  *
  * @n_pages can be 0, in that case no page will be visible after calling this
  * method. This can be useful for removing all pages from @self.
@@ -2772,6 +3158,7 @@ adap_navigation_view_replace (AdapNavigationView  *self,
 {
   AdapNavigationPage *visible_page, *old_visible_page;
   GHashTable *added_pages;
+  GSList *dropped = NULL, *l;
   guint i, old_length;
 
   g_return_if_fail (ADAP_IS_NAVIGATION_VIEW (self));
@@ -2804,7 +3191,10 @@ adap_navigation_view_replace (AdapNavigationView  *self,
         visible_page = NULL;
       }
 
-      remove_page (self, c, FALSE);
+      if (c == self->hiding_page)
+        adap_animation_skip (self->transition);
+
+      dropped = g_slist_prepend (dropped, g_object_ref (c));
     }
 
     g_object_unref (c);
@@ -2813,6 +3203,24 @@ adap_navigation_view_replace (AdapNavigationView  *self,
   g_list_store_remove_all (self->navigation_stack);
   g_hash_table_remove_all (added_pages);
 
+  /* Dropped pages are removed or retained the same way as popped ones.
+   * Retained pages that are about to be pushed again are taken out of the
+   * queue first, so that retaining the dropped ones can't evict them */
+  for (i = 0; i < n_pages; i++) {
+    if (pages[i])
+      unretain_page (self, pages[i]);
+  }
+
+  for (l = dropped; l; l = l->next) {
+    AdapNavigationPage *c = l->data;
+
+    /* Skipping the transition above may have discarded it already */
+    if (gtk_widget_get_parent (GTK_WIDGET (c)) == GTK_WIDGET (self))
+      discard_page (self, c);
+  }
+
+  g_slist_free_full (dropped, g_object_unref);
+
   for (i = 0; i < n_pages; i++) {
     if (!pages[i])
       continue;
@@ -2826,6 +3234,7 @@ adap_navigation_view_replace (AdapNavigationView  *self,
     if (!maybe_add_page (self, pages[i]))
       continue;
 
+    unretain_page (self, pages[i]);
     g_hash_table_insert (added_pages, pages[i], NULL);
     g_list_store_append (self->navigation_stack, pages[i]);
   }
@@ -2870,7 +3279,8 @@ adap_navigation_view_replace (AdapNavigationView  *self,
  * Replacing the navigation stack has no animation.
  *
  * If [method@NavigationView.add] hasn't been called for any pages that are no
- * longer in the navigation stack, they are automatically removed.
+ * longer in the navigation stack, they are removed the same way as popped
+ * pages, see [property@NavigationView:max-retained-pages].
  *
  * @n_tags can be 0, in that case no page will be visible after calling this
  * method. This can be useful for removing all pages from @self.
@@ -3072,6 +3482,109 @@ adap_navigation_view_set_pop_on_escape (AdapNavigationView *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_POP_ON_ESCAPE]);
 }
 
+/**
+ * adap_navigation_view_get_transition_cache: (attributes org.gtk.Method.get_property=transition-cache)
+ * @self: a navigation view
+ *
+ * Gets which pages are drawn only once during transitions.
+ *
+ * Returns: the transition cache mode
+ *
+ * Since: 1.6
+ */
+AdapNavigationTransitionCache
+adap_navigation_view_get_transition_cache (AdapNavigationView *self)
+{
+  g_return_val_if_fail (ADAP_IS_NAVIGATION_VIEW (self), ADAP_NAVIGATION_TRANSITION_CACHE_NONE);
+
+  return self->transition_cache;
+}
+
+/**
+ * adap_navigation_view_set_transition_cache: (attributes org.gtk.Method.set_property=transition-cache)
+ * @self: a navigation view
+ * @cache: the new transition cache mode
+ *
+ * Sets which pages are drawn only once during transitions.
+ *
+ * Cached pages are drawn when the transition starts, and that image is moved
+ * instead of redrawing the page every frame. If a cached page changes during
+ * the transition, it's drawn live again until the transition ends.
+ *
+ * This can make transitions smoother for pages that are expensive to draw,
+ * as long as they don't change while the transition is running.
+ *
+ * Since: 1.6
+ */
+void
+adap_navigation_view_set_transition_cache (AdapNavigationView            *self,
+                                           AdapNavigationTransitionCache  cache)
+{
+  g_return_if_fail (ADAP_IS_NAVIGATION_VIEW (self));
+  g_return_if_fail (cache <= ADAP_NAVIGATION_TRANSITION_CACHE_ALL);
+
+  if (cache == self->transition_cache)
+    return;
+
+  self->transition_cache = cache;
+
+  clear_transition_cache (self);
+  gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_TRANSITION_CACHE]);
+}
+
+/**
+ * adap_navigation_view_get_max_retained_pages: (attributes org.gtk.Method.get_property=max-retained-pages)
+ * @self: a navigation view
+ *
+ * Gets the maximum number of popped pages to keep.
+ *
+ * Returns: the maximum number of popped pages to keep
+ *
+ * Since: 1.6
+ */
+guint
+adap_navigation_view_get_max_retained_pages (AdapNavigationView *self)
+{
+  g_return_val_if_fail (ADAP_IS_NAVIGATION_VIEW (self), 0);
+
+  return self->max_retained_pages;
+}
+
+/**
+ * adap_navigation_view_set_max_retained_pages: (attributes org.gtk.Method.set_property=max-retained-pages)
+ * @self: a navigation view
+ * @max_retained_pages: the maximum number of popped pages to keep
+ *
+ * Sets the maximum number of popped pages to keep.
+ *
+ * Pages that haven't been added with [method@NavigationView.add] are normally
+ * removed once they are popped. Up to @max_retained_pages of them are kept
+ * instead, dropping the least recently popped ones first. Kept pages can still
+ * be found with [method@NavigationView.find_page] and pushed again.
+ *
+ * Pages preloaded with [method@NavigationView.preload] don't count towards
+ * this limit, see that method.
+ *
+ * Since: 1.6
+ */
+void
+adap_navigation_view_set_max_retained_pages (AdapNavigationView *self,
+                                             guint               max_retained_pages)
+{
+  g_return_if_fail (ADAP_IS_NAVIGATION_VIEW (self));
+
+  if (max_retained_pages == self->max_retained_pages)
+    return;
+
+  self->max_retained_pages = max_retained_pages;
+
+  trim_retained_pages (self, self->max_retained_pages);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MAX_RETAINED_PAGES]);
+}
+
 /**
  * adap_navigation_view_get_navigation_stack: (attributes org.gtk.Method.get_property=navigation-stack)
  * @self: a navigation view
@@ -15,6 +15,7 @@
 #include "adap-version.h"
 
 #include <gtk/gtk.h>
+#include "adap-enums.h"
 
 G_BEGIN_DECLS
 
@@ -108,6 +109,12 @@ ADAP_AVAILABLE_IN_1_4
 void     adap_navigation_page_set_can_pop (AdapNavigationPage *self,
                                           gboolean           can_pop);
 
+typedef enum {
+  ADAP_NAVIGATION_TRANSITION_CACHE_NONE,
+  ADAP_NAVIGATION_TRANSITION_CACHE_HIDING,
+  ADAP_NAVIGATION_TRANSITION_CACHE_ALL,
+} AdapNavigationTransitionCache;
+
 #define ADAP_TYPE_NAVIGATION_VIEW (adap_navigation_view_get_type())
 
 ADAP_AVAILABLE_IN_1_4
@@ -136,6 +143,14 @@ ADAP_AVAILABLE_IN_1_4
 void adap_navigation_view_push_by_tag (AdapNavigationView *self,
                                       const char        *tag);
 
+ADAP_AVAILABLE_IN_1_6
+void adap_navigation_view_preload (AdapNavigationView *self,
+                                   AdapNavigationPage *page);
+
+ADAP_AVAILABLE_IN_1_6
+void adap_navigation_view_preload_tag (AdapNavigationView *self,
+                                       const char         *tag);
+
 ADAP_AVAILABLE_IN_1_4
 gboolean adap_navigation_view_pop (AdapNavigationView *self);
 
@@ -176,6 +191,18 @@ ADAP_AVAILABLE_IN_1_4
 void     adap_navigation_view_set_pop_on_escape (AdapNavigationView *self,
                                                 gboolean           pop_on_escape);
 
+ADAP_AVAILABLE_IN_1_6
+AdapNavigationTransitionCache adap_navigation_view_get_transition_cache (AdapNavigationView            *self);
+ADAP_AVAILABLE_IN_1_6
+void                          adap_navigation_view_set_transition_cache (AdapNavigationView            *self,
+                                                                         AdapNavigationTransitionCache  cache);
+
+ADAP_AVAILABLE_IN_1_6
+guint adap_navigation_view_get_max_retained_pages (AdapNavigationView *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_navigation_view_set_max_retained_pages (AdapNavigationView *self,
+                                                   guint               max_retained_pages);
+
 ADAP_AVAILABLE_IN_1_4
 GListModel *adap_navigation_view_get_navigation_stack (AdapNavigationView *self);
 
@@ -16,6 +16,8 @@
 #include "adap-navigation-view.h"
 #include "adap-preferences-group-private.h"
 #include "adap-preferences-page-private.h"
+#include "adap-preferences-row-descriptor-private.h"
+#include "adap-preferences-row-private.h"
 #include "adap-toast-overlay.h"
 #include "adap-view-stack.h"
 #include "adap-widget-utils-private.h"
@@ -59,7 +61,7 @@ typedef struct
   AdapViewStack *pages_stack;
   GtkToggleButton *search_button;
   GtkSearchEntry *search_entry;
-  GtkListBox *search_results;
+  GtkListView *search_results;
   GtkStack *search_stack;
   GtkStack *title_stack;
   GtkWidget *view_switcher_stack;
@@ -68,9 +70,15 @@ typedef struct
   AdapBreakpoint *breakpoint;
 
   gboolean search_enabled;
+  char *search_terms;
+  char **search_tokens;
+  GHashTable *search_scores;
+  GHashTable *search_subtitles;
 
   GtkFilter *filter;
   GtkFilterListModel *filter_model;
+  GtkSorter *sorter;
+  GtkSortListModel *sort_model;
 
   int n_pages;
 } AdapPreferencesDialogPrivate;
@@ -94,107 +102,74 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
-/* Copied and modified from gtklabel.c, separate_uline_pattern() */
-static char *
-strip_mnemonic (const char *src)
+/* Items are either rows or, for pages that haven't been built yet, row
+ * descriptors. Scores are cached until the search changes, so that sorting
+ * doesn't recompute them for every comparison */
+static int
+get_search_score (AdapPreferencesDialog *self,
+                  GObject               *item)
 {
-  char *new_str = g_new (char, strlen (src) + 1);
-  char *dest = new_str;
-  gboolean underscore = FALSE;
-
-  while (*src) {
-    gunichar c;
-    const char *next_src;
-
-    c = g_utf8_get_char (src);
-    if (c == (gunichar) -1) {
-      g_warning ("Invalid input string");
-
-      g_free (new_str);
-
-      return NULL;
-    }
+  AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
+  const char * const *tokens;
+  gpointer cached;
+  int score;
 
-    next_src = g_utf8_next_char (src);
-
-    if (underscore) {
-      while (src < next_src)
-        *dest++ = *src++;
-
-      underscore = FALSE;
-    } else {
-      if (c == '_'){
-        underscore = TRUE;
-        src = next_src;
-      } else {
-        while (src < next_src)
-          *dest++ = *src++;
-      }
-    }
-  }
+  if (!priv->search_tokens)
+    return 1;
 
-  *dest = 0;
+  if (g_hash_table_lookup_extended (priv->search_scores, item, NULL, &cached))
+    return GPOINTER_TO_INT (cached);
 
-  return new_str;
-}
+  tokens = (const char * const *) priv->search_tokens;
 
-static char *
-make_comparable (const char        *src,
-                 AdapPreferencesRow *row,
-                 gboolean           allow_underline)
-{
-  char *plaintext = g_utf8_casefold (src, -1);
-  GError *error = NULL;
-
-  if (adap_preferences_row_get_use_markup (row)) {
-    char *parsed = NULL;
-
-    if (pango_parse_markup (plaintext, -1, 0, NULL, &parsed, NULL, &error)) {
-      g_free (plaintext);
-      plaintext = parsed;
-    } else {
-      g_critical ("Couldn't parse markup: %s", error->message);
-      g_clear_error (&error);
-    }
-  }
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item))
+    score = adap_preferences_row_descriptor_get_search_score (ADAP_PREFERENCES_ROW_DESCRIPTOR (item), tokens);
+  else
+    score = adap_preferences_row_get_search_score (ADAP_PREFERENCES_ROW (item), tokens);
 
-  if (allow_underline && adap_preferences_row_get_use_underline (row)) {
-    char *comparable = strip_mnemonic (plaintext);
-    g_free (plaintext);
-    return comparable;
-  }
+  g_hash_table_insert (priv->search_scores, item, GINT_TO_POINTER (score));
 
-  return plaintext;
+  return score;
 }
 
 static gboolean
-filter_search_results (AdapPreferencesRow    *row,
+filter_search_results (GObject               *item,
                        AdapPreferencesDialog *self)
 {
-  AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
-  char *terms, *title;
-  gboolean result = FALSE;
+  g_assert (ADAP_IS_PREFERENCES_ROW (item) || ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item));
+
+  return get_search_score (self, item) > 0;
+}
 
-  g_assert (ADAP_IS_PREFERENCES_ROW (row));
+static int
+compare_search_results (GObject               *item1,
+                        GObject               *item2,
+                        AdapPreferencesDialog *self)
+{
+  int score1 = get_search_score (self, item1);
+  int score2 = get_search_score (self, item2);
 
-  terms = g_utf8_casefold (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)), -1);
-  title = make_comparable (adap_preferences_row_get_title (row), row, TRUE);
+  /* The sort is stable, so equal rows stay in the page order */
+  if (score1 > score2)
+    return GTK_ORDERING_SMALLER;
 
-  if (!!strstr (title, terms)) {
-    result = TRUE;
-  } else if (ADAP_IS_ACTION_ROW (row)) {
-    char *subtitle = make_comparable (adap_action_row_get_subtitle (ADAP_ACTION_ROW(row)), row, FALSE);
+  if (score1 < score2)
+    return GTK_ORDERING_LARGER;
 
-    if (!!strstr (subtitle, terms))
-      result = TRUE;
+  return GTK_ORDERING_EQUAL;
+}
 
-    g_free (subtitle);
-  }
+static void
+search_rows_changed_cb (AdapPreferencesDialog *self)
+{
+  AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
 
-  g_free (title);
-  g_free (terms);
+  /* A new row could reuse the address of a removed one */
+  if (priv->search_scores)
+    g_hash_table_remove_all (priv->search_scores);
 
-  return result;
+  if (priv->search_subtitles)
+    g_hash_table_remove_all (priv->search_subtitles);
 }
 
 static int
@@ -218,13 +193,20 @@ get_n_pages (AdapPreferencesDialog *self)
 
 static char *
 create_search_row_subtitle (AdapPreferencesDialog *self,
-                            AdapPreferencesRow    *row)
+                            GObject               *item)
 {
-  GtkWidget *group, *page;
+  GtkWidget *group = NULL, *page;
   const char *group_title = NULL;
   char *page_title = NULL;
+  gboolean use_markup = FALSE;
 
-  group = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_GROUP);
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    page = GTK_WIDGET (adap_preferences_row_descriptor_get_page (ADAP_PREFERENCES_ROW_DESCRIPTOR (item)));
+  } else {
+    use_markup = adap_preferences_row_get_use_markup (ADAP_PREFERENCES_ROW (item));
+    group = gtk_widget_get_ancestor (GTK_WIDGET (item), ADAP_TYPE_PREFERENCES_GROUP);
+    page = group ? gtk_widget_get_ancestor (group, ADAP_TYPE_PREFERENCES_PAGE) : NULL;
+  }
 
   if (group) {
     group_title = adap_preferences_group_get_title (ADAP_PREFERENCES_GROUP (group));
@@ -233,17 +215,15 @@ create_search_row_subtitle (AdapPreferencesDialog *self,
       group_title = NULL;
   }
 
-  page = gtk_widget_get_ancestor (group, ADAP_TYPE_PREFERENCES_PAGE);
-
   if (page) {
     const char *title = adap_preferences_page_get_title (ADAP_PREFERENCES_PAGE (page));
 
     if (adap_preferences_page_get_use_underline (ADAP_PREFERENCES_PAGE (page)))
-      page_title = strip_mnemonic (title);
+      page_title = adap_preferences_row_strip_mnemonic (title);
     else
       page_title = g_strdup (title);
 
-    if (adap_preferences_row_get_use_markup (row)) {
+    if (use_markup) {
       char *tmp = page_title;
 
       page_title = g_markup_escape_text (page_title, -1);
@@ -271,73 +251,116 @@ create_search_row_subtitle (AdapPreferencesDialog *self,
   return page_title;
 }
 
-static GtkWidget *
-new_search_row_for_preference (AdapPreferencesRow    *row,
-                               AdapPreferencesDialog *self)
+static const char *
+get_search_row_subtitle (AdapPreferencesDialog *self,
+                         GObject               *item)
 {
-  AdapActionRow *widget;
-  GtkWidget *page;
+  AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
   char *subtitle;
 
-  g_assert (ADAP_IS_PREFERENCES_ROW (row));
+  if (g_hash_table_lookup_extended (priv->search_subtitles, item, NULL, (gpointer *) &subtitle))
+    return subtitle;
+
+  subtitle = create_search_row_subtitle (self, item);
+
+  g_hash_table_insert (priv->search_subtitles, item, subtitle);
+
+  return subtitle;
+}
+
+static void
+search_result_setup_cb (AdapPreferencesDialog *self,
+                        GtkListItem           *list_item)
+{
+  GtkWidget *widget = adap_action_row_new ();
 
-  subtitle = create_search_row_subtitle (self, row);
-  page = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_PAGE);
+  /* The list item handles focus and activation */
+  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (widget), FALSE);
+  gtk_widget_set_focusable (widget, FALSE);
 
-  widget = ADAP_ACTION_ROW (adap_action_row_new ());
-  gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (widget), TRUE);
-  adap_preferences_row_set_use_markup (ADAP_PREFERENCES_ROW (widget),
-                                      adap_preferences_row_get_use_markup (row));
-  adap_preferences_row_set_use_underline (ADAP_PREFERENCES_ROW (widget),
-                                         adap_preferences_row_get_use_underline (row));
-  adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (widget),
-                                 adap_preferences_row_get_title (row));
-  adap_action_row_set_subtitle (widget, subtitle);
+  gtk_list_item_set_child (list_item, widget);
+}
 
-  g_object_set_data (G_OBJECT (widget), "page", page);
-  g_object_set_data (G_OBJECT (widget), "row", row);
+static void
+search_result_bind_cb (AdapPreferencesDialog *self,
+                       GtkListItem           *list_item)
+{
+  GObject *item = gtk_list_item_get_item (list_item);
+  AdapPreferencesRow *widget = ADAP_PREFERENCES_ROW (gtk_list_item_get_child (list_item));
+
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    AdapPreferencesRowDescriptor *descriptor = ADAP_PREFERENCES_ROW_DESCRIPTOR (item);
+
+    adap_preferences_row_set_use_markup (widget, FALSE);
+    adap_preferences_row_set_use_underline (widget, FALSE);
+    adap_preferences_row_set_title (widget, adap_preferences_row_descriptor_get_title (descriptor));
+  } else {
+    AdapPreferencesRow *row = ADAP_PREFERENCES_ROW (item);
 
-  g_clear_pointer (&subtitle, g_free);
+    adap_preferences_row_set_use_markup (widget, adap_preferences_row_get_use_markup (row));
+    adap_preferences_row_set_use_underline (widget, adap_preferences_row_get_use_underline (row));
+    adap_preferences_row_set_title (widget, adap_preferences_row_get_title (row));
+  }
 
-  return GTK_WIDGET (widget);
+  adap_action_row_set_subtitle (ADAP_ACTION_ROW (widget),
+                               get_search_row_subtitle (self, item));
 }
 
 static void
 search_result_activated_cb (AdapPreferencesDialog *self,
-                            AdapActionRow         *widget)
+                            guint                  position)
 {
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
-  AdapPreferencesPage *page;
   AdapPreferencesRow *row;
+  GObject *item;
+  GtkWidget *page;
   GtkRoot *root;
 
-  gtk_toggle_button_set_active (priv->search_button, FALSE);
-  page = ADAP_PREFERENCES_PAGE (g_object_get_data (G_OBJECT (widget), "page"));
-  row = ADAP_PREFERENCES_ROW (g_object_get_data (G_OBJECT (widget), "row"));
+  item = g_list_model_get_item (G_LIST_MODEL (priv->sort_model), position);
+
+  g_assert (item != NULL);
+
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    AdapPreferencesRowDescriptor *descriptor = ADAP_PREFERENCES_ROW_DESCRIPTOR (item);
+
+    page = GTK_WIDGET (adap_preferences_row_descriptor_get_page (descriptor));
+    row = adap_preferences_page_find_row (ADAP_PREFERENCES_PAGE (page),
+                                          adap_preferences_row_descriptor_get_title (descriptor));
+  } else {
+    row = ADAP_PREFERENCES_ROW (item);
+    page = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_PAGE);
+  }
 
   g_assert (page != NULL);
-  g_assert (row != NULL);
+
+  gtk_toggle_button_set_active (priv->search_button, FALSE);
 
   root = gtk_widget_get_root (GTK_WIDGET (self));
 
-  adap_view_stack_set_visible_child (priv->pages_stack, GTK_WIDGET (page));
-  gtk_widget_set_can_focus (GTK_WIDGET (row), TRUE);
-  gtk_widget_grab_focus (GTK_WIDGET (row));
+  adap_view_stack_set_visible_child (priv->pages_stack, page);
+
+  if (row) {
+    gtk_widget_set_can_focus (GTK_WIDGET (row), TRUE);
+    gtk_widget_grab_focus (GTK_WIDGET (row));
+
+    if (GTK_IS_WINDOW (root))
+      gtk_window_set_focus_visible (GTK_WINDOW (root), TRUE);
+  }
 
-  if (GTK_IS_WINDOW (root))
-    gtk_window_set_focus_visible (GTK_WINDOW (root), TRUE);
+  g_object_unref (item);
 }
 
 static void
 search_results_map (AdapPreferencesDialog *self)
 {
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
+  GtkSelectionModel *selection;
 
-  gtk_list_box_bind_model (priv->search_results,
-                           G_LIST_MODEL (priv->filter_model),
-                           (GtkListBoxCreateWidgetFunc) new_search_row_for_preference,
-                           self,
-                           NULL);
+  selection = GTK_SELECTION_MODEL (gtk_no_selection_new (g_object_ref (G_LIST_MODEL (priv->sort_model))));
+
+  gtk_list_view_set_model (priv->search_results, selection);
+
+  g_object_unref (selection);
 }
 
 static void
@@ -345,7 +368,11 @@ search_results_unmap (AdapPreferencesDialog *self)
 {
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
 
-  gtk_list_box_bind_model (priv->search_results, NULL, NULL, NULL, NULL);
+  gtk_list_view_set_model (priv->search_results, NULL);
+
+  /* Page and group titles may change before the next search */
+  if (priv->search_subtitles)
+    g_hash_table_remove_all (priv->search_subtitles);
 }
 
 static void
@@ -445,12 +472,39 @@ static void
 search_changed_cb (AdapPreferencesDialog *self)
 {
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  char *terms;
   guint n;
 
-  gtk_filter_changed (priv->filter, GTK_FILTER_CHANGE_DIFFERENT);
+  /* Casefold the terms once here rather than for every row */
+  terms = g_utf8_casefold (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)), -1);
+
+  if (!g_strcmp0 (terms, priv->search_terms)) {
+    g_free (terms);
+  } else {
+    /* Typing more can only remove results, deleting can only add them */
+    if (priv->search_terms && strstr (terms, priv->search_terms))
+      change = GTK_FILTER_CHANGE_MORE_STRICT;
+    else if (priv->search_terms && strstr (priv->search_terms, terms))
+      change = GTK_FILTER_CHANGE_LESS_STRICT;
+
+    g_free (priv->search_terms);
+    priv->search_terms = terms;
+
+    g_strfreev (priv->search_tokens);
+    priv->search_tokens = adap_preferences_row_tokenize_search (terms);
+    g_hash_table_remove_all (priv->search_scores);
+
+    gtk_filter_changed (priv->filter, change);
+    gtk_sorter_changed (priv->sorter, GTK_SORTER_CHANGE_DIFFERENT);
+  }
 
   n = g_list_model_get_n_items (G_LIST_MODEL (priv->filter_model));
 
+  /* The best matches are at the top */
+  if (n > 0 && gtk_list_view_get_model (priv->search_results))
+    gtk_list_view_scroll_to (priv->search_results, 0, GTK_LIST_SCROLL_NONE, NULL);
+
   gtk_stack_set_visible_child_name (priv->search_stack, n > 0 ? "results" : "no-results");
 }
 
@@ -514,7 +568,12 @@ adap_preferences_dialog_dispose (GObject *object)
   AdapPreferencesDialog *self = ADAP_PREFERENCES_DIALOG (object);
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
 
+  g_clear_object (&priv->sort_model);
   g_clear_object (&priv->filter_model);
+  g_clear_pointer (&priv->search_terms, g_free);
+  g_clear_pointer (&priv->search_tokens, g_strfreev);
+  g_clear_pointer (&priv->search_scores, g_hash_table_unref);
+  g_clear_pointer (&priv->search_subtitles, g_hash_table_unref);
 
   G_OBJECT_CLASS (adap_preferences_dialog_parent_class)->dispose (object);
 }
@@ -631,10 +690,13 @@ static void
 adap_preferences_dialog_init (AdapPreferencesDialog *self)
 {
   AdapPreferencesDialogPrivate *priv = adap_preferences_dialog_get_instance_private (self);
+  GtkListItemFactory *factory;
   GListModel *model;
   GtkExpression *expr;
 
   priv->search_enabled = FALSE;
+  priv->search_scores = g_hash_table_new (NULL, NULL);
+  priv->search_subtitles = g_hash_table_new_full (NULL, NULL, NULL, g_free);
 
   gtk_widget_init_template (GTK_WIDGET (self));
 
@@ -648,8 +710,21 @@ adap_preferences_dialog_init (AdapPreferencesDialog *self)
                                                 NULL,
                                                 NULL));
   model = G_LIST_MODEL (gtk_flatten_list_model_new (model));
+  g_signal_connect_object (model, "items-changed",
+                           G_CALLBACK (search_rows_changed_cb), self,
+                           G_CONNECT_SWAPPED);
   priv->filter_model = gtk_filter_list_model_new (model, priv->filter);
 
+  priv->sorter = GTK_SORTER (gtk_custom_sorter_new ((GCompareDataFunc) compare_search_results, self, NULL));
+  priv->sort_model = gtk_sort_list_model_new (g_object_ref (G_LIST_MODEL (priv->filter_model)),
+                                              priv->sorter);
+
+  factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect_swapped (factory, "setup", G_CALLBACK (search_result_setup_cb), self);
+  g_signal_connect_swapped (factory, "bind", G_CALLBACK (search_result_bind_cb), self);
+  gtk_list_view_set_factory (priv->search_results, factory);
+  g_object_unref (factory);
+
   gtk_widget_set_visible (GTK_WIDGET (priv->search_button), FALSE);
 }
 
@@ -9,6 +9,7 @@
 #include "adap-preferences-group-private.h"
 
 #include "adap-preferences-row.h"
+#include "adap-style-manager-private.h"
 #include "adap-widget-utils-private.h"
 
 /**
@@ -300,6 +301,8 @@ adap_preferences_group_class_init (AdapPreferencesGroupClass *klass)
   gtk_widget_class_bind_template_callback (widget_class, listbox_keynav_failed_cb);
 
   gtk_widget_class_set_css_name (widget_class, "preferencesgroup");
+
+  adap_style_manager_ensure_fragment ("preferences");
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_GROUP);
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
 }
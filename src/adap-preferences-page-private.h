@@ -7,9 +7,18 @@
 #pragma once
 
 #include "adap-preferences-page.h"
+#include "adap-preferences-row.h"
 
 G_BEGIN_DECLS
 
+ADAP_AVAILABLE_IN_ALL
 GListModel *adap_preferences_page_get_rows (AdapPreferencesPage *self) G_GNUC_WARN_UNUSED_RESULT;
 
+ADAP_AVAILABLE_IN_ALL
+void adap_preferences_page_ensure_content (AdapPreferencesPage *self);
+
+ADAP_AVAILABLE_IN_ALL
+AdapPreferencesRow *adap_preferences_page_find_row (AdapPreferencesPage *self,
+                                                    const char          *title);
+
 G_END_DECLS
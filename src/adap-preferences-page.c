@@ -9,6 +9,8 @@
 #include "adap-preferences-page-private.h"
 
 #include "adap-preferences-group-private.h"
+#include "adap-preferences-row-descriptor-private.h"
+#include "adap-style-manager-private.h"
 #include "adap-widget-utils-private.h"
 
 /**
@@ -45,6 +47,14 @@ typedef struct
   char *name;
 
   gboolean use_underline;
+
+  char *content_resource;
+  AdapPreferencesPageContentFunc content_func;
+  gpointer content_func_data;
+  GDestroyNotify content_func_data_destroy;
+  gboolean content_built;
+
+  GListStore *row_descriptors;
 } AdapPreferencesPagePrivate;
 
 static void adap_preferences_page_buildable_init (GtkBuildableIface *iface);
@@ -63,6 +73,7 @@ enum {
   PROP_DESCRIPTION,
   PROP_NAME,
   PROP_USE_UNDERLINE,
+  PROP_CONTENT_RESOURCE,
   LAST_PROP,
 };
 
@@ -100,6 +111,9 @@ adap_preferences_page_get_property (GObject    *object,
   case PROP_USE_UNDERLINE:
     g_value_set_boolean (value, adap_preferences_page_get_use_underline (self));
     break;
+  case PROP_CONTENT_RESOURCE:
+    g_value_set_string (value, adap_preferences_page_get_content_resource (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -129,14 +143,34 @@ adap_preferences_page_set_property (GObject      *object,
   case PROP_USE_UNDERLINE:
     adap_preferences_page_set_use_underline (self, g_value_get_boolean (value));
     break;
+  case PROP_CONTENT_RESOURCE:
+    adap_preferences_page_set_content_resource (self, g_value_get_string (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
 }
 
+static void
+adap_preferences_page_map (GtkWidget *widget)
+{
+  adap_preferences_page_ensure_content (ADAP_PREFERENCES_PAGE (widget));
+
+  GTK_WIDGET_CLASS (adap_preferences_page_parent_class)->map (widget);
+}
+
 static void
 adap_preferences_page_dispose (GObject *object)
 {
+  AdapPreferencesPage *self = ADAP_PREFERENCES_PAGE (object);
+  AdapPreferencesPagePrivate *priv = adap_preferences_page_get_instance_private (self);
+
+  if (priv->content_func_data_destroy)
+    g_clear_pointer (&priv->content_func_data, priv->content_func_data_destroy);
+
+  priv->content_func = NULL;
+  priv->content_func_data_destroy = NULL;
+
   gtk_widget_dispose_template (GTK_WIDGET (object), ADAP_TYPE_PREFERENCES_PAGE);
 
   G_OBJECT_CLASS (adap_preferences_page_parent_class)->dispose (object);
@@ -151,6 +185,8 @@ adap_preferences_page_finalize (GObject *object)
   g_clear_pointer (&priv->icon_name, g_free);
   g_clear_pointer (&priv->title, g_free);
   g_clear_pointer (&priv->name, g_free);
+  g_clear_pointer (&priv->content_resource, g_free);
+  g_clear_object (&priv->row_descriptors);
 
   G_OBJECT_CLASS (adap_preferences_page_parent_class)->finalize (object);
 }
@@ -166,6 +202,7 @@ adap_preferences_page_class_init (AdapPreferencesPageClass *klass)
   object_class->dispose = adap_preferences_page_dispose;
   object_class->finalize = adap_preferences_page_finalize;
 
+  widget_class->map = adap_preferences_page_map;
   widget_class->compute_expand = adap_widget_compute_expand;
   widget_class->focus = adap_widget_focus_child;
 
@@ -221,6 +258,21 @@ adap_preferences_page_class_init (AdapPreferencesPageClass *klass)
                           FALSE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdapPreferencesPage:content-resource: (attributes org.gtk.Property.get=adap_preferences_page_get_content_resource org.gtk.Property.set=adap_preferences_page_set_content_resource)
+   *
+   * A UI resource with the content of the page.
+   *
+   * The resource must contain a template for `AdapPreferencesPage`. Its
+   * children are added to the page the first time it's shown.
+   *
+   * Since: 1.6
+   */
+  props[PROP_CONTENT_RESOURCE] =
+    g_param_spec_string ("content-resource", NULL, NULL,
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_template_from_resource (widget_class,
@@ -230,6 +282,8 @@ adap_preferences_page_class_init (AdapPreferencesPageClass *klass)
   gtk_widget_class_bind_template_child_private (widget_class, AdapPreferencesPage, scrolled_window);
 
   gtk_widget_class_set_css_name (widget_class, "preferencespage");
+
+  adap_style_manager_ensure_fragment ("preferences");
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_GROUP);
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
 }
@@ -240,6 +294,7 @@ adap_preferences_page_init (AdapPreferencesPage *self)
   AdapPreferencesPagePrivate *priv = adap_preferences_page_get_instance_private (self);
 
   priv->title = g_strdup ("");
+  priv->row_descriptors = g_list_store_new (G_TYPE_OBJECT);
 
   gtk_widget_init_template (GTK_WIDGET (self));
 }
@@ -553,6 +608,234 @@ adap_preferences_page_set_use_underline (AdapPreferencesPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_USE_UNDERLINE]);
 }
 
+/**
+ * adap_preferences_page_get_content_resource: (attributes org.gtk.Method.get_property=content-resource)
+ * @self: a preferences page
+ *
+ * Gets the UI resource with the content of @self.
+ *
+ * Returns: (nullable): the content resource path
+ *
+ * Since: 1.6
+ */
+const char *
+adap_preferences_page_get_content_resource (AdapPreferencesPage *self)
+{
+  AdapPreferencesPagePrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_PAGE (self), NULL);
+
+  priv = adap_preferences_page_get_instance_private (self);
+
+  return priv->content_resource;
+}
+
+/**
+ * adap_preferences_page_set_content_resource: (attributes org.gtk.Method.set_property=content-resource)
+ * @self: a preferences page
+ * @resource_path: (nullable): the content resource path
+ *
+ * Sets the UI resource with the content of @self.
+ *
+ * The resource must contain a template for `AdapPreferencesPage`. Its children
+ * are added to @self the first time it's shown.
+ *
+ * Has no effect once the content has been built.
+ *
+ * Since: 1.6
+ */
+void
+adap_preferences_page_set_content_resource (AdapPreferencesPage *self,
+                                            const char          *resource_path)
+{
+  AdapPreferencesPagePrivate *priv;
+
+  g_return_if_fail (ADAP_IS_PREFERENCES_PAGE (self));
+
+  priv = adap_preferences_page_get_instance_private (self);
+
+  if (!g_set_str (&priv->content_resource, resource_path))
+    return;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_CONTENT_RESOURCE]);
+}
+
+/**
+ * adap_preferences_page_set_content_func:
+ * @self: a preferences page
+ * @func: (nullable) (scope notified) (closure user_data) (destroy user_data_destroy): the content function
+ * @user_data: user data to pass to @func
+ * @user_data_destroy: destroy notifier for @user_data
+ *
+ * Sets a function that adds the content of @self.
+ *
+ * @func is called the first time @self is shown, after the groups from
+ * [property@PreferencesPage:content-resource], if any, have been added.
+ *
+ * Has no effect once the content has been built.
+ *
+ * Since: 1.6
+ */
+void
+adap_preferences_page_set_content_func (AdapPreferencesPage            *self,
+                                        AdapPreferencesPageContentFunc  func,
+                                        gpointer                        user_data,
+                                        GDestroyNotify                  user_data_destroy)
+{
+  AdapPreferencesPagePrivate *priv;
+
+  g_return_if_fail (ADAP_IS_PREFERENCES_PAGE (self));
+
+  priv = adap_preferences_page_get_instance_private (self);
+
+  if (priv->content_func_data_destroy)
+    priv->content_func_data_destroy (priv->content_func_data);
+
+  priv->content_func = func;
+  priv->content_func_data = user_data;
+  priv->content_func_data_destroy = user_data_destroy;
+}
+
+/**
+ * adap_preferences_page_add_row_descriptor:
+ * @self: a preferences page
+ * @title: the title of the row
+ * @subtitle: (nullable): the subtitle of the row
+ *
+ * Describes a row that the lazily built content of @self will contain.
+ *
+ * Until the content is built, [class@PreferencesDialog] searches the row
+ * descriptors instead of the rows. Activating one of them builds the content,
+ * shows @self and focuses the first row with the same title.
+ *
+ * @title and @subtitle are plain text.
+ *
+ * Has no effect once the content has been built.
+ *
+ * Since: 1.6
+ */
+void
+adap_preferences_page_add_row_descriptor (AdapPreferencesPage *self,
+                                          const char          *title,
+                                          const char          *subtitle)
+{
+  AdapPreferencesPagePrivate *priv;
+  AdapPreferencesRowDescriptor *descriptor;
+
+  g_return_if_fail (ADAP_IS_PREFERENCES_PAGE (self));
+  g_return_if_fail (title != NULL);
+
+  priv = adap_preferences_page_get_instance_private (self);
+
+  if (priv->content_built)
+    return;
+
+  descriptor = adap_preferences_row_descriptor_new (self, title, subtitle);
+
+  g_list_store_append (priv->row_descriptors, descriptor);
+
+  g_object_unref (descriptor);
+}
+
+/*
+ * adap_preferences_page_ensure_content:
+ * @self: a preferences page
+ *
+ * Builds the lazy content of @self if it hasn't been built yet.
+ */
+void
+adap_preferences_page_ensure_content (AdapPreferencesPage *self)
+{
+  AdapPreferencesPagePrivate *priv;
+
+  g_return_if_fail (ADAP_IS_PREFERENCES_PAGE (self));
+
+  priv = adap_preferences_page_get_instance_private (self);
+
+  if (priv->content_built)
+    return;
+
+  if (!priv->content_resource && !priv->content_func)
+    return;
+
+  priv->content_built = TRUE;
+
+  if (priv->content_resource) {
+    GtkBuilder *builder = gtk_builder_new ();
+    GError *error = NULL;
+    GBytes *bytes;
+
+    bytes = g_resources_lookup_data (priv->content_resource,
+                                     G_RESOURCE_LOOKUP_FLAGS_NONE,
+                                     &error);
+
+    if (bytes) {
+      gsize size;
+      const char *data = g_bytes_get_data (bytes, &size);
+
+      gtk_builder_extend_with_template (builder, G_OBJECT (self),
+                                        ADAP_TYPE_PREFERENCES_PAGE,
+                                        data, size, &error);
+
+      g_bytes_unref (bytes);
+    }
+
+    if (error) {
+      g_critical ("Unable to load content from %s: %s",
+                  priv->content_resource, error->message);
+      g_clear_error (&error);
+    }
+
+    g_object_unref (builder);
+  }
+
+  if (priv->content_func)
+    priv->content_func (self, priv->content_func_data);
+
+  g_list_store_remove_all (priv->row_descriptors);
+}
+
+/*
+ * adap_preferences_page_find_row:
+ * @self: a preferences page
+ * @title: a row title
+ *
+ * Builds the content of @self if needed and finds the first visible row with
+ * the given title.
+ *
+ * Returns: (nullable) (transfer none): the row
+ */
+AdapPreferencesRow *
+adap_preferences_page_find_row (AdapPreferencesPage *self,
+                                const char          *title)
+{
+  AdapPreferencesRow *result = NULL;
+  GListModel *rows;
+  guint i, n;
+
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_PAGE (self), NULL);
+  g_return_val_if_fail (title != NULL, NULL);
+
+  adap_preferences_page_ensure_content (self);
+
+  rows = adap_preferences_page_get_rows (self);
+  n = g_list_model_get_n_items (rows);
+
+  for (i = 0; i < n && !result; i++) {
+    GObject *item = g_list_model_get_item (rows, i);
+
+    if (ADAP_IS_PREFERENCES_ROW (item) &&
+        !g_strcmp0 (adap_preferences_row_get_title (ADAP_PREFERENCES_ROW (item)), title))
+      result = ADAP_PREFERENCES_ROW (item);
+
+    g_object_unref (item);
+  }
+
+  g_object_unref (rows);
+
+  return result;
+}
+
 static GListModel *
 preferences_group_to_rows (AdapPreferencesGroup *group)
 {
@@ -576,6 +859,7 @@ adap_preferences_page_get_rows (AdapPreferencesPage *self)
 {
   AdapPreferencesPagePrivate *priv;
   GListModel *model;
+  GListStore *models;
   GtkCustomFilter *filter;
 
   g_return_val_if_fail (ADAP_IS_PREFERENCES_PAGE (self), NULL);
@@ -591,7 +875,15 @@ adap_preferences_page_get_rows (AdapPreferencesPage *self)
                                                 NULL,
                                                 NULL));
 
-  return G_LIST_MODEL (gtk_flatten_list_model_new (model));
+  /* Row descriptors stand in for the rows until the content is built */
+  model = G_LIST_MODEL (gtk_flatten_list_model_new (model));
+
+  models = g_list_store_new (G_TYPE_LIST_MODEL);
+  g_list_store_append (models, priv->row_descriptors);
+  g_list_store_append (models, model);
+  g_object_unref (model);
+
+  return G_LIST_MODEL (gtk_flatten_list_model_new (G_LIST_MODEL (models)));
 }
 
 /**
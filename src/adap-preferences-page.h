@@ -34,6 +34,20 @@ struct _AdapPreferencesPageClass
   gpointer padding[4];
 };
 
+/**
+ * AdapPreferencesPageContentFunc:
+ * @page: the page
+ * @user_data: user data
+ *
+ * Called to add the content of @page the first time it's shown.
+ *
+ * See [method@PreferencesPage.set_content_func].
+ *
+ * Since: 1.6
+ */
+typedef void (*AdapPreferencesPageContentFunc) (AdapPreferencesPage *page,
+                                                gpointer             user_data);
+
 ADAP_AVAILABLE_IN_ALL
 GtkWidget *adap_preferences_page_new (void) G_GNUC_WARN_UNUSED_RESULT;
 
@@ -77,4 +91,21 @@ void     adap_preferences_page_set_use_underline (AdapPreferencesPage *self,
 ADAP_AVAILABLE_IN_1_3
 void adap_preferences_page_scroll_to_top (AdapPreferencesPage *self);
 
+ADAP_AVAILABLE_IN_1_6
+const char *adap_preferences_page_get_content_resource (AdapPreferencesPage *self);
+ADAP_AVAILABLE_IN_1_6
+void        adap_preferences_page_set_content_resource (AdapPreferencesPage *self,
+                                                        const char          *resource_path);
+
+ADAP_AVAILABLE_IN_1_6
+void adap_preferences_page_set_content_func (AdapPreferencesPage            *self,
+                                             AdapPreferencesPageContentFunc  func,
+                                             gpointer                        user_data,
+                                             GDestroyNotify                  user_data_destroy);
+
+ADAP_AVAILABLE_IN_1_6
+void adap_preferences_page_add_row_descriptor (AdapPreferencesPage *self,
+                                               const char          *title,
+                                               const char          *subtitle);
+
 G_END_DECLS
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADAPTA_INSIDE) && !defined(ADAPTA_COMPILATION)
+#error "Only <adapta.h> can be included directly."
+#endif
+
+#include "adap-preferences-page.h"
+
+G_BEGIN_DECLS
+
+#define ADAP_TYPE_PREFERENCES_ROW_DESCRIPTOR (adap_preferences_row_descriptor_get_type())
+
+G_DECLARE_FINAL_TYPE (AdapPreferencesRowDescriptor, adap_preferences_row_descriptor, ADAP, PREFERENCES_ROW_DESCRIPTOR, GObject)
+
+AdapPreferencesRowDescriptor *adap_preferences_row_descriptor_new (AdapPreferencesPage *page,
+                                                                   const char          *title,
+                                                                   const char          *subtitle) G_GNUC_WARN_UNUSED_RESULT;
+
+AdapPreferencesPage *adap_preferences_row_descriptor_get_page (AdapPreferencesRowDescriptor *self);
+
+ADAP_AVAILABLE_IN_ALL
+const char *adap_preferences_row_descriptor_get_title    (AdapPreferencesRowDescriptor *self);
+const char *adap_preferences_row_descriptor_get_subtitle (AdapPreferencesRowDescriptor *self);
+
+int adap_preferences_row_descriptor_get_search_score (AdapPreferencesRowDescriptor *self,
+                                                      const char * const           *tokens);
+
+G_END_DECLS
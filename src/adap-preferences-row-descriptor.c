@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#include "adap-preferences-row-descriptor-private.h"
+
+#include "adap-preferences-row-private.h"
+
+/* Stands in for a row of a page whose content hasn't been built yet, so that
+ * the row can still be found by searching */
+struct _AdapPreferencesRowDescriptor
+{
+  GObject parent_instance;
+
+  AdapPreferencesPage *page;
+
+  char *title;
+  char *subtitle;
+
+  char *title_search_key;
+  char *subtitle_search_key;
+};
+
+G_DEFINE_FINAL_TYPE (AdapPreferencesRowDescriptor, adap_preferences_row_descriptor, G_TYPE_OBJECT)
+
+static void
+adap_preferences_row_descriptor_finalize (GObject *object)
+{
+  AdapPreferencesRowDescriptor *self = ADAP_PREFERENCES_ROW_DESCRIPTOR (object);
+
+  g_clear_weak_pointer (&self->page);
+
+  g_free (self->title);
+  g_free (self->subtitle);
+  g_free (self->title_search_key);
+  g_free (self->subtitle_search_key);
+
+  G_OBJECT_CLASS (adap_preferences_row_descriptor_parent_class)->finalize (object);
+}
+
+static void
+adap_preferences_row_descriptor_class_init (AdapPreferencesRowDescriptorClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = adap_preferences_row_descriptor_finalize;
+}
+
+static void
+adap_preferences_row_descriptor_init (AdapPreferencesRowDescriptor *self)
+{
+}
+
+AdapPreferencesRowDescriptor *
+adap_preferences_row_descriptor_new (AdapPreferencesPage *page,
+                                     const char          *title,
+                                     const char          *subtitle)
+{
+  AdapPreferencesRowDescriptor *self;
+
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_PAGE (page), NULL);
+  g_return_val_if_fail (title != NULL, NULL);
+
+  self = g_object_new (ADAP_TYPE_PREFERENCES_ROW_DESCRIPTOR, NULL);
+
+  g_set_weak_pointer (&self->page, page);
+
+  self->title = g_strdup (title);
+  self->subtitle = g_strdup (subtitle);
+
+  /* Descriptors are plain text, so the keys can be computed once */
+  self->title_search_key = g_utf8_casefold (title, -1);
+
+  if (subtitle)
+    self->subtitle_search_key = g_utf8_casefold (subtitle, -1);
+
+  return self;
+}
+
+AdapPreferencesPage *
+adap_preferences_row_descriptor_get_page (AdapPreferencesRowDescriptor *self)
+{
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (self), NULL);
+
+  return self->page;
+}
+
+const char *
+adap_preferences_row_descriptor_get_title (AdapPreferencesRowDescriptor *self)
+{
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (self), NULL);
+
+  return self->title;
+}
+
+const char *
+adap_preferences_row_descriptor_get_subtitle (AdapPreferencesRowDescriptor *self)
+{
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (self), NULL);
+
+  return self->subtitle;
+}
+
+int
+adap_preferences_row_descriptor_get_search_score (AdapPreferencesRowDescriptor *self,
+                                                  const char * const           *tokens)
+{
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (self), 0);
+  g_return_val_if_fail (tokens != NULL, 0);
+
+  return adap_preferences_get_search_score (self->title_search_key,
+                                            self->subtitle_search_key,
+                                            tokens);
+}
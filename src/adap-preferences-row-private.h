@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2019 Purism SPC
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADAPTA_INSIDE) && !defined(ADAPTA_COMPILATION)
+#error "Only <adapta.h> can be included directly."
+#endif
+
+#include "adap-preferences-row.h"
+
+G_BEGIN_DECLS
+
+ADAP_AVAILABLE_IN_ALL
+char **adap_preferences_row_tokenize_search (const char *text);
+
+ADAP_AVAILABLE_IN_ALL
+int adap_preferences_row_get_search_score (AdapPreferencesRow  *self,
+                                          const char * const *tokens);
+
+char *adap_preferences_row_strip_mnemonic (const char *src);
+
+int adap_preferences_get_search_score (const char         *title_key,
+                                       const char         *subtitle_key,
+                                       const char * const *tokens);
+
+G_END_DECLS
@@ -6,7 +6,9 @@
 
 #include "config.h"
 
-#include "adap-preferences-row.h"
+#include "adap-preferences-row-private.h"
+
+#include "adap-action-row.h"
 
 /**
  * AdapPreferencesRow:
@@ -29,6 +31,12 @@ typedef struct
   gboolean use_underline;
   gboolean title_selectable;
   gboolean use_markup;
+
+  /* Casefolded title and subtitle without markup and mnemonics, created on
+   * the first search and dropped whenever anything they depend on changes */
+  char *title_search_key;
+  char *subtitle_search_key;
+  gboolean search_keys_valid;
 } AdapPreferencesRowPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (AdapPreferencesRow, adap_preferences_row, GTK_TYPE_LIST_BOX_ROW)
@@ -44,6 +52,89 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
+/* Copied and modified from gtklabel.c, separate_uline_pattern() */
+char *
+adap_preferences_row_strip_mnemonic (const char *src)
+{
+  char *new_str = g_new (char, strlen (src) + 1);
+  char *dest = new_str;
+  gboolean underscore = FALSE;
+
+  while (*src) {
+    gunichar c;
+    const char *next_src;
+
+    c = g_utf8_get_char (src);
+    if (c == (gunichar) -1) {
+      g_warning ("Invalid input string");
+
+      g_free (new_str);
+
+      return NULL;
+    }
+
+    next_src = g_utf8_next_char (src);
+
+    if (underscore) {
+      while (src < next_src)
+        *dest++ = *src++;
+
+      underscore = FALSE;
+    } else {
+      if (c == '_'){
+        underscore = TRUE;
+        src = next_src;
+      } else {
+        while (src < next_src)
+          *dest++ = *src++;
+      }
+    }
+  }
+
+  *dest = 0;
+
+  return new_str;
+}
+
+static char *
+make_comparable (const char        *src,
+                 AdapPreferencesRow *row,
+                 gboolean           allow_underline)
+{
+  char *plaintext = g_utf8_casefold (src, -1);
+  GError *error = NULL;
+
+  if (adap_preferences_row_get_use_markup (row)) {
+    char *parsed = NULL;
+
+    if (pango_parse_markup (plaintext, -1, 0, NULL, &parsed, NULL, &error)) {
+      g_free (plaintext);
+      plaintext = parsed;
+    } else {
+      g_critical ("Couldn't parse markup: %s", error->message);
+      g_clear_error (&error);
+    }
+  }
+
+  if (allow_underline && adap_preferences_row_get_use_underline (row)) {
+    char *comparable = adap_preferences_row_strip_mnemonic (plaintext);
+    g_free (plaintext);
+    return comparable;
+  }
+
+  return plaintext;
+}
+
+static void
+invalidate_search_keys (AdapPreferencesRow *self)
+{
+  AdapPreferencesRowPrivate *priv = adap_preferences_row_get_instance_private (self);
+
+  g_clear_pointer (&priv->title_search_key, g_free);
+  g_clear_pointer (&priv->subtitle_search_key, g_free);
+  priv->search_keys_valid = FALSE;
+}
+
 static void
 adap_preferences_row_get_property (GObject    *object,
                                   guint       prop_id,
@@ -102,6 +193,8 @@ adap_preferences_row_finalize (GObject *object)
   AdapPreferencesRowPrivate *priv = adap_preferences_row_get_instance_private (self);
 
   g_free (priv->title);
+  g_free (priv->title_search_key);
+  g_free (priv->subtitle_search_key);
 
   G_OBJECT_CLASS (adap_preferences_row_parent_class)->finalize (object);
 }
@@ -177,6 +270,9 @@ adap_preferences_row_init (AdapPreferencesRow *self)
     AdapPreferencesRowPrivate *priv = adap_preferences_row_get_instance_private (self);
     priv->title = g_strdup ("");
     priv->use_markup = TRUE;
+
+    /* The subtitle is provided by subclasses */
+    g_signal_connect (self, "notify::subtitle", G_CALLBACK (invalidate_search_keys), NULL);
 }
 
 /**
@@ -235,6 +331,8 @@ adap_preferences_row_set_title (AdapPreferencesRow *self,
   if (!g_set_str (&priv->title, title ? title : ""))
     return;
 
+  invalidate_search_keys (self);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_TITLE]);
 }
 
@@ -282,6 +380,8 @@ adap_preferences_row_set_use_underline (AdapPreferencesRow *self,
 
   priv->use_underline = use_underline;
 
+  invalidate_search_keys (self);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_USE_UNDERLINE]);
 }
 
@@ -386,5 +486,146 @@ adap_preferences_row_set_use_markup (AdapPreferencesRow *self,
 
   priv->use_markup = use_markup;
 
+  invalidate_search_keys (self);
+
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_USE_MARKUP]);
 }
+
+/* Returns how well @token matches @key: at the start of @key, at the start of
+ * a word, anywhere, or not at all */
+static int
+get_token_score (const char *key,
+                 const char *token)
+{
+  const char *match;
+  int score = 0;
+
+  if (!key)
+    return 0;
+
+  for (match = strstr (key, token); match; match = strstr (match + 1, token)) {
+    gunichar prev;
+
+    if (match == key)
+      return 3;
+
+    prev = g_utf8_get_char (g_utf8_find_prev_char (key, match));
+
+    if (!g_unichar_isalnum (prev))
+      score = 2;
+    else
+      score = MAX (score, 1);
+  }
+
+  return score;
+}
+
+/*
+ * adap_preferences_row_tokenize_search:
+ * @text: the search text
+ *
+ * Splits @text into casefolded search terms, for use with
+ * adap_preferences_row_get_search_score().
+ *
+ * Returns: (transfer full): the search terms
+ */
+char **
+adap_preferences_row_tokenize_search (const char *text)
+{
+  GPtrArray *tokens = g_ptr_array_new ();
+  char *casefolded;
+  char **split;
+  int i;
+
+  casefolded = g_utf8_casefold (text ? text : "", -1);
+  split = g_strsplit_set (casefolded, " \t\n", -1);
+
+  for (i = 0; split[i]; i++) {
+    if (*split[i])
+      g_ptr_array_add (tokens, split[i]);
+    else
+      g_free (split[i]);
+  }
+
+  g_ptr_array_add (tokens, NULL);
+
+  g_free (split);
+  g_free (casefolded);
+
+  return (char **) g_ptr_array_free (tokens, FALSE);
+}
+
+/*
+ * adap_preferences_get_search_score:
+ * @title_key: (nullable): the casefolded plain text title
+ * @subtitle_key: (nullable): the casefolded plain text subtitle
+ * @tokens: search terms from adap_preferences_row_tokenize_search()
+ *
+ * Scores a search result from its title and subtitle the same way as
+ * adap_preferences_row_get_search_score().
+ *
+ * Returns: 0 if there's no match, otherwise a higher value for better matches
+ */
+int
+adap_preferences_get_search_score (const char         *title_key,
+                                   const char         *subtitle_key,
+                                   const char * const *tokens)
+{
+  int score = 1;
+  int i;
+
+  for (i = 0; tokens[i]; i++) {
+    int title_score = get_token_score (title_key, tokens[i]);
+    int subtitle_score = get_token_score (subtitle_key, tokens[i]);
+
+    if (!title_score && !subtitle_score)
+      return 0;
+
+    /* Any title match beats any subtitle match */
+    score += title_score ? 3 + title_score : subtitle_score;
+  }
+
+  return score;
+}
+
+/*
+ * adap_preferences_row_get_search_score:
+ * @self: a preferences row
+ * @tokens: search terms from adap_preferences_row_tokenize_search()
+ *
+ * Checks whether every term in @tokens occurs in the title of @self or, for
+ * action rows, in its subtitle, ignoring case, markup and mnemonics.
+ *
+ * Matches in the title rank higher than in the subtitle, and matches at the
+ * start of a word rank higher than in the middle of one.
+ *
+ * Returns: 0 if @self doesn't match, otherwise a higher value for better
+ *   matches
+ */
+int
+adap_preferences_row_get_search_score (AdapPreferencesRow  *self,
+                                       const char * const *tokens)
+{
+  AdapPreferencesRowPrivate *priv;
+
+  g_return_val_if_fail (ADAP_IS_PREFERENCES_ROW (self), 0);
+  g_return_val_if_fail (tokens != NULL, 0);
+
+  priv = adap_preferences_row_get_instance_private (self);
+
+  if (!priv->search_keys_valid) {
+    priv->title_search_key = make_comparable (priv->title, self, TRUE);
+
+    if (ADAP_IS_ACTION_ROW (self)) {
+      const char *subtitle = adap_action_row_get_subtitle (ADAP_ACTION_ROW (self));
+
+      priv->subtitle_search_key = make_comparable (subtitle ? subtitle : "", self, FALSE);
+    }
+
+    priv->search_keys_valid = TRUE;
+  }
+
+  return adap_preferences_get_search_score (priv->title_search_key,
+                                            priv->subtitle_search_key,
+                                            tokens);
+}
@@ -16,6 +16,8 @@
 #include "adap-navigation-view.h"
 #include "adap-preferences-group-private.h"
 #include "adap-preferences-page-private.h"
+#include "adap-preferences-row-descriptor-private.h"
+#include "adap-preferences-row-private.h"
 #include "adap-toast-overlay.h"
 #include "adap-view-stack.h"
 #include "adap-widget-utils-private.h"
@@ -60,6 +62,8 @@ typedef struct
   AdapBreakpoint *breakpoint;
 
   gboolean search_enabled;
+  char *search_terms;
+  char **search_tokens;
   gboolean can_navigate_back;
 
   GtkFilter *filter;
@@ -91,107 +95,24 @@ enum {
 
 static GParamSpec *props[LAST_PROP];
 
-/* Copied and modified from gtklabel.c, separate_uline_pattern() */
-static char *
-strip_mnemonic (const char *src)
-{
-  char *new_str = g_new (char, strlen (src) + 1);
-  char *dest = new_str;
-  gboolean underscore = FALSE;
-
-  while (*src) {
-    gunichar c;
-    const char *next_src;
-
-    c = g_utf8_get_char (src);
-    if (c == (gunichar) -1) {
-      g_warning ("Invalid input string");
-
-      g_free (new_str);
-
-      return NULL;
-    }
-
-    next_src = g_utf8_next_char (src);
-
-    if (underscore) {
-      while (src < next_src)
-        *dest++ = *src++;
-
-      underscore = FALSE;
-    } else {
-      if (c == '_'){
-        underscore = TRUE;
-        src = next_src;
-      } else {
-        while (src < next_src)
-          *dest++ = *src++;
-      }
-    }
-  }
-
-  *dest = 0;
-
-  return new_str;
-}
-
-static char *
-make_comparable (const char        *src,
-                 AdapPreferencesRow *row,
-                 gboolean           allow_underline)
-{
-  char *plaintext = g_utf8_casefold (src, -1);
-  GError *error = NULL;
-
-  if (adap_preferences_row_get_use_markup (row)) {
-    char *parsed = NULL;
-
-    if (pango_parse_markup (plaintext, -1, 0, NULL, &parsed, NULL, &error)) {
-      g_free (plaintext);
-      plaintext = parsed;
-    } else {
-      g_critical ("Couldn't parse markup: %s", error->message);
-      g_clear_error (&error);
-    }
-  }
-
-  if (allow_underline && adap_preferences_row_get_use_underline (row)) {
-    char *comparable = strip_mnemonic (plaintext);
-    g_free (plaintext);
-    return comparable;
-  }
-
-  return plaintext;
-}
-
 static gboolean
-filter_search_results (AdapPreferencesRow    *row,
+filter_search_results (GObject               *item,
                        AdapPreferencesWindow *self)
 {
   AdapPreferencesWindowPrivate *priv = adap_preferences_window_get_instance_private (self);
-  char *terms, *title;
-  gboolean result = FALSE;
+  const char * const *tokens;
 
-  g_assert (ADAP_IS_PREFERENCES_ROW (row));
+  if (!priv->search_tokens)
+    return TRUE;
 
-  terms = g_utf8_casefold (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)), -1);
-  title = make_comparable (adap_preferences_row_get_title (row), row, TRUE);
+  tokens = (const char * const *) priv->search_tokens;
 
-  if (!!strstr (title, terms)) {
-    result = TRUE;
-  } else if (ADAP_IS_ACTION_ROW (row)) {
-    char *subtitle = make_comparable (adap_action_row_get_subtitle (ADAP_ACTION_ROW(row)), row, FALSE);
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item))
+    return adap_preferences_row_descriptor_get_search_score (ADAP_PREFERENCES_ROW_DESCRIPTOR (item), tokens) > 0;
 
-    if (!!strstr (subtitle, terms))
-      result = TRUE;
+  g_assert (ADAP_IS_PREFERENCES_ROW (item));
 
-    g_free (subtitle);
-  }
-
-  g_free (title);
-  g_free (terms);
-
-  return result;
+  return adap_preferences_row_get_search_score (ADAP_PREFERENCES_ROW (item), tokens) > 0;
 }
 
 static int
@@ -215,13 +136,20 @@ get_n_pages (AdapPreferencesWindow *self)
 
 static char *
 create_search_row_subtitle (AdapPreferencesWindow *self,
-                            AdapPreferencesRow    *row)
+                            GObject               *item)
 {
-  GtkWidget *group, *page;
+  GtkWidget *group = NULL, *page;
   const char *group_title = NULL;
   char *page_title = NULL;
+  gboolean use_markup = FALSE;
 
-  group = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_GROUP);
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    page = GTK_WIDGET (adap_preferences_row_descriptor_get_page (ADAP_PREFERENCES_ROW_DESCRIPTOR (item)));
+  } else {
+    use_markup = adap_preferences_row_get_use_markup (ADAP_PREFERENCES_ROW (item));
+    group = gtk_widget_get_ancestor (GTK_WIDGET (item), ADAP_TYPE_PREFERENCES_GROUP);
+    page = group ? gtk_widget_get_ancestor (group, ADAP_TYPE_PREFERENCES_PAGE) : NULL;
+  }
 
   if (group) {
     group_title = adap_preferences_group_get_title (ADAP_PREFERENCES_GROUP (group));
@@ -230,17 +158,15 @@ create_search_row_subtitle (AdapPreferencesWindow *self,
       group_title = NULL;
   }
 
-  page = gtk_widget_get_ancestor (group, ADAP_TYPE_PREFERENCES_PAGE);
-
   if (page) {
     const char *title = adap_preferences_page_get_title (ADAP_PREFERENCES_PAGE (page));
 
     if (adap_preferences_page_get_use_underline (ADAP_PREFERENCES_PAGE (page)))
-      page_title = strip_mnemonic (title);
+      page_title = adap_preferences_row_strip_mnemonic (title);
     else
       page_title = g_strdup (title);
 
-    if (adap_preferences_row_get_use_markup (row)) {
+    if (use_markup) {
       char *tmp = page_title;
 
       page_title = g_markup_escape_text (page_title, -1);
@@ -269,30 +195,34 @@ create_search_row_subtitle (AdapPreferencesWindow *self,
 }
 
 static GtkWidget *
-new_search_row_for_preference (AdapPreferencesRow    *row,
+new_search_row_for_preference (GObject               *item,
                                AdapPreferencesWindow *self)
 {
   AdapActionRow *widget;
-  GtkWidget *page;
   char *subtitle;
 
-  g_assert (ADAP_IS_PREFERENCES_ROW (row));
-
-  subtitle = create_search_row_subtitle (self, row);
-  page = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_PAGE);
+  subtitle = create_search_row_subtitle (self, item);
 
   widget = ADAP_ACTION_ROW (adap_action_row_new ());
   gtk_list_box_row_set_activatable (GTK_LIST_BOX_ROW (widget), TRUE);
-  adap_preferences_row_set_use_markup (ADAP_PREFERENCES_ROW (widget),
-                                      adap_preferences_row_get_use_markup (row));
-  adap_preferences_row_set_use_underline (ADAP_PREFERENCES_ROW (widget),
-                                         adap_preferences_row_get_use_underline (row));
-  adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (widget),
-                                 adap_preferences_row_get_title (row));
+
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (widget),
+                                   adap_preferences_row_descriptor_get_title (ADAP_PREFERENCES_ROW_DESCRIPTOR (item)));
+  } else {
+    AdapPreferencesRow *row = ADAP_PREFERENCES_ROW (item);
+
+    adap_preferences_row_set_use_markup (ADAP_PREFERENCES_ROW (widget),
+                                        adap_preferences_row_get_use_markup (row));
+    adap_preferences_row_set_use_underline (ADAP_PREFERENCES_ROW (widget),
+                                           adap_preferences_row_get_use_underline (row));
+    adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (widget),
+                                   adap_preferences_row_get_title (row));
+  }
+
   adap_action_row_set_subtitle (widget, subtitle);
 
-  g_object_set_data (G_OBJECT (widget), "page", page);
-  g_object_set_data (G_OBJECT (widget), "row", row);
+  g_object_set_data_full (G_OBJECT (widget), "item", g_object_ref (item), g_object_unref);
 
   g_clear_pointer (&subtitle, g_free);
 
@@ -304,20 +234,38 @@ search_result_activated_cb (AdapPreferencesWindow *self,
                             AdapActionRow         *widget)
 {
   AdapPreferencesWindowPrivate *priv = adap_preferences_window_get_instance_private (self);
-  AdapPreferencesPage *page;
   AdapPreferencesRow *row;
+  GtkWidget *page;
+  GObject *item;
 
-  gtk_toggle_button_set_active (priv->search_button, FALSE);
-  page = ADAP_PREFERENCES_PAGE (g_object_get_data (G_OBJECT (widget), "page"));
-  row = ADAP_PREFERENCES_ROW (g_object_get_data (G_OBJECT (widget), "row"));
+  item = g_object_ref (g_object_get_data (G_OBJECT (widget), "item"));
+
+  g_assert (item != NULL);
+
+  if (ADAP_IS_PREFERENCES_ROW_DESCRIPTOR (item)) {
+    AdapPreferencesRowDescriptor *descriptor = ADAP_PREFERENCES_ROW_DESCRIPTOR (item);
+
+    page = GTK_WIDGET (adap_preferences_row_descriptor_get_page (descriptor));
+    row = adap_preferences_page_find_row (ADAP_PREFERENCES_PAGE (page),
+                                          adap_preferences_row_descriptor_get_title (descriptor));
+  } else {
+    row = ADAP_PREFERENCES_ROW (item);
+    page = gtk_widget_get_ancestor (GTK_WIDGET (row), ADAP_TYPE_PREFERENCES_PAGE);
+  }
 
   g_assert (page != NULL);
-  g_assert (row != NULL);
 
-  adap_view_stack_set_visible_child (priv->pages_stack, GTK_WIDGET (page));
-  gtk_widget_set_can_focus (GTK_WIDGET (row), TRUE);
-  gtk_widget_grab_focus (GTK_WIDGET (row));
-  gtk_window_set_focus_visible (GTK_WINDOW (self), TRUE);
+  gtk_toggle_button_set_active (priv->search_button, FALSE);
+
+  adap_view_stack_set_visible_child (priv->pages_stack, page);
+
+  if (row) {
+    gtk_widget_set_can_focus (GTK_WIDGET (row), TRUE);
+    gtk_widget_grab_focus (GTK_WIDGET (row));
+    gtk_window_set_focus_visible (GTK_WINDOW (self), TRUE);
+  }
+
+  g_object_unref (item);
 }
 
 static void
@@ -460,9 +408,30 @@ static void
 search_changed_cb (AdapPreferencesWindow *self)
 {
   AdapPreferencesWindowPrivate *priv = adap_preferences_window_get_instance_private (self);
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  char *terms;
   guint n;
 
-  gtk_filter_changed (priv->filter, GTK_FILTER_CHANGE_DIFFERENT);
+  /* Casefold the terms once here rather than for every row */
+  terms = g_utf8_casefold (gtk_editable_get_text (GTK_EDITABLE (priv->search_entry)), -1);
+
+  if (!g_strcmp0 (terms, priv->search_terms)) {
+    g_free (terms);
+  } else {
+    /* Typing more can only remove results, deleting can only add them */
+    if (priv->search_terms && strstr (terms, priv->search_terms))
+      change = GTK_FILTER_CHANGE_MORE_STRICT;
+    else if (priv->search_terms && strstr (priv->search_terms, terms))
+      change = GTK_FILTER_CHANGE_LESS_STRICT;
+
+    g_free (priv->search_terms);
+    priv->search_terms = terms;
+
+    g_strfreev (priv->search_tokens);
+    priv->search_tokens = adap_preferences_row_tokenize_search (terms);
+
+    gtk_filter_changed (priv->filter, change);
+  }
 
   n = g_list_model_get_n_items (G_LIST_MODEL (priv->filter_model));
 
@@ -536,6 +505,8 @@ adap_preferences_window_dispose (GObject *object)
   AdapPreferencesWindowPrivate *priv = adap_preferences_window_get_instance_private (self);
 
   g_clear_object (&priv->filter_model);
+  g_clear_pointer (&priv->search_terms, g_free);
+  g_clear_pointer (&priv->search_tokens, g_strfreev);
 
   G_OBJECT_CLASS (adap_preferences_window_parent_class)->dispose (object);
 }
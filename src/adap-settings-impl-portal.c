@@ -19,11 +19,39 @@
 
 #define PORTAL_ERROR_NOT_FOUND "org.freedesktop.portal.Error.NotFound"
 
+/* The portal is read asynchronously, but don't wait forever for a reply */
+#define PORTAL_TIMEOUT_MS 5000
+
+enum {
+  SETTING_THEME_NAME,
+  SETTING_COLOR_SCHEME,
+  SETTING_CONTRAST,
+  SETTING_A11Y_HIGH_CONTRAST,
+  N_SETTINGS,
+};
+
+static const struct {
+  const char *schema;
+  const char *name;
+  const char *type;
+} portal_settings[N_SETTINGS] = {
+  { "org.gnome.desktop.interface", "gtk-theme", "s" },
+  { "org.freedesktop.appearance", "color-scheme", "u" },
+  { "org.freedesktop.appearance", "contrast", "u" },
+  { "org.gnome.desktop.a11y.interface", "high-contrast", "b" },
+};
+
 struct _AdapSettingsImplPortal
 {
   AdapSettingsImpl parent_instance;
 
   GDBusProxy *settings_portal;
+  GCancellable *cancellable;
+  guint proxy_timeout_id;
+
+  gboolean enabled[N_SETTINGS];
+  GVariant *values[N_SETTINGS];
+  int n_pending_reads;
 
   gboolean found_theme_name;
   gboolean found_color_scheme;
@@ -37,70 +65,68 @@ struct _AdapSettingsImplPortal
 
 G_DEFINE_FINAL_TYPE (AdapSettingsImplPortal, adap_settings_impl_portal, ADAP_TYPE_SETTINGS_IMPL)
 
-static gboolean
-read_setting (AdapSettingsImplPortal  *self,
-              const char             *schema,
-              const char             *name,
-              const char             *type,
-              GVariant              **out)
+typedef struct {
+  AdapSettingsImplPortal *self;
+  int setting;
+} ReadData;
+
+static void
+report_error (GError     *error,
+              const char *schema,
+              const char *name,
+              const char *type)
 {
-  GError *error = NULL;
-  GVariant *ret;
-  GVariant *child, *child2;
-  GVariantType *out_type;
-  gboolean result = FALSE;
-
-  ret = g_dbus_proxy_call_sync (self->settings_portal,
-                                "Read",
-                                g_variant_new ("(ss)", schema, name),
-                                G_DBUS_CALL_FLAGS_NONE,
-                                G_MAXINT,
-                                NULL,
-                                &error);
-  if (error) {
-    if (error->domain == G_DBUS_ERROR &&
-        error->code == G_DBUS_ERROR_SERVICE_UNKNOWN) {
-      g_debug ("Portal not found: %s", error->message);
-    } else if (error->domain == G_DBUS_ERROR &&
-               error->code == G_DBUS_ERROR_UNKNOWN_METHOD) {
-      g_debug ("Portal doesn't provide settings: %s", error->message);
-    } else if (g_dbus_error_is_remote_error (error)) {
-      char *remote_error = g_dbus_error_get_remote_error (error);
-
-      if (!g_strcmp0 (remote_error, PORTAL_ERROR_NOT_FOUND)) {
-        g_debug ("Setting %s.%s of type %s not found", schema, name, type);
-      }
-      g_free (remote_error);
-    } else {
-      g_critical ("Couldn't read the %s setting: %s", name, error->message);
-    }
+  if (error->domain == G_DBUS_ERROR &&
+      error->code == G_DBUS_ERROR_SERVICE_UNKNOWN) {
+    g_debug ("Portal not found: %s", error->message);
+
+    return;
+  }
+
+  if (error->domain == G_DBUS_ERROR &&
+      error->code == G_DBUS_ERROR_UNKNOWN_METHOD) {
+    g_debug ("Portal doesn't provide settings: %s", error->message);
 
-    g_clear_error (&error);
+    return;
+  }
+
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT) ||
+      (error->domain == G_DBUS_ERROR && error->code == G_DBUS_ERROR_NO_REPLY)) {
+    g_debug ("Portal didn't reply in time: %s", error->message);
 
-    return FALSE;
+    return;
   }
 
-  g_variant_get (ret, "(v)", &child);
-  g_variant_get (child, "v", &child2);
+  if (g_dbus_error_is_remote_error (error)) {
+    char *remote_error = g_dbus_error_get_remote_error (error);
 
-  out_type = g_variant_type_new (type);
-  if (g_variant_type_equal (g_variant_get_type (child2), out_type)) {
-    *out = child2;
+    if (!g_strcmp0 (remote_error, PORTAL_ERROR_NOT_FOUND) && name)
+      g_debug ("Setting %s.%s of type %s not found", schema, name, type);
 
-    result = TRUE;
+    g_free (remote_error);
   } else {
+    g_critical ("Couldn't read the %s setting: %s", name ? name : "portal", error->message);
+  }
+}
+
+static void
+store_value (AdapSettingsImplPortal *self,
+             int                    setting,
+             GVariant              *value)
+{
+  const char *type = portal_settings[setting].type;
+
+  if (!g_variant_is_of_type (value, G_VARIANT_TYPE (type))) {
     g_critical ("Invalid type for %s.%s: expected %s, got %s",
-                schema, name, type, g_variant_get_type_string (child2));
+                portal_settings[setting].schema,
+                portal_settings[setting].name,
+                type, g_variant_get_type_string (value));
 
-    g_variant_unref (child2);
+    return;
   }
 
-  g_variant_type_free (out_type);
-  g_variant_unref (child);
-  g_variant_unref (ret);
-  g_clear_error (&error);
-
-  return result;
+  g_clear_pointer (&self->values[setting], g_variant_unref);
+  self->values[setting] = g_variant_ref (value);
 }
 
 static AdapSystemColorScheme
@@ -133,6 +159,25 @@ changed_cb (GDBusProxy            *proxy,
 
   g_variant_get (parameters, "(&s&sv)", &namespace, &name, &value);
 
+  /* Still reading, store the value so it's applied along with the others.
+   * Replies and signals arrive in order, so whichever comes last is current */
+  if (self->cancellable) {
+    int i;
+
+    for (i = 0; i < N_SETTINGS; i++) {
+      if (self->enabled[i] &&
+          !g_strcmp0 (namespace, portal_settings[i].schema) &&
+          !g_strcmp0 (name, portal_settings[i].name)) {
+        store_value (self, i, value);
+        break;
+      }
+    }
+
+    g_variant_unref (value);
+
+    return;
+  }
+
   if (!g_strcmp0 (namespace, "org.gnome.desktop.interface")) {
     if (!g_strcmp0 (name, "gtk-theme") && self->found_theme_name) {
       adap_settings_impl_set_theme_name (ADAP_SETTINGS_IMPL (self),
@@ -176,104 +221,346 @@ changed_cb (GDBusProxy            *proxy,
 }
 
 static void
-adap_settings_impl_portal_dispose (GObject *object)
+apply_settings (AdapSettingsImplPortal *self)
 {
-  AdapSettingsImplPortal *self = ADAP_SETTINGS_IMPL_PORTAL (object);
+  AdapSettingsImpl *impl = ADAP_SETTINGS_IMPL (self);
+  int i;
 
-  g_clear_object (&self->settings_portal);
+  if (self->values[SETTING_THEME_NAME]) {
+    adap_settings_impl_set_theme_name (impl, g_variant_get_string (self->values[SETTING_THEME_NAME], NULL));
+  }
 
-  G_OBJECT_CLASS (adap_settings_impl_portal_parent_class)->dispose (object);
+  if (self->values[SETTING_COLOR_SCHEME]) {
+    self->found_color_scheme = TRUE;
+
+    adap_settings_impl_set_color_scheme (impl, get_fdo_color_scheme (self->values[SETTING_COLOR_SCHEME]));
+  }
+
+  if (self->values[SETTING_CONTRAST]) {
+    self->high_contrast_portal_state = HIGH_CONTRAST_STATE_FDO;
+
+    adap_settings_impl_set_high_contrast (impl, g_variant_get_uint32 (self->values[SETTING_CONTRAST]) == 1);
+  } else if (self->values[SETTING_A11Y_HIGH_CONTRAST]) {
+    self->high_contrast_portal_state = HIGH_CONTRAST_STATE_GNOME;
+
+    adap_settings_impl_set_high_contrast (impl, g_variant_get_boolean (self->values[SETTING_A11Y_HIGH_CONTRAST]));
+  }
+
+  for (i = 0; i < N_SETTINGS; i++)
+    g_clear_pointer (&self->values[i], g_variant_unref);
+
+  g_clear_object (&self->cancellable);
+
+  if (!self->found_theme_name && !self->found_color_scheme && self->high_contrast_portal_state == HIGH_CONTRAST_STATE_NONE)
+    g_signal_handlers_disconnect_by_func (self->settings_portal, changed_cb, self);
+
+  adap_settings_impl_set_features (impl,
+                                  self->found_theme_name,
+                                  self->found_color_scheme,
+                                  self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE);
 }
 
 static void
-adap_settings_impl_portal_class_init (AdapSettingsImplPortalClass *klass)
+read_cb (GDBusProxy   *proxy,
+         GAsyncResult *result,
+         ReadData     *data)
 {
-  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  AdapSettingsImplPortal *self = data->self;
+  int setting = data->setting;
+  GError *error = NULL;
+  GVariant *ret;
 
-  object_class->dispose = adap_settings_impl_portal_dispose;
+  g_free (data);
+
+  ret = g_dbus_proxy_call_finish (proxy, result, &error);
+
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_error_free (error);
+
+    return;
+  }
+
+  if (error) {
+    report_error (error,
+                  portal_settings[setting].schema,
+                  portal_settings[setting].name,
+                  portal_settings[setting].type);
+
+    g_error_free (error);
+  } else {
+    GVariant *child, *child2;
+
+    g_variant_get (ret, "(v)", &child);
+    g_variant_get (child, "v", &child2);
+
+    store_value (self, setting, child2);
+
+    g_variant_unref (child2);
+    g_variant_unref (child);
+    g_variant_unref (ret);
+  }
+
+  if (--self->n_pending_reads == 0)
+    apply_settings (self);
 }
 
 static void
-adap_settings_impl_portal_init (AdapSettingsImplPortal *self)
+read_each (AdapSettingsImplPortal *self)
 {
+  int i;
+
+  for (i = 0; i < N_SETTINGS; i++) {
+    ReadData *data;
+
+    if (!self->enabled[i])
+      continue;
+
+    data = g_new0 (ReadData, 1);
+    data->self = self;
+    data->setting = i;
+
+    self->n_pending_reads++;
+
+    g_dbus_proxy_call (self->settings_portal,
+                       "Read",
+                       g_variant_new ("(ss)", portal_settings[i].schema, portal_settings[i].name),
+                       G_DBUS_CALL_FLAGS_NONE,
+                       PORTAL_TIMEOUT_MS,
+                       self->cancellable,
+                       (GAsyncReadyCallback) read_cb,
+                       data);
+  }
+
+  if (self->n_pending_reads == 0)
+    apply_settings (self);
 }
 
-AdapSettingsImpl *
-adap_settings_impl_portal_new (gboolean get_theme_name,
-                              gboolean enable_color_scheme,
-                              gboolean enable_high_contrast)
+static void
+read_all_cb (GDBusProxy            *proxy,
+             GAsyncResult          *result,
+             AdapSettingsImplPortal *self)
 {
-  AdapSettingsImplPortal *self = g_object_new (ADAP_TYPE_SETTINGS_IMPL_PORTAL, NULL);
   GError *error = NULL;
-  GVariant *variant;
+  GVariant *ret, *namespaces;
+  int i;
 
-  if (adap_get_disable_portal ())
-    return ADAP_SETTINGS_IMPL (self);
+  ret = g_dbus_proxy_call_finish (proxy, result, &error);
+
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_error_free (error);
+
+    return;
+  }
 
-  self->settings_portal = g_dbus_proxy_new_for_bus_sync (G_BUS_TYPE_SESSION,
-                                                         G_DBUS_PROXY_FLAGS_NONE,
-                                                         NULL,
-                                                         PORTAL_BUS_NAME,
-                                                         PORTAL_OBJECT_PATH,
-                                                         PORTAL_SETTINGS_INTERFACE,
-                                                         NULL,
-                                                         &error);
   if (error) {
-    g_debug ("Settings portal not found: %s", error->message);
+    /* Older portals may not have ReadAll, read the settings one by one */
+    if (error->domain == G_DBUS_ERROR &&
+        error->code == G_DBUS_ERROR_UNKNOWN_METHOD) {
+      g_debug ("ReadAll not supported, falling back to Read: %s", error->message);
+
+      g_error_free (error);
+
+      read_each (self);
+
+      return;
+    }
+
+    report_error (error, NULL, NULL, NULL);
 
     g_error_free (error);
 
-    return ADAP_SETTINGS_IMPL (self);
+    apply_settings (self);
+
+    return;
   }
 
-  if (get_theme_name &&
-      read_setting (self, "org.gnome.desktop.interface",
-                    "gtk-theme", "s", &variant)) {
+  namespaces = g_variant_get_child_value (ret, 0);
 
-    adap_settings_impl_set_theme_name (ADAP_SETTINGS_IMPL (self),
-                                      g_variant_get_string (variant, NULL));
+  for (i = 0; i < N_SETTINGS; i++) {
+    GVariant *namespace, *value;
 
-    g_variant_unref (variant);
+    if (!self->enabled[i])
+      continue;
+
+    namespace = g_variant_lookup_value (namespaces, portal_settings[i].schema,
+                                        G_VARIANT_TYPE_VARDICT);
+
+    if (!namespace)
+      continue;
+
+    value = g_variant_lookup_value (namespace, portal_settings[i].name, NULL);
+
+    if (value) {
+      store_value (self, i, value);
+
+      g_variant_unref (value);
+    } else {
+      g_debug ("Setting %s.%s of type %s not found",
+               portal_settings[i].schema,
+               portal_settings[i].name,
+               portal_settings[i].type);
+    }
+
+    g_variant_unref (namespace);
   }
 
-  if (enable_color_scheme &&
-      read_setting (self, "org.freedesktop.appearance",
-                    "color-scheme", "u", &variant)) {
-    self->found_color_scheme = TRUE;
+  g_variant_unref (namespaces);
+  g_variant_unref (ret);
+
+  apply_settings (self);
+}
 
-    adap_settings_impl_set_color_scheme (ADAP_SETTINGS_IMPL (self),
-                                        get_fdo_color_scheme (variant));
+static void
+proxy_ready_cb (GObject               *source,
+                GAsyncResult          *result,
+                AdapSettingsImplPortal *self)
+{
+  GError *error = NULL;
+  GPtrArray *namespaces;
+  GDBusProxy *proxy;
+  int i;
+
+  proxy = g_dbus_proxy_new_for_bus_finish (result, &error);
+
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    /* Either disposed or timed out, don't touch self */
+    g_error_free (error);
 
-    g_variant_unref (variant);
+    return;
   }
 
-  if (enable_high_contrast) {
-    if (read_setting (self, "org.freedesktop.appearance",
-                    "contrast", "u", &variant)) {
-      self->high_contrast_portal_state = HIGH_CONTRAST_STATE_FDO;
+  g_clear_handle_id (&self->proxy_timeout_id, g_source_remove);
 
-      adap_settings_impl_set_high_contrast (ADAP_SETTINGS_IMPL (self),
-                                           g_variant_get_uint32 (variant) == 1);
+  if (error) {
+    g_debug ("Settings portal not found: %s", error->message);
 
-      g_variant_unref (variant);
-    } else if (read_setting (self, "org.gnome.desktop.a11y.interface",
-                    "high-contrast", "b", &variant)) {
-      self->high_contrast_portal_state = HIGH_CONTRAST_STATE_GNOME;
+    g_error_free (error);
+    g_clear_object (&self->cancellable);
 
-      adap_settings_impl_set_high_contrast (ADAP_SETTINGS_IMPL (self),
-                                           g_variant_get_boolean (variant));
-      g_variant_unref (variant);
-    }
+    return;
   }
 
-  adap_settings_impl_set_features (ADAP_SETTINGS_IMPL (self),
-                                  self->found_theme_name,
-                                  self->found_color_scheme,
-                                  self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE);
+  self->settings_portal = proxy;
+
+  /* Connect before reading so changes made in the meantime aren't lost */
+  g_signal_connect (self->settings_portal, "g-signal",
+                    G_CALLBACK (changed_cb), self);
+
+  namespaces = g_ptr_array_new ();
+
+  for (i = 0; i < N_SETTINGS; i++) {
+    if (!self->enabled[i])
+      continue;
+
+    if (!g_ptr_array_find_with_equal_func (namespaces, portal_settings[i].schema,
+                                           g_str_equal, NULL))
+      g_ptr_array_add (namespaces, (gpointer) portal_settings[i].schema);
+  }
+
+  g_ptr_array_add (namespaces, NULL);
+
+  g_dbus_proxy_call (self->settings_portal,
+                     "ReadAll",
+                     g_variant_new ("(^as)", namespaces->pdata),
+                     G_DBUS_CALL_FLAGS_NONE,
+                     PORTAL_TIMEOUT_MS,
+                     self->cancellable,
+                     (GAsyncReadyCallback) read_all_cb,
+                     self);
+
+  g_ptr_array_unref (namespaces);
+}
+
+static void
+proxy_timeout_cb (AdapSettingsImplPortal *self)
+{
+  self->proxy_timeout_id = 0;
+
+  g_debug ("Timed out connecting to the settings portal");
+
+  g_cancellable_cancel (self->cancellable);
+}
+
+static void
+adap_settings_impl_portal_dispose (GObject *object)
+{
+  AdapSettingsImplPortal *self = ADAP_SETTINGS_IMPL_PORTAL (object);
+  int i;
+
+  g_clear_handle_id (&self->proxy_timeout_id, g_source_remove);
+
+  g_cancellable_cancel (self->cancellable);
+  g_clear_object (&self->cancellable);
+
+  if (self->settings_portal)
+    g_signal_handlers_disconnect_by_func (self->settings_portal, changed_cb, self);
+
+  g_clear_object (&self->settings_portal);
+
+  for (i = 0; i < N_SETTINGS; i++)
+    g_clear_pointer (&self->values[i], g_variant_unref);
+
+  G_OBJECT_CLASS (adap_settings_impl_portal_parent_class)->dispose (object);
+}
+
+static void
+adap_settings_impl_portal_class_init (AdapSettingsImplPortalClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = adap_settings_impl_portal_dispose;
+}
+
+static void
+adap_settings_impl_portal_init (AdapSettingsImplPortal *self)
+{
+}
+
+/*
+ * adap_settings_impl_portal_new:
+ *
+ * Creates a settings implementation reading from the settings portal.
+ *
+ * The settings are read asynchronously with a single ReadAll call, falling
+ * back to a Read call per setting for older portals. Until they arrive, the
+ * returned object has no features. Once they do, its features are set and
+ * `features-changed` is emitted.
+ *
+ * Connecting to the portal and each call are bounded by PORTAL_TIMEOUT_MS, if
+ * they time out the object keeps having no features.
+ */
+AdapSettingsImpl *
+adap_settings_impl_portal_new (gboolean enable_theme_name,
+                              gboolean enable_color_scheme,
+                              gboolean enable_high_contrast)
+{
+  AdapSettingsImplPortal *self = g_object_new (ADAP_TYPE_SETTINGS_IMPL_PORTAL, NULL);
+
+  if (adap_get_disable_portal ())
+    return ADAP_SETTINGS_IMPL (self);
 
-  if (self->found_theme_name || self->found_color_scheme || self->high_contrast_portal_state != HIGH_CONTRAST_STATE_NONE)
-    g_signal_connect (self->settings_portal, "g-signal",
-                      G_CALLBACK (changed_cb), self);
+  self->enabled[SETTING_THEME_NAME] = enable_theme_name;
+  self->enabled[SETTING_COLOR_SCHEME] = enable_color_scheme;
+  self->enabled[SETTING_CONTRAST] = enable_high_contrast;
+  self->enabled[SETTING_A11Y_HIGH_CONTRAST] = enable_high_contrast;
+
+  self->cancellable = g_cancellable_new ();
+
+  g_dbus_proxy_new_for_bus (G_BUS_TYPE_SESSION,
+                            G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                            NULL,
+                            PORTAL_BUS_NAME,
+                            PORTAL_OBJECT_PATH,
+                            PORTAL_SETTINGS_INTERFACE,
+                            self->cancellable,
+                            (GAsyncReadyCallback) proxy_ready_cb,
+                            self);
+
+  /* Proxy creation has no timeout of its own */
+  self->proxy_timeout_id = g_timeout_add_once (PORTAL_TIMEOUT_MS,
+                                               (GSourceOnceFunc) proxy_timeout_cb,
+                                               self);
+  g_source_set_name_by_id (self->proxy_timeout_id, "[adap] proxy_timeout_cb");
 
   return ADAP_SETTINGS_IMPL (self);
 }
@@ -26,23 +26,29 @@ struct _AdapSettingsImplClass
   GObjectClass parent_class;
 };
 
+ADAP_AVAILABLE_IN_ALL
 gboolean adap_settings_impl_get_has_theme_name (AdapSettingsImpl *self);
+ADAP_AVAILABLE_IN_ALL
 gboolean adap_settings_impl_get_has_color_scheme  (AdapSettingsImpl *self);
+ADAP_AVAILABLE_IN_ALL
 gboolean adap_settings_impl_get_has_high_contrast (AdapSettingsImpl *self);
 void     adap_settings_impl_set_features          (AdapSettingsImpl *self,
                                                   gboolean         has_theme_name,
                                                   gboolean         has_color_scheme,
                                                   gboolean         has_high_contrast);
 
+ADAP_AVAILABLE_IN_ALL
 AdapSystemColorScheme adap_settings_impl_get_color_scheme (AdapSettingsImpl      *self);
 void                 adap_settings_impl_set_color_scheme (AdapSettingsImpl      *self,
                                                          AdapSystemColorScheme  color_scheme);
 
+ADAP_AVAILABLE_IN_ALL
 gboolean adap_settings_impl_get_high_contrast (AdapSettingsImpl *self);
 void     adap_settings_impl_set_high_contrast (AdapSettingsImpl *self,
                                               gboolean         high_contrast);
 void     adap_settings_impl_set_theme_name    (AdapSettingsImpl *self,
                                               const gchar     *theme_name);
+ADAP_AVAILABLE_IN_ALL
 const gchar *adap_settings_impl_get_theme_name (AdapSettingsImpl *self);
 
 gboolean adap_get_disable_portal (void);
@@ -66,6 +72,7 @@ AdapSettingsImpl *adap_settings_impl_win32_new (gboolean enable_color_scheme,
 
 G_DECLARE_FINAL_TYPE (AdapSettingsImplPortal, adap_settings_impl_portal, ADAP, SETTINGS_IMPL_PORTAL, AdapSettingsImpl)
 
+ADAP_AVAILABLE_IN_ALL
 AdapSettingsImpl *adap_settings_impl_portal_new (gboolean enable_theme_name,
                                                gboolean enable_color_scheme,
                                                gboolean enable_high_contrast) G_GNUC_WARN_UNUSED_RESULT;
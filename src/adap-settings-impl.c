@@ -30,6 +30,7 @@ enum {
   SIGNAL_COLOR_SCHEME_CHANGED,
   SIGNAL_HIGH_CONTRAST_CHANGED,
   SIGNAL_THEME_NAME_CHANGED,
+  SIGNAL_FEATURES_CHANGED,
   SIGNAL_LAST_SIGNAL,
 };
 
@@ -76,6 +77,21 @@ adap_settings_impl_class_init (AdapSettingsImplClass *klass)
   g_signal_set_va_marshaller (signals[SIGNAL_HIGH_CONTRAST_CHANGED],
                               G_TYPE_FROM_CLASS (klass),
                               adap_marshal_VOID__BOOLEANv);
+
+  /* Emitted when the implementation finds out which settings it provides
+   * after it has been created, e.g. once an asynchronous call returns */
+  signals[SIGNAL_FEATURES_CHANGED] =
+    g_signal_new ("features-changed",
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_FIRST,
+                  0,
+                  NULL, NULL,
+                  adap_marshal_VOID__VOID,
+                  G_TYPE_NONE,
+                  0);
+  g_signal_set_va_marshaller (signals[SIGNAL_FEATURES_CHANGED],
+                              G_TYPE_FROM_CLASS (klass),
+                              adap_marshal_VOID__VOIDv);
 }
 
 static void
@@ -123,9 +139,20 @@ adap_settings_impl_set_features (AdapSettingsImpl *self,
 
   g_return_if_fail (ADAP_IS_SETTINGS_IMPL (self));
 
-  priv->has_theme_name = !!has_theme_name;
-  priv->has_color_scheme = !!has_color_scheme;
-  priv->has_high_contrast = !!has_high_contrast;
+  has_theme_name = !!has_theme_name;
+  has_color_scheme = !!has_color_scheme;
+  has_high_contrast = !!has_high_contrast;
+
+  if (priv->has_theme_name == has_theme_name &&
+      priv->has_color_scheme == has_color_scheme &&
+      priv->has_high_contrast == has_high_contrast)
+    return;
+
+  priv->has_theme_name = has_theme_name;
+  priv->has_color_scheme = has_color_scheme;
+  priv->has_high_contrast = has_high_contrast;
+
+  g_signal_emit (G_OBJECT (self), signals[SIGNAL_FEATURES_CHANGED], 0);
 }
 
 AdapSystemColorScheme
@@ -164,6 +164,43 @@ register_impl (AdapSettings      *self,
   }
 }
 
+static void
+platform_features_changed_cb (AdapSettings *self)
+{
+  gboolean found_theme_name = FALSE;
+  gboolean found_color_scheme = FALSE;
+  gboolean found_high_contrast = FALSE;
+  AdapSettingsImpl *fallbacks[] = { self->gsettings_impl, self->legacy_impl };
+  gsize i;
+
+  /* The platform settings take precedence over the fallbacks that have been
+   * used until they arrived */
+  for (i = 0; i < G_N_ELEMENTS (fallbacks); i++) {
+    if (!fallbacks[i])
+      continue;
+
+    if (adap_settings_impl_get_has_theme_name (self->platform_impl))
+      g_signal_handlers_disconnect_by_func (fallbacks[i], set_theme_name, self);
+    if (adap_settings_impl_get_has_color_scheme (self->platform_impl))
+      g_signal_handlers_disconnect_by_func (fallbacks[i], set_color_scheme, self);
+    if (adap_settings_impl_get_has_high_contrast (self->platform_impl))
+      g_signal_handlers_disconnect_by_func (fallbacks[i], set_high_contrast, self);
+  }
+
+  g_signal_handlers_disconnect_by_func (self->platform_impl, set_theme_name, self);
+  g_signal_handlers_disconnect_by_func (self->platform_impl, set_color_scheme, self);
+  g_signal_handlers_disconnect_by_func (self->platform_impl, set_high_contrast, self);
+
+  register_impl (self, self->platform_impl, &found_theme_name, &found_color_scheme, &found_high_contrast);
+
+  if (found_color_scheme && !self->system_supports_color_schemes) {
+    self->system_supports_color_schemes = TRUE;
+
+    if (!self->override)
+      g_object_notify_by_pspec (G_OBJECT (self), props[PROP_SYSTEM_SUPPORTS_COLOR_SCHEMES]);
+  }
+}
+
 static void
 adap_settings_constructed (GObject *object)
 {
@@ -186,6 +223,9 @@ adap_settings_constructed (GObject *object)
 #endif
 
     register_impl (self, self->platform_impl, &found_theme_name, &found_color_scheme, &found_high_contrast);
+
+    g_signal_connect_swapped (self->platform_impl, "features-changed",
+                              G_CALLBACK (platform_features_changed_cb), self);
   }
 
   if (!found_theme_name || !found_color_scheme || !found_high_contrast) {
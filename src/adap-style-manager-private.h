@@ -18,4 +18,8 @@ G_BEGIN_DECLS
 
 void adap_style_manager_ensure (void);
 
+void adap_style_manager_ensure_fragment (const char *name);
+
+void adap_style_manager_preload_variants (AdapStyleManager *self);
+
 G_END_DECLS
@@ -52,8 +52,14 @@ struct _AdapStyleManager
   GdkDisplay *display;
   AdapSettings *settings;
   GtkCssProvider *provider;
+  GtkCssProvider *fragments_provider;
   GtkCssProvider *colors_provider;
 
+  /* Parsed stylesheets keyed by path, kept around to switch between them */
+  GHashTable *providers;
+  guint preload_idle_id;
+  guint preload_variant;
+
   AdapColorScheme color_scheme;
   gboolean dark;
   gboolean setting_dark;
@@ -79,6 +85,21 @@ static GParamSpec *props[LAST_PROP];
 static GHashTable *display_style_managers = NULL;
 static AdapStyleManager *default_instance = NULL;
 
+/* Names of the widget stylesheets requested so far, in order */
+static GPtrArray *required_fragments = NULL;
+
+typedef struct {
+  gchar *theme_path;
+  gchar *base_path;
+  gchar *colors_path;
+} ThemeLookup;
+
+/* Resolved theme paths keyed by theme name, high contrast and dark, cleared
+ * whenever any of the directories they were looked up in changes */
+static GHashTable *theme_cache = NULL;
+static GHashTable *theme_monitors = NULL;
+static gboolean theme_monitors_failed = FALSE;
+
 static void
 debug_theme_valist (const gchar *format,
                     va_list      args)
@@ -154,6 +175,89 @@ enable_animations_cb (AdapStyleManager *self)
   self->animation_timeout_id = 0;
 }
 
+static void
+theme_lookup_free (ThemeLookup *lookup)
+{
+  g_free (lookup->theme_path);
+  g_free (lookup->base_path);
+  g_free (lookup->colors_path);
+  g_free (lookup);
+}
+
+static gboolean
+is_theme_provider (const gchar    *key,
+                   GtkCssProvider *provider,
+                   gpointer        user_data)
+{
+  return !g_str_has_prefix (key, "resource://");
+}
+
+static void update_stylesheet (AdapStyleManager *self);
+
+static void
+theme_dir_changed_cb (GFileMonitor      *monitor,
+                      GFile             *file,
+                      GFile             *other_file,
+                      GFileMonitorEvent  event_type)
+{
+  GHashTableIter iter;
+  AdapStyleManager *manager;
+
+  /* Wait for the last change when a file is being written */
+  if (event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED ||
+      event_type == G_FILE_MONITOR_EVENT_CHANGED)
+    return;
+
+  /* Editing a file doesn't change where themes are found */
+  if (event_type != G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT)
+    {
+      debug_theme ("Theme directories changed, clearing theme cache.");
+
+      g_hash_table_remove_all (theme_cache);
+    }
+
+  if (!display_style_managers)
+    return;
+
+  /* The stylesheets may have been edited, so parse them again right away */
+  g_hash_table_iter_init (&iter, display_style_managers);
+
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &manager))
+    {
+      if (!manager->providers)
+        continue;
+
+      g_hash_table_foreach_remove (manager->providers, (GHRFunc) is_theme_provider, NULL);
+
+      update_stylesheet (manager);
+    }
+}
+
+static void
+watch_theme_dir (const gchar *path)
+{
+  g_autoptr (GFile) file = NULL;
+  g_autoptr (GError) error = NULL;
+  GFileMonitor *monitor;
+
+  if (g_hash_table_contains (theme_monitors, path))
+    return;
+
+  file = g_file_new_for_path (path);
+  monitor = g_file_monitor_directory (file, G_FILE_MONITOR_WATCH_MOVES, NULL, &error);
+
+  if (!monitor)
+    {
+      debug_theme ("Unable to monitor '%s', not caching themes: %s", path, error->message);
+      theme_monitors_failed = TRUE;
+      return;
+    }
+
+  g_signal_connect (monitor, "changed", G_CALLBACK (theme_dir_changed_cb), NULL);
+
+  g_hash_table_insert (theme_monitors, g_strdup (path), monitor);
+}
+
 static gboolean
 find_theme_dir_each (const gchar  *dir,
                      const gchar  *subdir,
@@ -172,6 +276,7 @@ find_theme_dir_each (const gchar  *dir,
   g_autofree gchar *base_path = NULL;
   g_autofree gchar *colors_path = NULL;
   g_autofree gchar *version_dir = NULL;
+  g_autofree gchar *version_path = NULL;
 
   g_clear_pointer (found_theme_path, g_free);
   g_clear_pointer (found_base_path, g_free);
@@ -192,6 +297,8 @@ find_theme_dir_each (const gchar  *dir,
 
   debug_theme ("Looking for theme '%s' in '%s'", name, top_theme_dir);
 
+  watch_theme_dir (top_theme_dir);
+
   if (!g_file_test (parent_dir, G_FILE_TEST_EXISTS))
     {
       return FALSE;
@@ -203,6 +310,11 @@ find_theme_dir_each (const gchar  *dir,
   base_path = g_build_filename (parent_dir, version_dir, base_file, NULL);
   colors_path = g_build_filename (parent_dir, version_dir, color_file, NULL);
 
+  version_path = g_build_filename (parent_dir, version_dir, NULL);
+
+  /* Variants can be added or removed later */
+  watch_theme_dir (version_path);
+
   if (g_file_test (base_path, G_FILE_TEST_EXISTS))
     {
       *found_base_path = g_strdup (base_path);
@@ -271,6 +383,321 @@ find_theme_dir (const gchar  *name,
   return FALSE;
 }
 
+static gboolean
+find_theme_dir_cached (const gchar  *name,
+                       gboolean      hc,
+                       gboolean      dark,
+                       gchar       **found_theme_path,
+                       gchar       **found_base_path,
+                       gchar       **found_colors_path)
+{
+  g_autofree gchar *key = NULL;
+  ThemeLookup *lookup;
+
+  if (G_UNLIKELY (!theme_cache))
+    {
+      theme_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                           (GDestroyNotify) theme_lookup_free);
+      theme_monitors = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                              g_object_unref);
+    }
+
+  key = g_strdup_printf ("%s:%d:%d", name, !!hc, !!dark);
+  lookup = g_hash_table_lookup (theme_cache, key);
+
+  if (!lookup)
+    {
+      lookup = g_new0 (ThemeLookup, 1);
+
+      if (!find_theme_dir (name, hc, dark,
+                           &lookup->theme_path,
+                           &lookup->base_path,
+                           &lookup->colors_path))
+        {
+          g_clear_pointer (&lookup->theme_path, g_free);
+          g_clear_pointer (&lookup->base_path, g_free);
+          g_clear_pointer (&lookup->colors_path, g_free);
+        }
+
+      /* Without monitors we'd never notice changes, so look up every time */
+      if (theme_monitors_failed)
+        {
+          gboolean found = lookup->theme_path != NULL;
+
+          *found_theme_path = g_steal_pointer (&lookup->theme_path);
+          *found_base_path = g_steal_pointer (&lookup->base_path);
+          *found_colors_path = g_steal_pointer (&lookup->colors_path);
+
+          theme_lookup_free (lookup);
+
+          return found;
+        }
+
+      g_hash_table_insert (theme_cache, g_steal_pointer (&key), lookup);
+    }
+  else
+    {
+      debug_theme ("Using cached lookup for theme '%s'.", name);
+    }
+
+  if (!lookup->theme_path)
+    return FALSE;
+
+  *found_theme_path = g_strdup (lookup->theme_path);
+  *found_base_path = g_strdup (lookup->base_path);
+  *found_colors_path = g_strdup (lookup->colors_path);
+
+  return TRUE;
+}
+
+static GtkCssProvider *
+get_provider (AdapStyleManager *self,
+              const gchar     *path,
+              gboolean         is_resource)
+{
+  g_autofree gchar *key = NULL;
+  GtkCssProvider *provider;
+
+  if (is_resource)
+    key = g_strconcat ("resource://", path, NULL);
+  else
+    key = g_strdup (path);
+
+  provider = g_hash_table_lookup (self->providers, key);
+
+  /* Without monitors we wouldn't notice the file changing, so parse it again.
+   * The installed provider keeps its own reference when it's replaced. */
+  if (provider && (is_resource || !theme_monitors_failed))
+    return provider;
+
+  provider = gtk_css_provider_new ();
+
+  if (is_resource)
+    gtk_css_provider_load_from_resource (provider, path);
+  else
+    gtk_css_provider_load_from_path (provider, path);
+
+  g_hash_table_insert (self->providers, g_steal_pointer (&key), provider);
+
+  return provider;
+}
+
+static void
+append_fragment (GString     *css,
+                 const gchar *theme_dir,
+                 const gchar *name,
+                 gboolean     hc)
+{
+  g_autofree gchar *filename = NULL;
+  g_autofree gchar *path = NULL;
+
+  filename = g_strdup_printf ("fragment-%s%s.css", name, hc ? "-hc" : "");
+
+  /* Themes without fragments style these widgets in their base stylesheet,
+   * the bundled fragments would override that */
+  if (theme_dir)
+    {
+      g_autofree gchar *contents = NULL;
+
+      path = g_build_filename (theme_dir, filename, NULL);
+
+      if (g_file_get_contents (path, &contents, NULL, NULL))
+        g_string_append_printf (css, "%s\n", contents);
+    }
+  else
+    {
+      g_autoptr (GBytes) bytes = NULL;
+
+      path = g_strconcat ("/org/gnome/Adapta/styles/", filename, NULL);
+      bytes = g_resources_lookup_data (path, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+
+      if (bytes)
+        {
+          g_string_append_len (css,
+                               g_bytes_get_data (bytes, NULL),
+                               g_bytes_get_size (bytes));
+          g_string_append_c (css, '\n');
+        }
+    }
+}
+
+/* The fragments are loaded into a single provider that's installed right
+ * after the base stylesheet, where they would be if they were part of it.
+ * When another fragment is required, the provider is reloaded in place so
+ * that it keeps its position relative to other providers */
+static GtkCssProvider *
+get_fragments_provider (AdapStyleManager *self,
+                        const gchar     *theme_dir,
+                        gboolean         hc)
+{
+  g_autofree gchar *key = NULL;
+  g_autoptr (GString) css = NULL;
+  GtkCssProvider *provider;
+  guint n_fragments = required_fragments ? required_fragments->len : 0;
+  guint i;
+
+  if (theme_dir)
+    key = g_strdup_printf ("%s/fragments%s", theme_dir, hc ? "-hc" : "");
+  else
+    key = g_strdup_printf ("resource://fragments%s", hc ? "-hc" : "");
+
+  provider = g_hash_table_lookup (self->providers, key);
+
+  if (provider &&
+      GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (provider), "n-fragments")) == n_fragments &&
+      (!theme_dir || !theme_monitors_failed))
+    return provider;
+
+  if (!provider)
+    {
+      provider = gtk_css_provider_new ();
+      g_hash_table_insert (self->providers, g_steal_pointer (&key), provider);
+    }
+
+  css = g_string_new (NULL);
+
+  for (i = 0; i < n_fragments; i++)
+    append_fragment (css, theme_dir, g_ptr_array_index (required_fragments, i), hc);
+
+  gtk_css_provider_load_from_string (provider, css->str);
+
+  g_object_set_data (G_OBJECT (provider), "n-fragments", GUINT_TO_POINTER (n_fragments));
+
+  return provider;
+}
+
+static void
+get_variant_providers (AdapStyleManager  *self,
+                       gboolean          hc,
+                       gboolean          dark,
+                       GtkCssProvider  **provider,
+                       GtkCssProvider  **fragments_provider,
+                       GtkCssProvider  **colors_provider)
+{
+  const gchar *theme_name = adap_settings_get_theme_name (self->settings);
+  g_autofree gchar *found_theme_path = NULL;
+  g_autofree gchar *found_base_path = NULL;
+  g_autofree gchar *found_colors_path = NULL;
+
+  if (find_theme_dir_cached (theme_name, hc, dark,
+                             &found_theme_path,
+                             &found_base_path,
+                             &found_colors_path))
+    {
+      g_autofree gchar *version_path = g_path_get_dirname (found_base_path);
+
+      debug_theme ("Using theme '%s' found in %s.", theme_name, found_theme_path);
+
+      *provider = get_provider (self, found_base_path, FALSE);
+      *colors_provider = get_provider (self, found_colors_path, FALSE);
+
+      *fragments_provider = get_fragments_provider (self, version_path, hc);
+
+      return;
+    }
+
+  debug_theme ("No libadapta support in system theme, using default style.");
+
+  if (hc)
+    *provider = get_provider (self, "/org/gnome/Adapta/styles/base-hc.css", TRUE);
+  else
+    *provider = get_provider (self, "/org/gnome/Adapta/styles/base.css", TRUE);
+
+  if (dark)
+    *colors_provider = get_provider (self, "/org/gnome/Adapta/styles/defaults-dark.css", TRUE);
+  else
+    *colors_provider = get_provider (self, "/org/gnome/Adapta/styles/defaults-light.css", TRUE);
+
+  *fragments_provider = get_fragments_provider (self, NULL, hc);
+}
+
+static void
+install_providers (AdapStyleManager *self,
+                   GtkCssProvider  *provider,
+                   GtkCssProvider  *fragments_provider,
+                   GtkCssProvider  *colors_provider)
+{
+  if (self->provider == provider &&
+      self->fragments_provider == fragments_provider &&
+      self->colors_provider == colors_provider)
+    return;
+
+  if (self->provider)
+    gtk_style_context_remove_provider_for_display (self->display,
+                                                   GTK_STYLE_PROVIDER (self->provider));
+  if (self->fragments_provider)
+    gtk_style_context_remove_provider_for_display (self->display,
+                                                   GTK_STYLE_PROVIDER (self->fragments_provider));
+  if (self->colors_provider)
+    gtk_style_context_remove_provider_for_display (self->display,
+                                                   GTK_STYLE_PROVIDER (self->colors_provider));
+
+  g_set_object (&self->provider, provider);
+  g_set_object (&self->fragments_provider, fragments_provider);
+  g_set_object (&self->colors_provider, colors_provider);
+
+  /* Colors must be added last to take precedence over the base stylesheet */
+  gtk_style_context_add_provider_for_display (self->display,
+                                              GTK_STYLE_PROVIDER (self->provider),
+                                              GTK_STYLE_PROVIDER_PRIORITY_THEME);
+  gtk_style_context_add_provider_for_display (self->display,
+                                              GTK_STYLE_PROVIDER (self->fragments_provider),
+                                              GTK_STYLE_PROVIDER_PRIORITY_THEME);
+  gtk_style_context_add_provider_for_display (self->display,
+                                              GTK_STYLE_PROVIDER (self->colors_provider),
+                                              GTK_STYLE_PROVIDER_PRIORITY_THEME);
+}
+
+/* Parses the stylesheets for the other color scheme and high contrast ahead
+ * of time, one variant per iteration, so that the first switch doesn't have to */
+static gboolean
+preload_cb (AdapStyleManager *self)
+{
+  gboolean hc = adap_settings_get_high_contrast (self->settings);
+
+  while (self->preload_variant < 4) {
+    gboolean variant_hc = !!(self->preload_variant & 2);
+    gboolean variant_dark = !!(self->preload_variant & 1);
+    GtkCssProvider *provider, *fragments_provider, *colors_provider;
+
+    self->preload_variant++;
+
+    if (variant_hc == hc && variant_dark == self->dark)
+      continue;
+
+    get_variant_providers (self,
+                           variant_hc,
+                           variant_dark,
+                           &provider,
+                           &fragments_provider,
+                           &colors_provider);
+
+    return G_SOURCE_CONTINUE;
+  }
+
+  self->preload_idle_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+update_providers (AdapStyleManager *self)
+{
+  GtkCssProvider *provider, *fragments_provider, *colors_provider;
+
+  if (!self->providers)
+    return;
+
+  get_variant_providers (self,
+                         adap_settings_get_high_contrast (self->settings),
+                         self->dark,
+                         &provider,
+                         &fragments_provider,
+                         &colors_provider);
+
+  install_providers (self, provider, fragments_provider, colors_provider);
+}
+
 static void
 update_stylesheet (AdapStyleManager *self)
 {
@@ -296,49 +723,7 @@ update_stylesheet (AdapStyleManager *self)
 
   self->setting_dark = FALSE;
 
-  gchar *found_theme_path = NULL;
-  gchar *found_base_path = NULL;
-  gchar *found_colors_path = NULL;
-
-  if (find_theme_dir (adap_settings_get_theme_name (self->settings),
-                      adap_settings_get_high_contrast (self->settings),
-                      self->dark,
-                      &found_theme_path,
-                      &found_base_path,
-                      &found_colors_path))
-    {
-      debug_theme ("Using theme '%s' found in %s.", adap_settings_get_theme_name (self->settings), found_theme_path);
-
-      if (self->provider)
-        gtk_css_provider_load_from_path (self->provider, found_base_path);
-      if (self->colors_provider)
-        gtk_css_provider_load_from_path (self->colors_provider, found_colors_path);
-
-      g_free (found_theme_path);
-      g_free (found_base_path);
-      g_free (found_colors_path);
-    }
-  else
-    {
-      debug_theme ("No libadapta support in system theme, using default style.");
-      if (self->provider) {
-        if (adap_settings_get_high_contrast (self->settings))
-          gtk_css_provider_load_from_resource (self->provider,
-                                               "/org/gnome/Adapta/styles/base-hc.css");
-        else
-          gtk_css_provider_load_from_resource (self->provider,
-                                               "/org/gnome/Adapta/styles/base.css");
-      }
-
-      if (self->colors_provider) {
-        if (self->dark)
-          gtk_css_provider_load_from_resource (self->colors_provider,
-                                               "/org/gnome/Adapta/styles/defaults-dark.css");
-        else
-          gtk_css_provider_load_from_resource (self->colors_provider,
-                                               "/org/gnome/Adapta/styles/defaults-light.css");
-      }
-    }
+  update_providers (self);
 
   self->animation_timeout_id =
     g_timeout_add_once (SWITCH_DURATION,
@@ -401,6 +786,10 @@ notify_high_contrast_cb (AdapStyleManager *self)
 static void
 notify_theme_name_cb (AdapStyleManager *self)
 {
+  /* Stylesheets from the previous theme won't be needed anymore */
+  if (self->providers)
+    g_hash_table_foreach_remove (self->providers, (GHRFunc) is_theme_provider, NULL);
+
   update_stylesheet (self);
 }
 
@@ -433,15 +822,8 @@ adap_style_manager_constructed (GObject *object)
                     "gtk-theme-name", "Adapta-empty",
                     NULL);
 
-      self->provider = gtk_css_provider_new ();
-      gtk_style_context_add_provider_for_display (self->display,
-                                                  GTK_STYLE_PROVIDER (self->provider),
-                                                  GTK_STYLE_PROVIDER_PRIORITY_THEME);
-
-      self->colors_provider = gtk_css_provider_new ();
-      gtk_style_context_add_provider_for_display (self->display,
-                                                  GTK_STYLE_PROVIDER (self->colors_provider),
-                                                  GTK_STYLE_PROVIDER_PRIORITY_THEME);
+      self->providers = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                               g_free, g_object_unref);
     }
 
     self->animations_provider = gtk_css_provider_new ();
@@ -482,8 +864,11 @@ adap_style_manager_dispose (GObject *object)
   AdapStyleManager *self = ADAP_STYLE_MANAGER (object);
 
   g_clear_handle_id (&self->animation_timeout_id, g_source_remove);
+  g_clear_handle_id (&self->preload_idle_id, g_source_remove);
   g_clear_object (&self->provider);
   g_clear_object (&self->colors_provider);
+  g_clear_pointer (&self->providers, g_hash_table_unref);
+  g_clear_object (&self->fragments_provider);
   g_clear_object (&self->animations_provider);
 
   G_OBJECT_CLASS (adap_style_manager_parent_class)->dispose (object);
@@ -688,6 +1073,63 @@ adap_style_manager_ensure (void)
   g_slist_free (displays);
 }
 
+/*
+ * adap_style_manager_preload_variants:
+ * @self: a style manager
+ *
+ * Parses the stylesheets for the other color scheme and high contrast in idle
+ * time, so that switching to them for the first time doesn't have to.
+ */
+void
+adap_style_manager_preload_variants (AdapStyleManager *self)
+{
+  g_return_if_fail (ADAP_IS_STYLE_MANAGER (self));
+
+  if (!self->providers || self->preload_idle_id)
+    return;
+
+  self->preload_variant = 0;
+  self->preload_idle_id =
+    g_idle_add_full (G_PRIORITY_LOW,
+                     G_SOURCE_FUNC (preload_cb),
+                     self, NULL);
+  g_source_set_name_by_id (self->preload_idle_id, "[adap] preload_cb");
+}
+
+/*
+ * adap_style_manager_ensure_fragment:
+ * @name: the name of the fragment, e.g. "tab-view"
+ *
+ * Makes sure the stylesheet fragment @name is loaded for every display.
+ *
+ * Stylesheets for widgets that most applications don't use are kept out of
+ * the base stylesheet. Widgets using them must call this in their class_init.
+ */
+void
+adap_style_manager_ensure_fragment (const char *name)
+{
+  GHashTableIter iter;
+  AdapStyleManager *manager;
+  guint i;
+
+  if (!required_fragments)
+    required_fragments = g_ptr_array_new ();
+
+  for (i = 0; i < required_fragments->len; i++)
+    if (!g_strcmp0 (g_ptr_array_index (required_fragments, i), name))
+      return;
+
+  g_ptr_array_add (required_fragments, (gpointer) g_intern_string (name));
+
+  if (!display_style_managers)
+    return;
+
+  g_hash_table_iter_init (&iter, display_style_managers);
+
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &manager))
+    update_providers (manager);
+}
+
 /**
  * adap_style_manager_get_default:
  *
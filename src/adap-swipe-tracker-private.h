@@ -18,4 +18,15 @@ G_BEGIN_DECLS
 
 void adap_swipe_tracker_reset (AdapSwipeTracker *self);
 
+ADAP_AVAILABLE_IN_ALL
+void adap_swipe_tracker_replay_begin  (AdapSwipeTracker        *self,
+                                       AdapNavigationDirection  direction);
+ADAP_AVAILABLE_IN_ALL
+void adap_swipe_tracker_replay_update (AdapSwipeTracker        *self,
+                                       double                  delta,
+                                       guint32                 time);
+ADAP_AVAILABLE_IN_ALL
+void adap_swipe_tracker_replay_end    (AdapSwipeTracker        *self,
+                                       guint32                 time);
+
 G_END_DECLS
@@ -10,6 +10,7 @@
 
 #include "adap-marshalers.h"
 #include "adap-navigation-direction.h"
+#include "adap-swipeable-private.h"
 
 #include <math.h>
 
@@ -29,6 +30,8 @@
 #define DRAG_THRESHOLD_DISTANCE 16
 #define EPSILON 0.005
 #define OVERSHOOT_DISTANCE_MULTIPLIER 0.1
+#define DEFAULT_REFRESH_INTERVAL_US 16667
+#define MAX_PREDICTION_MS 50
 
 #define SIGN(x) ((x) > 0.0 ? 1.0 : ((x) < 0.0 ? -1.0 : 0.0))
 
@@ -46,6 +49,19 @@
  * property. If they expect to use horizontal orientation,
  * [property@SwipeTracker:reversed] can be used for supporting RTL text
  * direction.
+ *
+ * ## Latency Compensation
+ *
+ * By default, the progress reported via [signal@SwipeTracker::update-swipe]
+ * follows the input events exactly, so what's on screen lags behind the finger
+ * by the time it takes to present the next frame. If
+ * [property@SwipeTracker:predict-progress] is set to `TRUE`, the progress is
+ * instead extrapolated to the expected presentation time of the next frame,
+ * using the current swipe velocity.
+ *
+ * Setting the `ADAP_SWIPE_PREDICTION` environment variable to `1` enables it
+ * by default for all swipe trackers, including the ones used internally by
+ * widgets such as [class@Carousel] or [class@NavigationView].
  */
 
 typedef enum {
@@ -74,6 +90,7 @@ struct _AdapSwipeTracker
   gboolean lower_overshoot;
   gboolean upper_overshoot;
   gboolean allow_window_handle;
+  gboolean predict_progress;
 
   double pointer_x;
   double pointer_y;
@@ -109,10 +126,11 @@ enum {
   PROP_LOWER_OVERSHOOT,
   PROP_UPPER_OVERSHOOT,
   PROP_ALLOW_WINDOW_HANDLE,
+  PROP_PREDICT_PROGRESS,
 
   /* GtkOrientable */
   PROP_ORIENTATION,
-  LAST_PROP = PROP_ALLOW_WINDOW_HANDLE + 1,
+  LAST_PROP = PROP_PREDICT_PROGRESS + 1,
 };
 
 static GParamSpec *props[LAST_PROP];
@@ -177,15 +195,13 @@ get_range (AdapSwipeTracker *self,
            double          *first,
            double          *last)
 {
-  double *points;
+  const double *points;
   int n;
 
-  points = adap_swipeable_get_snap_points (self->swipeable, &n);
+  points = adap_swipeable_peek_snap_points (self->swipeable, &n);
 
   *first = points[0];
   *last = points[n - 1];
-
-  g_free (points);
 }
 
 static void
@@ -202,51 +218,98 @@ gesture_prepare (AdapSwipeTracker        *self,
   self->state = ADAP_SWIPE_TRACKER_STATE_PENDING;
 }
 
+/* Snap points are sorted in ascending order, so we can bisect them.
+ * Returns the index of the first point not smaller than @pos, or @n. */
 static int
-find_closest_point (double *points,
-                    int     n,
-                    double  pos)
+find_lower_bound (const double *points,
+                  int           n,
+                  double        pos)
 {
-  guint i, min = 0;
+  int lower = 0, upper = n;
+
+  while (lower < upper) {
+    int mid = lower + (upper - lower) / 2;
 
-  for (i = 1; i < n; i++)
-    if (ABS (points[i] - pos) < ABS (points[min] - pos))
-      min = i;
+    if (points[mid] < pos)
+      lower = mid + 1;
+    else
+      upper = mid;
+  }
 
-  return min;
+  return lower;
 }
 
+/* Returns the index of the first point greater than @pos, or @n. */
 static int
-find_next_point (double *points,
-                 int     n,
-                 double  pos)
+find_upper_bound (const double *points,
+                  int           n,
+                  double        pos)
 {
-  guint i;
+  int lower = 0, upper = n;
 
-  for (i = 0; i < n; i++)
-    if (G_APPROX_VALUE (points[i], pos, DBL_EPSILON) || points[i] > pos)
-      return i;
+  while (lower < upper) {
+    int mid = lower + (upper - lower) / 2;
 
-  return -1;
+    if (points[mid] <= pos)
+      lower = mid + 1;
+    else
+      upper = mid;
+  }
+
+  return lower;
 }
 
 static int
-find_previous_point (double *points,
-                     int     n,
-                     double  pos)
+find_closest_point (const double *points,
+                    int           n,
+                    double        pos)
 {
   int i;
 
-  for (i = n - 1; i >= 0; i--)
-    if (G_APPROX_VALUE (points[i], pos, DBL_EPSILON) || points[i] < pos)
-      return i;
+  /* Same as the first point, without reading past an empty array */
+  if (n == 0)
+    return 0;
+
+  i = find_lower_bound (points, n, pos);
 
-  return -1;
+  /* On ties, prefer the first of the equally close points */
+  if (i == n || (i > 0 && ABS (points[i - 1] - pos) <= ABS (points[i] - pos)))
+    i = find_lower_bound (points, n, points[i - 1]);
+
+  return i;
+}
+
+static int
+find_next_point (const double *points,
+                 int           n,
+                 double        pos)
+{
+  int i = find_lower_bound (points, n, pos);
+
+  /* Points just below @pos count as equal to it */
+  while (i > 0 && G_APPROX_VALUE (points[i - 1], pos, DBL_EPSILON))
+    i--;
+
+  return i < n ? i : -1;
+}
+
+static int
+find_previous_point (const double *points,
+                     int           n,
+                     double        pos)
+{
+  int i = find_upper_bound (points, n, pos);
+
+  /* Points just above @pos count as equal to it */
+  while (i < n && G_APPROX_VALUE (points[i], pos, DBL_EPSILON))
+    i++;
+
+  return i - 1;
 }
 
 static void
 get_bounds (AdapSwipeTracker *self,
-            double          *points,
+            const double    *points,
             int              n,
             double           pos,
             double          *lower,
@@ -310,13 +373,11 @@ append_to_history (AdapSwipeTracker *self,
 }
 
 static double
-calculate_velocity (AdapSwipeTracker *self)
+calculate_raw_velocity (AdapSwipeTracker *self)
 {
-  double total_delta = 0, velocity, lower, upper;
-  double *points;
+  double total_delta = 0;
   guint32 first_time = 0, last_time = 0;
   guint i;
-  int n;
 
   for (i = 0; i < self->event_history->len; i++) {
     EventHistoryRecord *r =
@@ -333,16 +394,28 @@ calculate_velocity (AdapSwipeTracker *self)
   if (first_time == last_time)
     return 0;
 
-  velocity = total_delta / (last_time - first_time);
+  return total_delta / (last_time - first_time);
+}
+
+static double
+calculate_velocity (AdapSwipeTracker *self)
+{
+  double velocity, lower, upper;
+  const double *points;
+  int n;
+
+  velocity = calculate_raw_velocity (self);
 
   /* Overshoot */
 
-  points = adap_swipeable_get_snap_points (self->swipeable, &n);
+  points = adap_swipeable_peek_snap_points (self->swipeable, &n);
 
-  if (!self->allow_long_swipes)
+  if (!self->allow_long_swipes) {
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
-  else
-    get_range (self, &lower, &upper);
+  } else {
+    lower = points[0];
+    upper = points[n - 1];
+  }
 
   if (self->progress <= lower) {
     if (self->lower_overshoot && self->progress > lower)
@@ -374,7 +447,7 @@ gesture_begin (AdapSwipeTracker *self)
 
 static int
 find_point_for_projection (AdapSwipeTracker *self,
-                           double          *points,
+                           const double    *points,
                            int              n,
                            double           pos,
                            double           velocity)
@@ -389,9 +462,70 @@ find_point_for_projection (AdapSwipeTracker *self,
   return find_closest_point (points, n, pos);
 }
 
+static double
+apply_overshoot (AdapSwipeTracker *self,
+                 double           progress,
+                 double           lower,
+                 double           upper)
+{
+  if (progress < lower) {
+    if (self->lower_overshoot)
+      return lower - adjust_for_overshoot (self, lower - progress);
+
+    return lower;
+  }
+
+  if (progress > upper) {
+    if (self->upper_overshoot)
+      return upper + adjust_for_overshoot (self, progress - upper);
+
+    return upper;
+  }
+
+  return progress;
+}
+
+/* Returns how far ahead of @time, in milliseconds, the next frame is expected
+ * to be presented */
+static double
+get_prediction_interval (AdapSwipeTracker *self,
+                         guint32          time)
+{
+  GdkFrameClock *frame_clock;
+  gint64 refresh_interval = DEFAULT_REFRESH_INTERVAL_US;
+  gint64 presentation_time = 0;
+  double interval;
+
+  frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (self->swipeable));
+
+  if (frame_clock) {
+    gdk_frame_clock_get_refresh_info (frame_clock,
+                                      gdk_frame_clock_get_frame_time (frame_clock),
+                                      &refresh_interval,
+                                      &presentation_time);
+
+    if (refresh_interval <= 0)
+      refresh_interval = DEFAULT_REFRESH_INTERVAL_US;
+  }
+
+  /* Event times are 32-bit millisecond timestamps, so compare them modulo
+   * 2^32. They aren't guaranteed to use the same clock as the frame clock,
+   * fall back to a single refresh interval if the result doesn't make sense. */
+  if (presentation_time > 0)
+    interval = (gint32) ((guint32) (presentation_time / 1000) - time);
+  else
+    interval = -1;
+
+  if (interval <= 0 || interval > MAX_PREDICTION_MS)
+    interval = refresh_interval / 1000.0;
+
+  return MIN (interval, MAX_PREDICTION_MS);
+}
+
 static void
 gesture_update (AdapSwipeTracker *self,
                 double           delta,
+                double           distance,
                 guint32          time)
 {
   double lower, upper;
@@ -401,34 +535,31 @@ gesture_update (AdapSwipeTracker *self,
     return;
 
   if (!self->allow_long_swipes) {
-    double *points;
+    const double *points;
     int n;
 
-    points = adap_swipeable_get_snap_points (self->swipeable, &n);
+    points = adap_swipeable_peek_snap_points (self->swipeable, &n);
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
-
-    g_free (points);
   } else {
     get_range (self, &lower, &upper);
   }
 
-  progress = self->progress + delta;
+  self->progress += delta / distance;
 
-  self->progress = progress;
+  if (!self->lower_overshoot)
+    self->progress = MAX (self->progress, lower);
 
-  if (progress < lower) {
-    if (self->lower_overshoot)
-      progress = lower - adjust_for_overshoot (self, lower - progress);
-    else
-      progress = self->progress = lower;
-  }
+  if (!self->upper_overshoot)
+    self->progress = MIN (self->progress, upper);
 
-  if (progress > upper) {
-    if (self->upper_overshoot)
-      progress = upper + adjust_for_overshoot (self, progress - upper);
-    else
-      progress = self->progress = upper;
-  }
+  progress = self->progress;
+
+  /* Only the reported progress is extrapolated, self->progress keeps following
+   * the actual events so that the end of the gesture is computed from it */
+  if (self->predict_progress)
+    progress += calculate_raw_velocity (self) / distance * get_prediction_interval (self, time);
+
+  progress = apply_overshoot (self, progress, lower, upper);
 
   g_signal_emit (self, signals[SIGNAL_UPDATE_SWIPE], 0, progress);
 }
@@ -439,26 +570,26 @@ get_end_progress (AdapSwipeTracker *self,
                   gboolean         is_touchpad)
 {
   double pos, decel, slope;
-  double *points;
+  const double *points;
   int n;
   double lower, upper;
 
   if (self->cancelled)
     return adap_swipeable_get_cancel_progress (self->swipeable);
 
-  points = adap_swipeable_get_snap_points (self->swipeable, &n);
+  points = adap_swipeable_peek_snap_points (self->swipeable, &n);
 
-  if (!self->allow_long_swipes)
+  if (!self->allow_long_swipes) {
     get_bounds (self, points, n, self->initial_progress, &lower, &upper);
-  else
-    get_range (self, &lower, &upper);
+  } else {
+    lower = points[0];
+    upper = points[n - 1];
+  }
 
   if (ABS (velocity) < (is_touchpad ? VELOCITY_THRESHOLD_TOUCHPAD : VELOCITY_THRESHOLD_TOUCH)) {
     pos = points[find_closest_point (points, n, self->progress)];
     pos = CLAMP (pos, lower, upper);
 
-    g_free (points);
-
     return pos;
   }
 
@@ -481,8 +612,6 @@ get_end_progress (AdapSwipeTracker *self,
   pos = CLAMP (pos, lower, upper);
   pos = points[find_point_for_projection (self, points, n, pos, velocity)];
 
-  g_free (points);
-
   return pos;
 }
 
@@ -736,7 +865,7 @@ drag_update_cb (AdapSwipeTracker *self,
   }
 
   if (self->state == ADAP_SWIPE_TRACKER_STATE_SCROLLING)
-    gesture_update (self, delta / distance, time);
+    gesture_update (self, delta, distance, time);
 }
 
 static void
@@ -872,7 +1001,7 @@ handle_scroll_event (AdapSwipeTracker *self,
     } else {
       append_to_history (self, delta, time);
 
-      gesture_update (self, delta / distance, time);
+      gesture_update (self, delta, distance, time);
       return GDK_EVENT_STOP;
     }
   }
@@ -1106,6 +1235,10 @@ adap_swipe_tracker_get_property (GObject    *object,
     g_value_set_boolean (value, adap_swipe_tracker_get_allow_window_handle (self));
     break;
 
+  case PROP_PREDICT_PROGRESS:
+    g_value_set_boolean (value, adap_swipe_tracker_get_predict_progress (self));
+    break;
+
   case PROP_ORIENTATION:
     g_value_set_enum (value, self->orientation);
     break;
@@ -1156,6 +1289,10 @@ adap_swipe_tracker_set_property (GObject      *object,
     adap_swipe_tracker_set_allow_window_handle (self, g_value_get_boolean (value));
     break;
 
+  case PROP_PREDICT_PROGRESS:
+    adap_swipe_tracker_set_predict_progress (self, g_value_get_boolean (value));
+    break;
+
   case PROP_ORIENTATION:
     set_orientation (self, g_value_get_enum (value));
     break;
@@ -1273,6 +1410,31 @@ adap_swipe_tracker_class_init (AdapSwipeTrackerClass *klass)
                           FALSE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdapSwipeTracker:predict-progress: (attributes org.gtk.Property.get=adap_swipe_tracker_get_predict_progress org.gtk.Property.set=adap_swipe_tracker_set_predict_progress)
+   *
+   * Whether to extrapolate the progress to the next frame.
+   *
+   * If the value is `TRUE`, the progress reported during the swipe is
+   * predicted for the expected presentation time of the next frame, using the
+   * swipe velocity and the frame clock's refresh interval. This compensates
+   * for the input latency, so that the content follows the finger more
+   * closely.
+   *
+   * The predicted progress never goes past the bounds the swipe is allowed to
+   * reach, and the end of the swipe is always computed from the actual
+   * progress.
+   *
+   * The default value is `FALSE`, unless the `ADAP_SWIPE_PREDICTION`
+   * environment variable is set to `1`.
+   *
+   * Since: 1.6
+   */
+  props[PROP_PREDICT_PROGRESS] =
+    g_param_spec_boolean ("predict-progress", NULL, NULL,
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_override_property (object_class,
                                     PROP_ORIENTATION,
                                     "orientation");
@@ -1379,6 +1541,7 @@ adap_swipe_tracker_init (AdapSwipeTracker *self)
 
   self->orientation = GTK_ORIENTATION_HORIZONTAL;
   self->enabled = TRUE;
+  self->predict_progress = !g_strcmp0 (g_getenv ("ADAP_SWIPE_PREDICTION"), "1");
 }
 
 /**
@@ -1717,6 +1880,53 @@ adap_swipe_tracker_set_allow_window_handle (AdapSwipeTracker *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ALLOW_WINDOW_HANDLE]);
 }
 
+/**
+ * adap_swipe_tracker_get_predict_progress: (attributes org.gtk.Method.get_property=predict-progress)
+ * @self: a swipe tracker
+ *
+ * Gets whether to extrapolate the progress to the next frame.
+ *
+ * Returns: whether the progress is extrapolated
+ *
+ * Since: 1.6
+ */
+gboolean
+adap_swipe_tracker_get_predict_progress (AdapSwipeTracker *self)
+{
+  g_return_val_if_fail (ADAP_IS_SWIPE_TRACKER (self), FALSE);
+
+  return self->predict_progress;
+}
+
+/**
+ * adap_swipe_tracker_set_predict_progress: (attributes org.gtk.Method.set_property=predict-progress)
+ * @self: a swipe tracker
+ * @predict_progress: whether to extrapolate the progress
+ *
+ * Sets whether to extrapolate the progress to the next frame.
+ *
+ * If @predict_progress is `TRUE`, the progress reported during the swipe is
+ * predicted for the expected presentation time of the next frame, which
+ * compensates for the input latency.
+ *
+ * Since: 1.6
+ */
+void
+adap_swipe_tracker_set_predict_progress (AdapSwipeTracker *self,
+                                        gboolean         predict_progress)
+{
+  g_return_if_fail (ADAP_IS_SWIPE_TRACKER (self));
+
+  predict_progress = !!predict_progress;
+
+  if (self->predict_progress == predict_progress)
+    return;
+
+  self->predict_progress = predict_progress;
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_PREDICT_PROGRESS]);
+}
+
 /**
  * adap_swipe_tracker_shift_position:
  * @self: a swipe tracker
@@ -1756,3 +1966,33 @@ adap_swipe_tracker_reset (AdapSwipeTracker *self)
     gtk_event_controller_reset (self->scroll_controller);
 }
 
+
+void
+adap_swipe_tracker_replay_begin (AdapSwipeTracker        *self,
+                                 AdapNavigationDirection  direction)
+{
+  g_return_if_fail (ADAP_IS_SWIPE_TRACKER (self));
+
+  gesture_prepare (self, direction);
+  gesture_begin (self);
+}
+
+void
+adap_swipe_tracker_replay_update (AdapSwipeTracker *self,
+                                  double           delta,
+                                  guint32          time)
+{
+  g_return_if_fail (ADAP_IS_SWIPE_TRACKER (self));
+
+  append_to_history (self, delta, time);
+  gesture_update (self, delta, adap_swipeable_get_distance (self->swipeable), time);
+}
+
+void
+adap_swipe_tracker_replay_end (AdapSwipeTracker *self,
+                               guint32          time)
+{
+  g_return_if_fail (ADAP_IS_SWIPE_TRACKER (self));
+
+  gesture_end (self, adap_swipeable_get_distance (self->swipeable), time, FALSE);
+}
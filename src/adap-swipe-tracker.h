@@ -70,6 +70,12 @@ ADAP_AVAILABLE_IN_1_5
 void     adap_swipe_tracker_set_allow_window_handle (AdapSwipeTracker *self,
                                                     gboolean         allow_window_handle);
 
+ADAP_AVAILABLE_IN_1_6
+gboolean adap_swipe_tracker_get_predict_progress (AdapSwipeTracker *self);
+ADAP_AVAILABLE_IN_1_6
+void     adap_swipe_tracker_set_predict_progress (AdapSwipeTracker *self,
+                                                 gboolean         predict_progress);
+
 ADAP_AVAILABLE_IN_ALL
 void adap_swipe_tracker_shift_position (AdapSwipeTracker *self,
                                        double           delta);
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2019 Alice Mikhaylenko <alicem@gnome.org>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#if !defined(_ADAPTA_INSIDE) && !defined(ADAPTA_COMPILATION)
+#error "Only <adapta.h> can be included directly."
+#endif
+
+#include "adap-swipeable.h"
+
+G_BEGIN_DECLS
+
+ADAP_AVAILABLE_IN_ALL
+const double *adap_swipeable_peek_snap_points       (AdapSwipeable *self,
+                                                     int           *n_snap_points);
+ADAP_AVAILABLE_IN_ALL
+void          adap_swipeable_invalidate_snap_points (AdapSwipeable *self);
+
+G_END_DECLS
@@ -6,7 +6,7 @@
 
 #include "config.h"
 
-#include "adap-swipeable.h"
+#include "adap-swipeable-private.h"
 
 /**
  * AdapSwipeable:
@@ -20,6 +20,39 @@
 
 G_DEFINE_INTERFACE (AdapSwipeable, adap_swipeable, GTK_TYPE_WIDGET)
 
+typedef struct {
+  double *points;
+  int n_points;
+  gboolean valid;
+  gboolean managed;
+} SnapPointsCache;
+
+static GQuark snap_points_cache_quark;
+
+static void
+snap_points_cache_free (SnapPointsCache *cache)
+{
+  g_free (cache->points);
+  g_free (cache);
+}
+
+static SnapPointsCache *
+get_snap_points_cache (AdapSwipeable *self)
+{
+  SnapPointsCache *cache;
+
+  cache = g_object_get_qdata (G_OBJECT (self), snap_points_cache_quark);
+
+  if (!cache) {
+    cache = g_new0 (SnapPointsCache, 1);
+
+    g_object_set_qdata_full (G_OBJECT (self), snap_points_cache_quark, cache,
+                             (GDestroyNotify) snap_points_cache_free);
+  }
+
+  return cache;
+}
+
 static void
 adap_swipeable_default_get_swipe_area (AdapSwipeable           *self,
                                       AdapNavigationDirection  navigation_direction,
@@ -36,6 +69,8 @@ static void
 adap_swipeable_default_init (AdapSwipeableInterface *iface)
 {
   iface->get_swipe_area = adap_swipeable_default_get_swipe_area;
+
+  snap_points_cache_quark = g_quark_from_static_string ("adap-swipeable-snap-points-cache");
 }
 
 /**
@@ -87,6 +122,66 @@ adap_swipeable_get_snap_points (AdapSwipeable *self,
   return iface->get_snap_points (self, n_snap_points);
 }
 
+/*
+ * adap_swipeable_peek_snap_points:
+ * @self: a swipeable
+ * @n_snap_points: (out): location to return the number of the snap points
+ *
+ * Gets the snap points of @self without copying them.
+ *
+ * The returned array is owned by @self. If @self calls
+ * adap_swipeable_invalidate_snap_points() whenever its snap points change, it
+ * is cached between those calls, otherwise it's refreshed on every call. Either
+ * way it must not be used after the next call to this function.
+ *
+ * Returns: (array length=n_snap_points) (transfer none): the snap points
+ */
+const double *
+adap_swipeable_peek_snap_points (AdapSwipeable *self,
+                                 int           *n_snap_points)
+{
+  SnapPointsCache *cache;
+
+  g_return_val_if_fail (ADAP_IS_SWIPEABLE (self), NULL);
+
+  cache = get_snap_points_cache (self);
+
+  if (!cache->valid || !cache->managed) {
+    g_free (cache->points);
+
+    cache->points = adap_swipeable_get_snap_points (self, &cache->n_points);
+    cache->valid = TRUE;
+  }
+
+  if (n_snap_points)
+    *n_snap_points = cache->n_points;
+
+  return cache->points;
+}
+
+/*
+ * adap_swipeable_invalidate_snap_points:
+ * @self: a swipeable
+ *
+ * Drops the snap points cached by adap_swipeable_peek_snap_points().
+ *
+ * Swipeables must call this every time their snap points change, e.g. when
+ * pages are added or removed, or after their allocation has changed. Calling it
+ * once also opts @self into caching.
+ */
+void
+adap_swipeable_invalidate_snap_points (AdapSwipeable *self)
+{
+  SnapPointsCache *cache;
+
+  g_return_if_fail (ADAP_IS_SWIPEABLE (self));
+
+  cache = get_snap_points_cache (self);
+
+  cache->valid = FALSE;
+  cache->managed = TRUE;
+}
+
 /**
  * adap_swipeable_get_progress:
  * @self: a swipeable
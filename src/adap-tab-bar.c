@@ -11,6 +11,7 @@
 #include "adap-tab-bar-private.h"
 
 #include "adap-bin.h"
+#include "adap-style-manager-private.h"
 #include "adap-tab-box-private.h"
 #include "adap-widget-utils-private.h"
 
@@ -652,6 +653,8 @@ adap_tab_bar_class_init (AdapTabBarClass *klass)
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
   gtk_widget_class_set_css_name (widget_class, "tabbar");
 
+  adap_style_manager_ensure_fragment ("tab-view");
+
   g_signal_override_class_handler ("extra-drag-value", G_TYPE_FROM_CLASS (klass),
                                    G_CALLBACK (extra_drag_value_notify));
 
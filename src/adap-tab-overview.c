@@ -15,7 +15,7 @@
 #include "adap-bin.h"
 #include "adap-header-bar.h"
 #include "adap-marshalers.h"
-#include "adap-style-manager.h"
+#include "adap-style-manager-private.h"
 #include "adap-tab-grid-private.h"
 #include "adap-tab-thumbnail-private.h"
 #include "adap-tab-view-private.h"
@@ -1837,6 +1837,8 @@ adap_tab_overview_class_init (AdapTabOverviewClass *klass)
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
   gtk_widget_class_set_css_name (widget_class, "taboverview");
 
+  adap_style_manager_ensure_fragment ("tab-view");
+
   g_signal_override_class_handler ("extra-drag-value", G_TYPE_FROM_CLASS (klass),
                                    G_CALLBACK (extra_drag_value_notify));
 
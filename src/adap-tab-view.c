@@ -13,7 +13,7 @@
 #include "adap-bin.h"
 #include "adap-gizmo-private.h"
 #include "adap-marshalers.h"
-#include "adap-style-manager.h"
+#include "adap-style-manager-private.h"
 #include "adap-widget-utils-private.h"
 
 /* FIXME replace with groups */
@@ -2751,6 +2751,8 @@ adap_tab_view_class_init (AdapTabViewClass *klass)
                                    G_CALLBACK (close_page_cb));
 
   gtk_widget_class_set_css_name (widget_class, "tabview");
+
+  adap_style_manager_ensure_fragment ("tab-view");
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_GROUP);
 }
 
@@ -15,6 +15,7 @@
 #include "adap-view-stack.h"
 
 #include "adap-animation-util.h"
+#include "adap-bin.h"
 #include "adap-gizmo-private.h"
 #include "adap-widget-utils-private.h"
 
@@ -45,6 +46,18 @@
  * can obtain a [iface@Gtk.SelectionModel] containing all the pages with
  * [method@ViewStack.get_pages].
  *
+ * ## Lazy Pages
+ *
+ * Pages added with [method@ViewStack.add_lazy] only create their child the
+ * first time they become visible. Their title, icon and badge are available
+ * right away, so [class@ViewSwitcher] can show them before that.
+ *
+ * Set [property@ViewStack:unload-policy] to destroy the children of hidden
+ * lazy pages when the system is low on memory, or after they have been
+ * hidden for [property@ViewStack:unload-timeout] milliseconds. They will be
+ * created again the next time the page is shown, so any state that needs to
+ * survive this must be kept outside of the child.
+ *
  * ## AdapViewStack as GtkBuildable
  *
  * To set child-specific properties in a .ui file, create
@@ -93,6 +106,24 @@
  * Since: 1.4
  */
 
+/**
+ * AdapViewStackUnloadPolicy:
+ * @ADAP_VIEW_STACK_UNLOAD_NEVER: Children of lazy pages are kept once created
+ * @ADAP_VIEW_STACK_UNLOAD_LOW_MEMORY: Children of hidden lazy pages are
+ *   destroyed when the system is low on memory
+ * @ADAP_VIEW_STACK_UNLOAD_TIMEOUT: Same as `ADAP_VIEW_STACK_UNLOAD_LOW_MEMORY`,
+ *   and additionally children of lazy pages are destroyed after they have been
+ *   hidden for [property@ViewStack:unload-timeout] milliseconds
+ *
+ * Describes when [class@ViewStack] destroys the children of hidden lazy pages.
+ *
+ * See [method@ViewStack.add_lazy].
+ *
+ * Since: 1.6
+ */
+
+#define DEFAULT_UNLOAD_TIMEOUT 60000
+
 #define OPPOSITE_ORIENTATION(_orientation) (1 - (_orientation))
 
 enum {
@@ -102,6 +133,8 @@ enum {
   PROP_VISIBLE_CHILD,
   PROP_VISIBLE_CHILD_NAME,
   PROP_PAGES,
+  PROP_UNLOAD_POLICY,
+  PROP_UNLOAD_TIMEOUT,
   LAST_PROP
 };
 
@@ -118,6 +151,11 @@ struct _AdapViewStackPage {
   GtkATContext *at_context;
   AdapViewStackPage *next_page;
 
+  AdapViewStackChildFunc child_func;
+  gpointer child_func_data;
+  GDestroyNotify child_func_data_destroy;
+  guint unload_id;
+
   gboolean needs_attention;
   gboolean visible;
   gboolean use_underline;
@@ -139,6 +177,7 @@ enum {
   PAGE_PROP_NEEDS_ATTENTION,
   PAGE_PROP_BADGE_NUMBER,
   PAGE_PROP_VISIBLE,
+  PAGE_PROP_LOADED,
   LAST_PAGE_PROP,
   PAGE_PROP_ACCESSIBLE_ROLE
 };
@@ -164,11 +203,20 @@ struct _AdapViewStack {
 
   GList *children;
 
+  /* Indices for looking pages up without walking the list. Widgets map to
+   * their link in children, names map to the first page with that name. */
+  GHashTable *links_by_widget;
+  GHashTable *pages_by_name;
+
   AdapViewStackPage *visible_child;
 
   gboolean homogeneous[2];
 
   GtkSelectionModel *pages;
+
+  AdapViewStackUnloadPolicy unload_policy;
+  guint unload_timeout;
+  GMemoryMonitor *memory_monitor;
 };
 
 static GParamSpec *props[LAST_PROP];
@@ -215,6 +263,9 @@ adap_view_stack_page_get_property (GObject      *object,
   case PAGE_PROP_VISIBLE:
     g_value_set_boolean (value, adap_view_stack_page_get_visible (self));
     break;
+  case PAGE_PROP_LOADED:
+    g_value_set_boolean (value, adap_view_stack_page_get_loaded (self));
+    break;
   case PAGE_PROP_ACCESSIBLE_ROLE:
     g_value_set_enum (value, GTK_ACCESSIBLE_ROLE_TAB_PANEL);
     break;
@@ -276,6 +327,7 @@ adap_view_stack_page_dispose (GObject *object)
   self->in_destruction = TRUE;
 
   g_clear_object (&self->at_context);
+  g_clear_handle_id (&self->unload_id, g_source_remove);
 
   G_OBJECT_CLASS (adap_view_stack_page_parent_class)->dispose (object);
 }
@@ -290,6 +342,9 @@ adap_view_stack_page_finalize (GObject *object)
   g_clear_pointer (&self->title, g_free);
   g_clear_pointer (&self->icon_name, g_free);
 
+  if (self->child_func_data_destroy)
+    self->child_func_data_destroy (self->child_func_data);
+
   if (self->last_focus)
     g_object_remove_weak_pointer (G_OBJECT (self->last_focus),
                                   (gpointer *) &self->last_focus);
@@ -397,6 +452,21 @@ adap_view_stack_page_class_init (AdapViewStackPageClass *class)
                           TRUE,
                           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * AdapViewStackPage:loaded: (attributes org.gtk.Property.get=adap_view_stack_page_get_loaded)
+   *
+   * Whether the child of this page has been created.
+   *
+   * This is always `TRUE` for pages that weren't added with
+   * [method@ViewStack.add_lazy].
+   *
+   * Since: 1.6
+   */
+  page_props[PAGE_PROP_LOADED] =
+    g_param_spec_boolean ("loaded", NULL, NULL,
+                          TRUE,
+                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PAGE_PROP, page_props);
 
   g_object_class_override_property (object_class, PAGE_PROP_ACCESSIBLE_ROLE, "accessible-role");
@@ -722,17 +792,7 @@ static GList *
 find_link_for_widget (AdapViewStack *self,
                       GtkWidget    *child)
 {
-  AdapViewStackPage *page;
-  GList *l;
-
-  for (l = self->children; l; l = l->next) {
-    page = l->data;
-
-    if (page->widget == child)
-      return l;
-  }
-
-  return NULL;
+  return g_hash_table_lookup (self->links_by_widget, child);
 }
 
 static AdapViewStackPage *
@@ -740,10 +800,22 @@ find_page_for_widget (AdapViewStack *self,
                       GtkWidget    *child)
 {
   GList *l = find_link_for_widget (self, child);
+  GtkWidget *parent;
 
   if (l)
     return l->data;
 
+  /* Children of lazy pages are inside their placeholder */
+  parent = gtk_widget_get_parent (child);
+
+  if (parent && ADAP_IS_BIN (parent) &&
+      gtk_widget_get_parent (parent) == GTK_WIDGET (self)) {
+    l = find_link_for_widget (self, parent);
+
+    if (l && ((AdapViewStackPage *) l->data)->child_func)
+      return l->data;
+  }
+
   return NULL;
 }
 
@@ -751,17 +823,109 @@ static AdapViewStackPage *
 find_page_for_name (AdapViewStack *self,
                     const char   *name)
 {
-  AdapViewStackPage *page;
+  if (!name)
+    return NULL;
+
+  return g_hash_table_lookup (self->pages_by_name, name);
+}
+
+/* Points @name at the first page that has it, if any */
+static void
+update_name_index (AdapViewStack *self,
+                   const char    *name)
+{
   GList *l;
 
   for (l = self->children; l; l = l->next) {
-    page = l->data;
+    AdapViewStackPage *page = l->data;
+
+    if (g_strcmp0 (page->name, name) == 0) {
+      g_hash_table_insert (self->pages_by_name, g_strdup (name), page);
 
-    if (g_strcmp0 (page->name, name) == 0)
-      return page;
+      return;
+    }
   }
 
-  return NULL;
+  g_hash_table_remove (self->pages_by_name, name);
+}
+
+static void
+load_page (AdapViewStackPage *page)
+{
+  GtkWidget *child;
+
+  if (adap_view_stack_page_get_loaded (page))
+    return;
+
+  child = page->child_func (page, page->child_func_data);
+
+  g_return_if_fail (GTK_IS_WIDGET (child));
+
+  adap_bin_set_child (ADAP_BIN (page->widget), child);
+
+  g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_LOADED]);
+}
+
+static void
+unload_page (AdapViewStackPage *page)
+{
+  g_clear_handle_id (&page->unload_id, g_source_remove);
+
+  if (!page->child_func || !adap_view_stack_page_get_loaded (page))
+    return;
+
+  if (page->last_focus) {
+    g_object_remove_weak_pointer (G_OBJECT (page->last_focus),
+                                  (gpointer *) &page->last_focus);
+    page->last_focus = NULL;
+  }
+
+  adap_bin_set_child (ADAP_BIN (page->widget), NULL);
+
+  g_object_notify_by_pspec (G_OBJECT (page), page_props[PAGE_PROP_LOADED]);
+}
+
+static void
+unload_timeout_cb (AdapViewStackPage *page)
+{
+  page->unload_id = 0;
+
+  unload_page (page);
+}
+
+static void
+update_unload_timeout (AdapViewStack     *self,
+                       AdapViewStackPage *page)
+{
+  g_clear_handle_id (&page->unload_id, g_source_remove);
+
+  if (self->unload_policy != ADAP_VIEW_STACK_UNLOAD_TIMEOUT ||
+      self->visible_child == page ||
+      !page->child_func ||
+      !adap_view_stack_page_get_loaded (page))
+    return;
+
+  page->unload_id = g_timeout_add_once (self->unload_timeout,
+                                        (GSourceOnceFunc) unload_timeout_cb,
+                                        page);
+  g_source_set_name_by_id (page->unload_id, "[adap] unload_timeout_cb");
+}
+
+static void
+low_memory_warning_cb (AdapViewStack              *self,
+                       GMemoryMonitorWarningLevel  level)
+{
+  GList *l;
+
+  if (level < G_MEMORY_MONITOR_WARNING_LEVEL_LOW)
+    return;
+
+  for (l = self->children; l; l = l->next) {
+    AdapViewStackPage *page = l->data;
+
+    if (page != self->visible_child)
+      unload_page (page);
+  }
 }
 
 static void
@@ -769,6 +933,7 @@ set_visible_child (AdapViewStack     *self,
                    AdapViewStackPage *page)
 {
   GtkWidget *widget = GTK_WIDGET (self);
+  AdapViewStackPage *old_page;
   GtkRoot *root;
   GtkWidget *focus;
   gboolean contains_focus = FALSE;
@@ -835,9 +1000,16 @@ set_visible_child (AdapViewStack     *self,
   if (self->visible_child && self->visible_child->widget)
     gtk_widget_set_child_visible (self->visible_child->widget, FALSE);
 
+  old_page = self->visible_child;
   self->visible_child = page;
 
+  if (old_page && old_page->widget)
+    update_unload_timeout (self, old_page);
+
   if (page) {
+    g_clear_handle_id (&page->unload_id, g_source_remove);
+    load_page (page);
+
     gtk_widget_set_child_visible (page->widget, TRUE);
 
     if (contains_focus) {
@@ -909,19 +1081,13 @@ static void
 add_page (AdapViewStack     *self,
           AdapViewStackPage *page)
 {
-  GList *l;
-
   g_return_if_fail (page->widget != NULL);
 
   if (page->name) {
-    for (l = self->children; l; l = l->next) {
-      AdapViewStackPage *p = l->data;
-
-      if (p->name && g_strcmp0 (p->name, page->name) == 0) {
-        g_warning ("While adding page: duplicate child name in AdapViewStack: %s", page->name);
-        break;
-      }
-    }
+    if (g_hash_table_contains (self->pages_by_name, page->name))
+      g_warning ("While adding page: duplicate child name in AdapViewStack: %s", page->name);
+    else
+      g_hash_table_insert (self->pages_by_name, g_strdup (page->name), page);
   }
 
   if (self->children) {
@@ -933,6 +1099,7 @@ add_page (AdapViewStack     *self,
   }
 
   self->children = g_list_append (self->children, g_object_ref (page));
+  g_hash_table_insert (self->links_by_widget, page->widget, g_list_last (self->children));
 
   gtk_widget_set_child_visible (page->widget, FALSE);
   gtk_widget_set_parent (page->widget, GTK_WIDGET (self));
@@ -1003,12 +1170,17 @@ stack_remove (AdapViewStack  *self,
 
   gtk_widget_unparent (child);
 
+  g_hash_table_remove (self->links_by_widget, child);
+  g_clear_handle_id (&page->unload_id, g_source_remove);
   g_clear_object (&page->widget);
 
   l = l->prev;
 
   self->children = g_list_remove (self->children, page);
 
+  if (page->name && g_hash_table_lookup (self->pages_by_name, page->name) == page)
+    update_name_index (self, page->name);
+
   if (l) {
     AdapViewStackPage *prev_page = l->data;
 
@@ -1101,6 +1273,12 @@ adap_view_stack_get_property (GObject    *object,
   case PROP_PAGES:
     g_value_take_object (value, adap_view_stack_get_pages (self));
     break;
+  case PROP_UNLOAD_POLICY:
+    g_value_set_enum (value, adap_view_stack_get_unload_policy (self));
+    break;
+  case PROP_UNLOAD_TIMEOUT:
+    g_value_set_uint (value, adap_view_stack_get_unload_timeout (self));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -1128,6 +1306,12 @@ adap_view_stack_set_property (GObject      *object,
   case PROP_VISIBLE_CHILD_NAME:
     adap_view_stack_set_visible_child_name (self, g_value_get_string (value));
     break;
+  case PROP_UNLOAD_POLICY:
+    adap_view_stack_set_unload_policy (self, g_value_get_enum (value));
+    break;
+  case PROP_UNLOAD_TIMEOUT:
+    adap_view_stack_set_unload_timeout (self, g_value_get_uint (value));
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
     break;
@@ -1147,6 +1331,12 @@ adap_view_stack_dispose (GObject *object)
   while ((child = gtk_widget_get_first_child (GTK_WIDGET (self))))
     stack_remove (self, child, TRUE);
 
+  if (self->memory_monitor) {
+    g_signal_handlers_disconnect_by_func (self->memory_monitor,
+                                          low_memory_warning_cb, self);
+    g_clear_object (&self->memory_monitor);
+  }
+
   G_OBJECT_CLASS (adap_view_stack_parent_class)->dispose (object);
 }
 
@@ -1159,6 +1349,9 @@ adap_view_stack_finalize (GObject *object)
     g_object_remove_weak_pointer (G_OBJECT (self->pages),
                                   (gpointer *) &self->pages);
 
+  g_hash_table_unref (self->links_by_widget);
+  g_hash_table_unref (self->pages_by_name);
+
   G_OBJECT_CLASS (adap_view_stack_parent_class)->finalize (object);
 }
 
@@ -1246,6 +1439,38 @@ adap_view_stack_class_init (AdapViewStackClass *klass)
                          GTK_TYPE_SELECTION_MODEL,
                          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * AdapViewStack:unload-policy: (attributes org.gtk.Property.get=adap_view_stack_get_unload_policy org.gtk.Property.set=adap_view_stack_set_unload_policy)
+   *
+   * When to destroy the children of hidden lazy pages.
+   *
+   * Only affects pages added with [method@ViewStack.add_lazy]. Their children
+   * will be created again the next time they are shown.
+   *
+   * Since: 1.6
+   */
+  props[PROP_UNLOAD_POLICY] =
+    g_param_spec_enum ("unload-policy", NULL, NULL,
+                       ADAP_TYPE_VIEW_STACK_UNLOAD_POLICY,
+                       ADAP_VIEW_STACK_UNLOAD_NEVER,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * AdapViewStack:unload-timeout: (attributes org.gtk.Property.get=adap_view_stack_get_unload_timeout org.gtk.Property.set=adap_view_stack_set_unload_timeout)
+   *
+   * How long a lazy page stays hidden before its child is destroyed, in
+   * milliseconds.
+   *
+   * Only used when [property@ViewStack:unload-policy] is set to
+   * `ADAP_VIEW_STACK_UNLOAD_TIMEOUT`.
+   *
+   * Since: 1.6
+   */
+  props[PROP_UNLOAD_TIMEOUT] =
+    g_param_spec_uint ("unload-timeout", NULL, NULL,
+                       0, G_MAXUINT, DEFAULT_UNLOAD_TIMEOUT,
+                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "stack");
@@ -1257,6 +1482,10 @@ adap_view_stack_init (AdapViewStack *self)
 {
   self->homogeneous[GTK_ORIENTATION_VERTICAL] = TRUE;
   self->homogeneous[GTK_ORIENTATION_HORIZONTAL] = TRUE;
+  self->unload_timeout = DEFAULT_UNLOAD_TIMEOUT;
+
+  self->links_by_widget = g_hash_table_new (NULL, NULL);
+  self->pages_by_name = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 }
 
 static void
@@ -1306,6 +1535,11 @@ adap_view_stack_accessible_init (GtkAccessibleInterface *iface)
  *
  * Gets the stack child to which @self belongs.
  *
+ * For pages added with [method@ViewStack.add_lazy], this is a container that
+ * holds the child once it has been created. [method@ViewStack.get_page],
+ * [method@ViewStack.set_visible_child] and [method@ViewStack.remove] accept
+ * both the container and the child.
+ *
  * Returns: (transfer none): the child to which @self belongs
  */
 GtkWidget *
@@ -1344,31 +1578,38 @@ adap_view_stack_page_set_name (AdapViewStackPage *self,
                               const char       *name)
 {
   AdapViewStack *stack = NULL;
+  char *old_name;
 
   g_return_if_fail (ADAP_IS_VIEW_STACK_PAGE (self));
 
   if (self->widget &&
       gtk_widget_get_parent (self->widget) &&
-      ADAP_IS_VIEW_STACK (gtk_widget_get_parent (self->widget)) &&
-      name) {
-    GList *l;
+      ADAP_IS_VIEW_STACK (gtk_widget_get_parent (self->widget))) {
+    AdapViewStackPage *p;
 
     stack = ADAP_VIEW_STACK (gtk_widget_get_parent (self->widget));
+    p = find_page_for_name (stack, name);
 
-    for (l = stack->children; l; l = l->next) {
-      AdapViewStackPage *p = l->data;
-      if (self == p)
-        continue;
-
-      if (g_strcmp0 (p->name, name) == 0) {
-        g_warning ("Duplicate child name in AdapViewStack: %s", name);
-        break;
-      }
-    }
+    if (p && p != self)
+      g_warning ("Duplicate child name in AdapViewStack: %s", name);
   }
 
-  if (!g_set_str (&self->name, name))
+  old_name = g_strdup (self->name);
+
+  if (!g_set_str (&self->name, name)) {
+    g_free (old_name);
     return;
+  }
+
+  if (stack) {
+    if (old_name)
+      update_name_index (stack, old_name);
+
+    if (name)
+      update_name_index (stack, name);
+  }
+
+  g_free (old_name);
 
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_NAME]);
 
@@ -1617,6 +1858,30 @@ adap_view_stack_page_set_visible (AdapViewStackPage *self,
   g_object_notify_by_pspec (G_OBJECT (self), page_props[PAGE_PROP_VISIBLE]);
 }
 
+/**
+ * adap_view_stack_page_get_loaded: (attributes org.gtk.Method.get_property=loaded)
+ * @self: a view stack page
+ *
+ * Gets whether the child of @self has been created.
+ *
+ * This is always `TRUE` for pages that weren't added with
+ * [method@ViewStack.add_lazy].
+ *
+ * Returns: whether the child of @self has been created
+ *
+ * Since: 1.6
+ */
+gboolean
+adap_view_stack_page_get_loaded (AdapViewStackPage *self)
+{
+  g_return_val_if_fail (ADAP_IS_VIEW_STACK_PAGE (self), FALSE);
+
+  if (!self->child_func)
+    return TRUE;
+
+  return self->widget && adap_bin_get_child (ADAP_BIN (self->widget));
+}
+
 /**
  * adap_view_stack_new:
  *
@@ -1732,6 +1997,53 @@ adap_view_stack_add_titled_with_icon (AdapViewStack *self,
   return add_internal (self, child, name, title, icon_name);
 }
 
+/**
+ * adap_view_stack_add_lazy:
+ * @self: a view stack
+ * @func: (scope notified) (closure user_data) (destroy user_data_destroy): the
+ *   function to create the child with
+ * @user_data: user data for @func
+ * @user_data_destroy: destroy notify for @user_data
+ *
+ * Adds a page to @self whose child is created by @func when it's first shown.
+ *
+ * Use the returned page to set the name, title, icon and other properties, so
+ * that [class@ViewSwitcher] can show the page before its child exists.
+ *
+ * If there's no visible page yet, the new page becomes visible and @func is
+ * called right away.
+ *
+ * See [property@ViewStack:unload-policy] for destroying the child again while
+ * the page is hidden.
+ *
+ * Returns: (transfer none): the `AdapViewStackPage` for the new page
+ *
+ * Since: 1.6
+ */
+AdapViewStackPage *
+adap_view_stack_add_lazy (AdapViewStack          *self,
+                          AdapViewStackChildFunc  func,
+                          gpointer                user_data,
+                          GDestroyNotify          user_data_destroy)
+{
+  AdapViewStackPage *page;
+
+  g_return_val_if_fail (ADAP_IS_VIEW_STACK (self), NULL);
+  g_return_val_if_fail (func != NULL, NULL);
+
+  page = g_object_new (ADAP_TYPE_VIEW_STACK_PAGE, NULL);
+  page->widget = g_object_ref (adap_bin_new ());
+  page->child_func = func;
+  page->child_func_data = user_data;
+  page->child_func_data_destroy = user_data_destroy;
+
+  add_page (self, page);
+
+  g_object_unref (page);
+
+  return page;
+}
+
 /**
  * adap_view_stack_remove:
  * @self: a view stack
@@ -1743,11 +2055,18 @@ void
 adap_view_stack_remove (AdapViewStack  *self,
                        GtkWidget     *child)
 {
+  AdapViewStackPage *child_page;
   GList *l;
   guint position;
 
   g_return_if_fail (ADAP_IS_VIEW_STACK (self));
   g_return_if_fail (GTK_IS_WIDGET (child));
+
+  /* The child of a lazy page removes the whole page */
+  child_page = find_page_for_widget (self, child);
+  if (child_page)
+    child = child_page->widget;
+
   g_return_if_fail (gtk_widget_get_parent (child) == GTK_WIDGET (self));
 
   for (l = self->children, position = 0; l; l = l->next, position++) {
@@ -1993,6 +2312,117 @@ adap_view_stack_set_vhomogeneous (AdapViewStack *self,
   g_object_notify_by_pspec (G_OBJECT (self), props[PROP_VHOMOGENEOUS]);
 }
 
+/**
+ * adap_view_stack_get_unload_policy: (attributes org.gtk.Method.get_property=unload-policy)
+ * @self: a view stack
+ *
+ * Gets when the children of hidden lazy pages are destroyed.
+ *
+ * Returns: the unload policy
+ *
+ * Since: 1.6
+ */
+AdapViewStackUnloadPolicy
+adap_view_stack_get_unload_policy (AdapViewStack *self)
+{
+  g_return_val_if_fail (ADAP_IS_VIEW_STACK (self), ADAP_VIEW_STACK_UNLOAD_NEVER);
+
+  return self->unload_policy;
+}
+
+/**
+ * adap_view_stack_set_unload_policy: (attributes org.gtk.Method.set_property=unload-policy)
+ * @self: a view stack
+ * @policy: the new policy
+ *
+ * Sets when the children of hidden lazy pages are destroyed.
+ *
+ * Only affects pages added with [method@ViewStack.add_lazy]. Their children
+ * will be created again the next time they are shown.
+ *
+ * Since: 1.6
+ */
+void
+adap_view_stack_set_unload_policy (AdapViewStack             *self,
+                                   AdapViewStackUnloadPolicy  policy)
+{
+  GList *l;
+
+  g_return_if_fail (ADAP_IS_VIEW_STACK (self));
+  g_return_if_fail (policy <= ADAP_VIEW_STACK_UNLOAD_TIMEOUT);
+
+  if (policy == self->unload_policy)
+    return;
+
+  self->unload_policy = policy;
+
+  if (policy == ADAP_VIEW_STACK_UNLOAD_NEVER) {
+    g_signal_handlers_disconnect_by_func (self->memory_monitor,
+                                          low_memory_warning_cb, self);
+    g_clear_object (&self->memory_monitor);
+  } else if (!self->memory_monitor) {
+    self->memory_monitor = g_memory_monitor_dup_default ();
+
+    g_signal_connect_object (self->memory_monitor, "low-memory-warning",
+                             G_CALLBACK (low_memory_warning_cb), self,
+                             G_CONNECT_SWAPPED);
+  }
+
+  for (l = self->children; l; l = l->next)
+    update_unload_timeout (self, l->data);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_UNLOAD_POLICY]);
+}
+
+/**
+ * adap_view_stack_get_unload_timeout: (attributes org.gtk.Method.get_property=unload-timeout)
+ * @self: a view stack
+ *
+ * Gets how long a lazy page stays hidden before its child is destroyed.
+ *
+ * Returns: the timeout, in milliseconds
+ *
+ * Since: 1.6
+ */
+guint
+adap_view_stack_get_unload_timeout (AdapViewStack *self)
+{
+  g_return_val_if_fail (ADAP_IS_VIEW_STACK (self), 0);
+
+  return self->unload_timeout;
+}
+
+/**
+ * adap_view_stack_set_unload_timeout: (attributes org.gtk.Method.set_property=unload-timeout)
+ * @self: a view stack
+ * @timeout: the timeout, in milliseconds
+ *
+ * Sets how long a lazy page stays hidden before its child is destroyed.
+ *
+ * Only used when [property@ViewStack:unload-policy] is set to
+ * `ADAP_VIEW_STACK_UNLOAD_TIMEOUT`.
+ *
+ * Since: 1.6
+ */
+void
+adap_view_stack_set_unload_timeout (AdapViewStack *self,
+                                    guint          timeout)
+{
+  GList *l;
+
+  g_return_if_fail (ADAP_IS_VIEW_STACK (self));
+
+  if (timeout == self->unload_timeout)
+    return;
+
+  self->unload_timeout = timeout;
+
+  for (l = self->children; l; l = l->next)
+    update_unload_timeout (self, l->data);
+
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_UNLOAD_TIMEOUT]);
+}
+
 /**
  * adap_view_stack_get_pages: (attributes org.gtk.Method.get_property=pages)
  * @self: a view stack
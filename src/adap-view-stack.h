@@ -19,6 +19,7 @@
 #include "adap-version.h"
 
 #include <gtk/gtk.h>
+#include "adap-enums.h"
 
 G_BEGIN_DECLS
 
@@ -27,9 +28,27 @@ G_BEGIN_DECLS
 ADAP_AVAILABLE_IN_ALL
 G_DECLARE_FINAL_TYPE (AdapViewStackPage, adap_view_stack_page, ADAP, VIEW_STACK_PAGE, GObject)
 
+/**
+ * AdapViewStackChildFunc:
+ * @page: the page
+ * @user_data: user data
+ *
+ * Called to create the child of a page added with
+ * [method@ViewStack.add_lazy].
+ *
+ * Returns: (transfer full): the child widget
+ *
+ * Since: 1.6
+ */
+typedef GtkWidget *(*AdapViewStackChildFunc) (AdapViewStackPage *page,
+                                              gpointer           user_data);
+
 ADAP_AVAILABLE_IN_ALL
 GtkWidget *adap_view_stack_page_get_child (AdapViewStackPage *self);
 
+ADAP_AVAILABLE_IN_1_6
+gboolean adap_view_stack_page_get_loaded (AdapViewStackPage *self);
+
 ADAP_AVAILABLE_IN_ALL
 const char *adap_view_stack_page_get_name (AdapViewStackPage *self);
 ADAP_AVAILABLE_IN_ALL
@@ -72,6 +91,12 @@ ADAP_AVAILABLE_IN_ALL
 void     adap_view_stack_page_set_visible (AdapViewStackPage *self,
                                           gboolean          visible);
 
+typedef enum {
+  ADAP_VIEW_STACK_UNLOAD_NEVER,
+  ADAP_VIEW_STACK_UNLOAD_LOW_MEMORY,
+  ADAP_VIEW_STACK_UNLOAD_TIMEOUT,
+} AdapViewStackUnloadPolicy;
+
 #define ADAP_TYPE_VIEW_STACK (adap_view_stack_get_type())
 
 ADAP_AVAILABLE_IN_ALL
@@ -99,6 +124,12 @@ AdapViewStackPage *adap_view_stack_add_titled_with_icon (AdapViewStack *self,
                                                        const char   *title,
                                                        const char   *icon_name);
 
+ADAP_AVAILABLE_IN_1_6
+AdapViewStackPage *adap_view_stack_add_lazy (AdapViewStack          *self,
+                                             AdapViewStackChildFunc  func,
+                                             gpointer                user_data,
+                                             GDestroyNotify          user_data_destroy);
+
 ADAP_AVAILABLE_IN_ALL
 void adap_view_stack_remove (AdapViewStack *self,
                             GtkWidget    *child);
@@ -135,6 +166,18 @@ ADAP_AVAILABLE_IN_ALL
 void     adap_view_stack_set_vhomogeneous (AdapViewStack *self,
                                           gboolean      vhomogeneous);
 
+ADAP_AVAILABLE_IN_1_6
+AdapViewStackUnloadPolicy adap_view_stack_get_unload_policy (AdapViewStack             *self);
+ADAP_AVAILABLE_IN_1_6
+void                      adap_view_stack_set_unload_policy (AdapViewStack             *self,
+                                                             AdapViewStackUnloadPolicy  policy);
+
+ADAP_AVAILABLE_IN_1_6
+guint adap_view_stack_get_unload_timeout (AdapViewStack *self);
+ADAP_AVAILABLE_IN_1_6
+void  adap_view_stack_set_unload_timeout (AdapViewStack *self,
+                                          guint          timeout);
+
 ADAP_AVAILABLE_IN_ALL
 GtkSelectionModel *adap_view_stack_get_pages (AdapViewStack *self);
 
@@ -9,6 +9,7 @@
 
 #include "adap-enums.h"
 #include "adap-breakpoint-bin-private.h"
+#include "adap-style-manager-private.h"
 #include "adap-view-switcher-bar.h"
 
 /**
@@ -260,6 +261,8 @@ adap_view_switcher_bar_class_init (AdapViewSwitcherBarClass *klass)
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "viewswitcherbar");
+
+  adap_style_manager_ensure_fragment ("view-switcher");
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
 
   gtk_widget_class_set_template_from_resource (widget_class,
@@ -10,6 +10,7 @@
 #include "adap-view-switcher-title.h"
 
 #include "adap-squeezer.h"
+#include "adap-style-manager-private.h"
 #include "adap-window-title.h"
 
 /**
@@ -360,6 +361,8 @@ adap_view_switcher_title_class_init (AdapViewSwitcherTitleClass *klass)
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "viewswitchertitle");
+
+  adap_style_manager_ensure_fragment ("view-switcher");
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
 
   gtk_widget_class_set_template_from_resource (widget_class,
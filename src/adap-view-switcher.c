@@ -11,6 +11,7 @@
 #include "config.h"
 
 #include "adap-enums.h"
+#include "adap-style-manager-private.h"
 #include "adap-view-switcher.h"
 #include "adap-view-switcher-button-private.h"
 
@@ -186,7 +187,8 @@ on_page_updated (AdapViewStackPage *page,
 
 static void
 add_child (AdapViewSwitcher *self,
-           guint            position)
+           guint            position,
+           GtkWidget       *prev_sibling)
 {
   AdapViewSwitcherButton *button = ADAP_VIEW_SWITCHER_BUTTON (adap_view_switcher_button_new ());
   AdapViewStackPage *page;
@@ -195,9 +197,10 @@ add_child (AdapViewSwitcher *self,
   page = g_list_model_get_item (G_LIST_MODEL (self->pages), position);
   update_button (self, page, GTK_WIDGET (button));
 
-  gtk_widget_set_parent (GTK_WIDGET (button), GTK_WIDGET (self));
+  gtk_widget_insert_after (GTK_WIDGET (button), GTK_WIDGET (self), prev_sibling);
 
   g_object_set_data (G_OBJECT (button), "child-index", GUINT_TO_POINTER (position));
+  g_object_set_data (G_OBJECT (button), "page", page);
   selected = gtk_selection_model_is_selected (self->pages, position);
   gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (button), selected);
 
@@ -216,6 +219,17 @@ add_child (AdapViewSwitcher *self,
   g_object_unref (page);
 }
 
+static void
+remove_child (AdapViewSwitcher *self,
+              GtkWidget       *button)
+{
+  AdapViewStackPage *page = g_object_get_data (G_OBJECT (button), "page");
+
+  gtk_widget_unparent (button);
+  g_signal_handlers_disconnect_by_func (page, on_page_updated, self);
+  g_hash_table_remove (self->buttons, page);
+}
+
 static void
 populate_switcher (AdapViewSwitcher *self)
 {
@@ -223,30 +237,54 @@ populate_switcher (AdapViewSwitcher *self)
 
   n = g_list_model_get_n_items (G_LIST_MODEL (self->pages));
   for (i = 0; i < n; i++)
-    add_child (self, i);
+    add_child (self, i, gtk_widget_get_last_child (GTK_WIDGET (self)));
 }
 
 static void
 clear_switcher (AdapViewSwitcher *self)
 {
-  GHashTableIter iter;
-  GtkWidget *page;
   GtkWidget *button;
 
-  g_hash_table_iter_init (&iter, self->buttons);
-  while (g_hash_table_iter_next (&iter, (gpointer *) &page, (gpointer *) &button)) {
-    gtk_widget_unparent (button);
-    g_signal_handlers_disconnect_by_func (page, on_page_updated, self);
-    g_hash_table_iter_remove (&iter);
-  }
+  while ((button = gtk_widget_get_first_child (GTK_WIDGET (self))))
+    remove_child (self, button);
 }
 
-
 static void
-items_changed_cb (AdapViewSwitcher *self)
+items_changed_cb (AdapViewSwitcher *self,
+                  guint            position,
+                  guint            removed,
+                  guint            added)
 {
-  clear_switcher (self);
-  populate_switcher (self);
+  GtkWidget *prev_sibling = NULL;
+  GtkWidget *button;
+  guint i;
+
+  /* Buttons are kept in the same order as the pages, so the affected ones
+   * can be found by position instead of rebuilding all of them */
+  for (i = 0, button = gtk_widget_get_first_child (GTK_WIDGET (self));
+       i < position && button;
+       i++, button = gtk_widget_get_next_sibling (button))
+    prev_sibling = button;
+
+  for (i = 0; i < removed && button; i++) {
+    GtkWidget *next = gtk_widget_get_next_sibling (button);
+
+    remove_child (self, button);
+    button = next;
+  }
+
+  for (i = 0; i < added; i++) {
+    add_child (self, position + i, prev_sibling);
+    prev_sibling = prev_sibling ? gtk_widget_get_next_sibling (prev_sibling) :
+                                  gtk_widget_get_first_child (GTK_WIDGET (self));
+  }
+
+  if (removed == added)
+    return;
+
+  /* The buttons after the change have moved */
+  for (i = position + added; button; i++, button = gtk_widget_get_next_sibling (button))
+    g_object_set_data (G_OBJECT (button), "child-index", GUINT_TO_POINTER (i));
 }
 
 static void
@@ -413,6 +451,8 @@ adap_view_switcher_class_init (AdapViewSwitcherClass *klass)
   g_object_class_install_properties (object_class, LAST_PROP, props);
 
   gtk_widget_class_set_css_name (widget_class, "viewswitcher");
+
+  adap_style_manager_ensure_fragment ("view-switcher");
   gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BOX_LAYOUT);
   gtk_widget_class_set_accessible_role (widget_class, GTK_ACCESSIBLE_ROLE_TAB_LIST);
 }
@@ -934,7 +934,6 @@
 #define adw_indicator_bin_set_child adap_indicator_bin_set_child
 #define adw_indicator_bin_set_needs_attention adap_indicator_bin_set_needs_attention
 #define adw_init adap_init
-#define adw_init_public_types adap_init_public_types
 #define adw_inspector_page_get_type adap_inspector_page_get_type
 #define adw_is_granite_present adap_is_granite_present
 #define adw_is_initialized adap_is_initialized
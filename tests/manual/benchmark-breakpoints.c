@@ -0,0 +1,108 @@
+#include <adapta.h>
+
+#include "benchmark-util.h"
+
+#define N_ROWS 200
+#define N_SWITCHES 100
+#define NARROW_WIDTH 300
+#define WIDE_WIDTH 500
+
+static gboolean fast = FALSE;
+
+static GOptionEntry entries[] = {
+  { "fast", 0, 0, G_OPTION_ARG_NONE, &fast, "Use the fast transition mode", NULL },
+  { NULL }
+};
+
+static void
+step_cb (int        step,
+         GtkWidget *bin)
+{
+  int width = step % 2 ? WIDE_WIDTH : NARROW_WIDTH;
+
+  gtk_widget_set_size_request (bin, width, -1);
+}
+
+static GtkWidget *
+create_row (AdapBreakpoint *breakpoint,
+            int            i)
+{
+  GtkWidget *row, *label;
+  char *text;
+
+  row = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+
+  text = g_strdup_printf ("Row %d", i);
+  label = gtk_label_new (text);
+  gtk_widget_set_hexpand (label, TRUE);
+  gtk_label_set_xalign (GTK_LABEL (label), 0);
+  g_free (text);
+
+  gtk_box_append (GTK_BOX (row), gtk_image_new_from_icon_name ("emblem-documents-symbolic"));
+  gtk_box_append (GTK_BOX (row), label);
+  gtk_box_append (GTK_BOX (row), gtk_button_new_with_label ("Open"));
+
+  adap_breakpoint_add_setters (breakpoint,
+                              G_OBJECT (row), "orientation", GTK_ORIENTATION_VERTICAL,
+                              NULL);
+
+  return row;
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  AdapBreakpoint *breakpoint;
+  GtkWidget *window, *scrolled_window, *bin, *box;
+  int i;
+
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (context);
+
+    return 1;
+  }
+
+  g_option_context_free (context);
+
+  adap_init ();
+
+  breakpoint = adap_breakpoint_new (adap_breakpoint_condition_parse ("max-width: 400px"));
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
+
+  for (i = 0; i < N_ROWS; i++)
+    gtk_box_append (GTK_BOX (box), create_row (breakpoint, i));
+
+  bin = adap_breakpoint_bin_new ();
+  gtk_widget_set_halign (bin, GTK_ALIGN_START);
+  gtk_widget_set_size_request (bin, WIDE_WIDTH, -1);
+  adap_breakpoint_bin_set_child (ADAP_BREAKPOINT_BIN (bin), box);
+  adap_breakpoint_bin_add_breakpoint (ADAP_BREAKPOINT_BIN (bin), breakpoint);
+  adap_breakpoint_bin_set_transition_mode (ADAP_BREAKPOINT_BIN (bin),
+                                           fast ? ADAP_BREAKPOINT_TRANSITION_FAST :
+                                                  ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE);
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (scrolled_window),
+                                  GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), bin);
+
+  window = gtk_window_new ();
+  gtk_window_set_title (GTK_WINDOW (window), "Breakpoint Benchmark");
+  gtk_window_set_default_size (GTK_WINDOW (window), 600, 600);
+  gtk_window_set_child (GTK_WINDOW (window), scrolled_window);
+
+  /* Leave a frame in between for the transition to finish */
+  benchmark_run (window, fast ? "fast" : "flicker-free", N_SWITCHES, 1,
+                 (BenchmarkStepFunc) step_cb, bin);
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+#include <adapta.h>
+
+#define N_PAGES 20
+#define N_GROUPS 5
+#define N_ROWS 20
+#define QUERY "network proxy"
+
+static const char *words[] = {
+  "Network", "Proxy", "Display", "Sound", "Power", "Keyboard", "Mouse",
+  "Privacy", "Sharing", "Notifications", "Search", "Accessibility",
+};
+
+typedef struct {
+  GtkWidget *window;
+  AdapDialog *dialog;
+
+  gboolean done;
+} Benchmark;
+
+static GtkWidget *
+find_child (GtkWidget *widget,
+            GType      type)
+{
+  GtkWidget *child;
+
+  if (G_TYPE_CHECK_INSTANCE_TYPE (widget, type))
+    return widget;
+
+  for (child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkWidget *found = find_child (child, type);
+
+    if (found)
+      return found;
+  }
+
+  return NULL;
+}
+
+static void
+flush_events (void)
+{
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+}
+
+static void
+run_cb (Benchmark *benchmark)
+{
+  GtkWidget *search_button, *search_entry;
+  gint64 total_time = 0, max_time = 0;
+  int query_len = strlen (QUERY);
+  int i, n_keystrokes = 0;
+
+  search_button = find_child (GTK_WIDGET (benchmark->dialog), GTK_TYPE_TOGGLE_BUTTON);
+  search_entry = find_child (GTK_WIDGET (benchmark->dialog), GTK_TYPE_SEARCH_ENTRY);
+
+  g_assert (search_button != NULL);
+  g_assert (search_entry != NULL);
+
+  gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (search_button), TRUE);
+  flush_events ();
+
+  /* Type the query, then delete it, one character at a time */
+  for (i = 1; i < 2 * query_len; i++) {
+    int len = i <= query_len ? i : 2 * query_len - i;
+    char *text = g_strndup (QUERY, len);
+    gint64 start_time, time;
+
+    start_time = g_get_monotonic_time ();
+
+    gtk_editable_set_text (GTK_EDITABLE (search_entry), text);
+    g_signal_emit_by_name (search_entry, "search-changed");
+    flush_events ();
+
+    time = g_get_monotonic_time () - start_time;
+
+    g_print ("%-16s %8.2f ms\n", text, time / 1000.0);
+
+    total_time += time;
+    max_time = MAX (max_time, time);
+    n_keystrokes++;
+
+    g_free (text);
+  }
+
+  g_print ("%d rows, %d keystrokes, mean %.2f ms, max %.2f ms\n",
+           N_PAGES * N_GROUPS * N_ROWS,
+           n_keystrokes,
+           total_time / 1000.0 / n_keystrokes,
+           max_time / 1000.0);
+
+  gtk_window_destroy (GTK_WINDOW (benchmark->window));
+}
+
+static void
+close_cb (Benchmark *benchmark)
+{
+  benchmark->done = TRUE;
+}
+
+static AdapDialog *
+create_dialog (void)
+{
+  AdapDialog *dialog = ADAP_DIALOG (adap_preferences_dialog_new ());
+  int i, j, k, n = 0;
+
+  adap_preferences_dialog_set_search_enabled (ADAP_PREFERENCES_DIALOG (dialog), TRUE);
+
+  for (i = 0; i < N_PAGES; i++) {
+    AdapPreferencesPage *page = ADAP_PREFERENCES_PAGE (adap_preferences_page_new ());
+    char *title = g_strdup_printf ("Page %d", i);
+
+    adap_preferences_page_set_title (page, title);
+    adap_preferences_page_set_icon_name (page, "preferences-system-symbolic");
+
+    for (j = 0; j < N_GROUPS; j++) {
+      AdapPreferencesGroup *group = ADAP_PREFERENCES_GROUP (adap_preferences_group_new ());
+
+      for (k = 0; k < N_ROWS; k++) {
+        GtkWidget *row = adap_action_row_new ();
+        char *row_title, *subtitle;
+
+        row_title = g_strdup_printf ("%s %s %d",
+                                     words[n % G_N_ELEMENTS (words)],
+                                     words[(n / 7) % G_N_ELEMENTS (words)],
+                                     n);
+        subtitle = g_strdup_printf ("Configure %s settings",
+                                    words[(n / 3) % G_N_ELEMENTS (words)]);
+
+        adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (row), row_title);
+        adap_action_row_set_subtitle (ADAP_ACTION_ROW (row), subtitle);
+        adap_preferences_group_add (group, row);
+
+        g_free (row_title);
+        g_free (subtitle);
+        n++;
+      }
+
+      adap_preferences_page_add (page, group);
+    }
+
+    adap_preferences_dialog_add (ADAP_PREFERENCES_DIALOG (dialog), page);
+
+    g_free (title);
+  }
+
+  return dialog;
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  Benchmark benchmark = { 0 };
+
+  adap_init ();
+
+  benchmark.window = gtk_window_new ();
+  gtk_window_set_title (GTK_WINDOW (benchmark.window), "Preferences Search Benchmark");
+  gtk_window_set_default_size (GTK_WINDOW (benchmark.window), 800, 600);
+
+  g_signal_connect_swapped (benchmark.window, "destroy", G_CALLBACK (close_cb), &benchmark);
+
+  gtk_window_present (GTK_WINDOW (benchmark.window));
+
+  benchmark.dialog = create_dialog ();
+  adap_dialog_present (benchmark.dialog, benchmark.window);
+
+  g_idle_add_once ((GSourceOnceFunc) run_cb, &benchmark);
+
+  while (!benchmark.done)
+    g_main_context_iteration (NULL, TRUE);
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include <adapta.h>
+
+#include "benchmark-util.h"
+
+#define N_ROWS 100
+#define N_SWITCHES 100
+
+static void
+step_cb (int      step,
+         gpointer user_data)
+{
+  AdapStyleManager *manager = adap_style_manager_get_default ();
+
+  if (adap_style_manager_get_dark (manager))
+    adap_style_manager_set_color_scheme (manager, ADAP_COLOR_SCHEME_FORCE_LIGHT);
+  else
+    adap_style_manager_set_color_scheme (manager, ADAP_COLOR_SCHEME_FORCE_DARK);
+}
+
+static GtkWidget *
+create_content (void)
+{
+  GtkWidget *scrolled_window, *list;
+  int i;
+
+  list = gtk_list_box_new ();
+  gtk_list_box_set_selection_mode (GTK_LIST_BOX (list), GTK_SELECTION_NONE);
+  gtk_widget_add_css_class (list, "boxed-list");
+  gtk_widget_set_margin_top (list, 12);
+  gtk_widget_set_margin_bottom (list, 12);
+  gtk_widget_set_margin_start (list, 12);
+  gtk_widget_set_margin_end (list, 12);
+
+  for (i = 0; i < N_ROWS; i++) {
+    GtkWidget *row, *button;
+    char *title;
+
+    title = g_strdup_printf ("Row %d", i);
+
+    row = adap_action_row_new ();
+    adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (row), title);
+    adap_action_row_set_subtitle (ADAP_ACTION_ROW (row), "Subtitle");
+
+    button = gtk_button_new_with_label ("Button");
+    gtk_widget_set_valign (button, GTK_ALIGN_CENTER);
+    if (i % 2)
+      gtk_widget_add_css_class (button, "suggested-action");
+    adap_action_row_add_suffix (ADAP_ACTION_ROW (row), button);
+    adap_action_row_add_suffix (ADAP_ACTION_ROW (row), gtk_switch_new ());
+
+    gtk_list_box_append (GTK_LIST_BOX (list), row);
+
+    g_free (title);
+  }
+
+  scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (scrolled_window), list);
+
+  return scrolled_window;
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GtkWidget *window;
+
+  adap_init ();
+
+  window = gtk_window_new ();
+  gtk_window_set_title (GTK_WINDOW (window), "Style Switch Benchmark");
+  gtk_window_set_default_size (GTK_WINDOW (window), 600, 600);
+  gtk_window_set_child (GTK_WINDOW (window), create_content ());
+
+  benchmark_run (window, "style switch", N_SWITCHES, 0, step_cb, NULL);
+
+  return 0;
+}
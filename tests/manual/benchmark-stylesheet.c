@@ -0,0 +1,53 @@
+#include <adapta.h>
+
+#define STYLES_PATH "/org/gnome/Adapta/styles/"
+#define N_ITERATIONS 20
+
+static void
+measure (const char *name)
+{
+  char *path = g_strconcat (STYLES_PATH, name, NULL);
+  gint64 total_time = 0;
+  gsize size = 0;
+  int i;
+
+  g_resources_get_info (path, G_RESOURCE_LOOKUP_FLAGS_NONE, &size, NULL, NULL);
+
+  for (i = 0; i < N_ITERATIONS; i++) {
+    GtkCssProvider *provider = gtk_css_provider_new ();
+    gint64 start_time = g_get_monotonic_time ();
+
+    gtk_css_provider_load_from_resource (provider, path);
+
+    total_time += g_get_monotonic_time () - start_time;
+
+    g_object_unref (provider);
+  }
+
+  g_print ("%-32s %8" G_GSIZE_FORMAT " bytes %8.3f ms\n",
+           name, size, total_time / 1000.0 / N_ITERATIONS);
+
+  g_free (path);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  char **children;
+  int i;
+
+  adap_init ();
+
+  children = g_resources_enumerate_children (STYLES_PATH,
+                                             G_RESOURCE_LOOKUP_FLAGS_NONE,
+                                             NULL);
+
+  for (i = 0; children[i]; i++)
+    if (g_str_has_suffix (children[i], ".css"))
+      measure (children[i]);
+
+  g_strfreev (children);
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "benchmark-util.h"
+
+typedef struct {
+  GtkWidget *window;
+  const char *name;
+  int n_steps;
+  int settle_frames;
+  BenchmarkStepFunc step_func;
+  gpointer user_data;
+
+  gint64 step_time;
+  gint64 total_time;
+  gint64 max_time;
+  int n_done;
+  int n_settle;
+
+  gboolean done;
+} Benchmark;
+
+static void
+after_paint_cb (Benchmark *benchmark)
+{
+  gint64 time;
+
+  if (!benchmark->step_time)
+    return;
+
+  time = g_get_monotonic_time () - benchmark->step_time;
+
+  benchmark->total_time += time;
+  benchmark->max_time = MAX (benchmark->max_time, time);
+  benchmark->step_time = 0;
+  benchmark->n_settle = benchmark->settle_frames;
+}
+
+static gboolean
+tick_cb (GtkWidget     *widget,
+         GdkFrameClock *frame_clock,
+         Benchmark     *benchmark)
+{
+  if (benchmark->n_done == benchmark->n_steps) {
+    g_print ("%s: %d steps, mean %.2f ms, max %.2f ms\n",
+             benchmark->name,
+             benchmark->n_done,
+             benchmark->total_time / 1000.0 / MAX (benchmark->n_done, 1),
+             benchmark->max_time / 1000.0);
+
+    gtk_window_destroy (GTK_WINDOW (benchmark->window));
+
+    return G_SOURCE_REMOVE;
+  }
+
+  /* Let the previous step finish painting */
+  if (benchmark->step_time)
+    return G_SOURCE_CONTINUE;
+
+  if (benchmark->n_settle > 0) {
+    benchmark->n_settle--;
+    return G_SOURCE_CONTINUE;
+  }
+
+  benchmark->step_time = g_get_monotonic_time ();
+  benchmark->step_func (benchmark->n_done, benchmark->user_data);
+  benchmark->n_done++;
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+realize_cb (Benchmark *benchmark)
+{
+  GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (benchmark->window);
+
+  g_signal_connect_swapped (frame_clock, "after-paint", G_CALLBACK (after_paint_cb), benchmark);
+
+  gtk_widget_add_tick_callback (benchmark->window, (GtkTickCallback) tick_cb, benchmark, NULL);
+}
+
+static void
+close_cb (Benchmark *benchmark)
+{
+  benchmark->done = TRUE;
+}
+
+/* Presents @window and runs @step_func @n_steps times, once per frame, then
+ * prints how long the steps took to paint and destroys the window.
+ * @settle_frames frames are left in between the steps. */
+void
+benchmark_run (GtkWidget         *window,
+               const char        *name,
+               int                n_steps,
+               int                settle_frames,
+               BenchmarkStepFunc  step_func,
+               gpointer           user_data)
+{
+  Benchmark benchmark = { 0 };
+
+  benchmark.window = window;
+  benchmark.name = name;
+  benchmark.n_steps = n_steps;
+  benchmark.settle_frames = settle_frames;
+  benchmark.step_func = step_func;
+  benchmark.user_data = user_data;
+
+  g_signal_connect_swapped (window, "realize", G_CALLBACK (realize_cb), &benchmark);
+  g_signal_connect_swapped (window, "destroy", G_CALLBACK (close_cb), &benchmark);
+
+  gtk_window_present (GTK_WINDOW (window));
+
+  while (!benchmark.done)
+    g_main_context_iteration (NULL, TRUE);
+}
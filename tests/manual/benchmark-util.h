@@ -0,0 +1,19 @@
+#pragma once
+
+#include <adapta.h>
+
+G_BEGIN_DECLS
+
+/* Called once per step from a tick callback. The time from the step until the
+ * frame it caused has been painted is recorded. */
+typedef void (*BenchmarkStepFunc) (int      step,
+                                   gpointer user_data);
+
+void benchmark_run (GtkWidget         *window,
+                    const char        *name,
+                    int                n_steps,
+                    int                settle_frames,
+                    BenchmarkStepFunc  step_func,
+                    gpointer           user_data);
+
+G_END_DECLS
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adapta.h>
+#include "adap-settings-private.h"
+#include "adapta-test-resources.h"
+
+#define RESOURCE_BASE_PATH "/org/gnome/Adapta1/Test/application"
+
+typedef enum {
+  STYLE_NONE,
+  STYLE_DARK,
+  STYLE_HC,
+} Style;
+
+static AdapApplication *
+create_application (void)
+{
+  AdapApplication *app = adap_application_new (NULL, G_APPLICATION_DEFAULT_FLAGS);
+  GError *error = NULL;
+
+  g_application_set_resource_base_path (G_APPLICATION (app), RESOURCE_BASE_PATH);
+  g_application_register (G_APPLICATION (app), NULL, &error);
+  g_assert_no_error (error);
+
+  return app;
+}
+
+static void
+set_style (AdapSettings *settings,
+           gboolean      dark,
+           gboolean      hc)
+{
+  adap_settings_override_color_scheme (settings,
+                                       dark ? ADAP_SYSTEM_COLOR_SCHEME_PREFER_DARK :
+                                              ADAP_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+  adap_settings_override_high_contrast (settings, hc);
+}
+
+static void
+assert_style (GtkWidget *widget,
+              Style      style)
+{
+  GdkRGBA color;
+
+  gtk_widget_get_color (widget, &color);
+
+  switch (style) {
+  case STYLE_DARK:
+    g_assert_cmpfloat (color.red, ==, 0);
+    g_assert_cmpfloat (color.blue, ==, 1);
+    break;
+  case STYLE_HC:
+    g_assert_cmpfloat (color.red, ==, 1);
+    g_assert_cmpfloat (color.blue, ==, 0);
+    break;
+  case STYLE_NONE:
+    g_assert_false (color.red == 1 && color.blue == 0);
+    g_assert_false (color.red == 0 && color.blue == 1);
+    break;
+  default:
+    g_assert_not_reached ();
+  }
+}
+
+static void
+test_adap_application_stylesheet_order (void)
+{
+  AdapSettings *settings = adap_settings_get_default ();
+  AdapApplication *app;
+  GtkWidget *window, *label;
+
+  adap_settings_start_override (settings);
+  adap_settings_override_system_supports_color_schemes (settings, TRUE);
+  set_style (settings, FALSE, TRUE);
+
+  app = create_application ();
+
+  window = gtk_window_new ();
+  label = gtk_label_new ("Label");
+  gtk_widget_add_css_class (label, "test-label");
+  gtk_window_set_child (GTK_WINDOW (window), label);
+
+  assert_style (label, STYLE_HC);
+
+  /* High contrast styles win regardless of the order the preferences were
+   * enabled in */
+  set_style (settings, TRUE, TRUE);
+  assert_style (label, STYLE_HC);
+
+  set_style (settings, TRUE, FALSE);
+  assert_style (label, STYLE_DARK);
+
+  set_style (settings, TRUE, TRUE);
+  assert_style (label, STYLE_HC);
+
+  set_style (settings, FALSE, FALSE);
+  assert_style (label, STYLE_NONE);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+  adap_settings_end_override (settings);
+  g_object_unref (app);
+}
+
+static void
+test_adap_application_preload_stylesheets (void)
+{
+  AdapSettings *settings = adap_settings_get_default ();
+  AdapApplication *app;
+  GtkWidget *window, *label;
+
+  adap_settings_start_override (settings);
+  adap_settings_override_system_supports_color_schemes (settings, TRUE);
+  set_style (settings, FALSE, FALSE);
+
+  app = adap_application_new (NULL, G_APPLICATION_DEFAULT_FLAGS);
+  g_application_set_resource_base_path (G_APPLICATION (app), RESOURCE_BASE_PATH);
+
+  /* Preloading can be requested before startup */
+  adap_application_preload_stylesheets (app);
+  g_application_register (G_APPLICATION (app), NULL, NULL);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  /* Without the resources, the stylesheets can only come from the preload */
+  g_resources_unregister (test_get_resource ());
+
+  window = gtk_window_new ();
+  label = gtk_label_new ("Label");
+  gtk_widget_add_css_class (label, "test-label");
+  gtk_window_set_child (GTK_WINDOW (window), label);
+
+  assert_style (label, STYLE_NONE);
+
+  set_style (settings, TRUE, FALSE);
+  assert_style (label, STYLE_DARK);
+
+  set_style (settings, TRUE, TRUE);
+  assert_style (label, STYLE_HC);
+
+  /* Requesting it again after everything has been loaded does nothing */
+  adap_application_preload_stylesheets (app);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  set_style (settings, FALSE, FALSE);
+  assert_style (label, STYLE_NONE);
+
+  g_resources_register (test_get_resource ());
+
+  gtk_window_destroy (GTK_WINDOW (window));
+  adap_settings_end_override (settings);
+  g_object_unref (app);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adap_init ();
+
+  g_test_add_func ("/Adapta/Application/stylesheet_order", test_adap_application_stylesheet_order);
+  g_test_add_func ("/Adapta/Application/preload_stylesheets", test_adap_application_preload_stylesheets);
+
+  return g_test_run ();
+}
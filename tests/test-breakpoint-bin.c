@@ -43,6 +43,240 @@ test_adap_breakpoint_bin_child (void)
   g_assert_finalize_object (bin);
 }
 
+static AdapBreakpoint *
+add_breakpoint (AdapBreakpointBin *bin,
+                const char       *condition)
+{
+  AdapBreakpoint *breakpoint =
+    adap_breakpoint_new (adap_breakpoint_condition_parse (condition));
+
+  adap_breakpoint_bin_add_breakpoint (bin, breakpoint);
+
+  return breakpoint;
+}
+
+static AdapBreakpoint *
+allocate_bin (AdapBreakpointBin *bin,
+              int               width,
+              int               height)
+{
+  gtk_widget_allocate (GTK_WIDGET (bin), width, height, -1, NULL);
+
+  return adap_breakpoint_bin_get_current_breakpoint (bin);
+}
+
+static void
+test_adap_breakpoint_bin_breakpoints (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  GtkSettings *settings = gtk_settings_get_default ();
+  AdapBreakpoint *narrow, *narrow_pt, *wide;
+  AdapBreakpointCondition *condition;
+  int dpi;
+
+  g_object_get (settings, "gtk-xft-dpi", &dpi, NULL);
+  g_object_set (settings, "gtk-xft-dpi", 96 * PANGO_SCALE, NULL);
+
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+  adap_breakpoint_bin_set_child (bin, gtk_box_new (GTK_ORIENTATION_VERTICAL, 0));
+
+  /* The last added breakpoint is checked first */
+  narrow = add_breakpoint (bin, "max-width: 400px");
+  narrow_pt = add_breakpoint (bin, "max-width: 150pt");
+  wide = add_breakpoint (bin, "min-width: 600px and min-aspect-ratio: 3");
+
+  g_assert_null (allocate_bin (bin, 500, 300));
+  g_assert_true (allocate_bin (bin, 350, 300) == narrow);
+  g_assert_true (allocate_bin (bin, 400, 300) == narrow);
+  g_assert_null (allocate_bin (bin, 401, 300));
+  g_assert_true (allocate_bin (bin, 200, 300) == narrow_pt);
+  g_assert_true (allocate_bin (bin, 201, 300) == narrow);
+  g_assert_null (allocate_bin (bin, 700, 300));
+  g_assert_true (allocate_bin (bin, 700, 200) == wide);
+  g_assert_null (allocate_bin (bin, 700, 300));
+
+  /* Lengths in pt depend on the DPI */
+  g_object_set (settings, "gtk-xft-dpi", 192 * PANGO_SCALE, NULL);
+  g_assert_true (allocate_bin (bin, 201, 300) == narrow_pt);
+  g_assert_true (allocate_bin (bin, 400, 300) == narrow_pt);
+
+  /* Changing a condition is picked up */
+  condition = adap_breakpoint_condition_parse ("max-width: 10px");
+  adap_breakpoint_set_condition (narrow_pt, condition);
+  adap_breakpoint_condition_free (condition);
+  g_assert_true (allocate_bin (bin, 400, 300) == narrow);
+
+  g_object_set (settings, "gtk-xft-dpi", dpi, NULL);
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+notify_spacing_cb (GtkWidget  *box,
+                   GParamSpec *pspec,
+                   GtkAlign   *halign)
+{
+  *halign = gtk_widget_get_halign (box);
+}
+
+static void
+notify_halign_cb (GtkWidget  *box,
+                  GParamSpec *pspec,
+                  int        *spacing)
+{
+  *spacing = gtk_box_get_spacing (GTK_BOX (box));
+}
+
+static void
+test_adap_breakpoint_bin_setters (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  GtkWidget *box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  AdapBreakpoint *breakpoint;
+  GtkAlign halign = GTK_ALIGN_FILL;
+  int spacing = -1, notified = 0;
+
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+  adap_breakpoint_bin_set_child (bin, box);
+
+  breakpoint = add_breakpoint (bin, "max-width: 400px");
+  adap_breakpoint_add_setters (breakpoint,
+                              G_OBJECT (box), "orientation", GTK_ORIENTATION_VERTICAL,
+                              G_OBJECT (box), "spacing", 6,
+                              G_OBJECT (box), "halign", GTK_ALIGN_END,
+                              NULL);
+
+  g_signal_connect_swapped (box, "notify::orientation", G_CALLBACK (increment), &notified);
+  g_signal_connect (box, "notify::spacing", G_CALLBACK (notify_spacing_cb), &halign);
+  g_signal_connect (box, "notify::halign", G_CALLBACK (notify_halign_cb), &spacing);
+
+  g_assert_null (allocate_bin (bin, 500, 300));
+  g_assert_true (allocate_bin (bin, 300, 300) == breakpoint);
+
+  /* Notifications are only emitted once all setters are applied */
+  g_assert_cmpint (halign, ==, GTK_ALIGN_END);
+  g_assert_cmpint (spacing, ==, 6);
+
+  /* Setters that don't change anything are skipped */
+  g_assert_cmpint (notified, ==, 0);
+
+  g_assert_null (allocate_bin (bin, 500, 300));
+  g_assert_cmpint (halign, ==, GTK_ALIGN_FILL);
+  g_assert_cmpint (spacing, ==, 0);
+  g_assert_cmpint (notified, ==, 0);
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+test_adap_breakpoint_bin_hysteresis (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  AdapBreakpoint *narrow;
+  int notified = 0;
+
+  g_signal_connect_swapped (bin, "notify::hysteresis", G_CALLBACK (increment), &notified);
+
+  adap_breakpoint_bin_set_hysteresis (bin, 20);
+  g_assert_cmpint (adap_breakpoint_bin_get_hysteresis (bin), ==, 20);
+  g_assert_cmpint (notified, ==, 1);
+
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+  adap_breakpoint_bin_set_child (bin, gtk_box_new (GTK_ORIENTATION_VERTICAL, 0));
+
+  narrow = add_breakpoint (bin, "max-width: 400px");
+
+  g_assert_null (allocate_bin (bin, 500, 300));
+  g_assert_null (allocate_bin (bin, 390, 300));
+  g_assert_null (allocate_bin (bin, 381, 300));
+  g_assert_true (allocate_bin (bin, 380, 300) == narrow);
+  g_assert_true (allocate_bin (bin, 420, 300) == narrow);
+  g_assert_null (allocate_bin (bin, 421, 300));
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+test_adap_breakpoint_bin_settle_frames (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  AdapBreakpoint *narrow;
+  int notified = 0;
+
+  g_signal_connect_swapped (bin, "notify::settle-frames", G_CALLBACK (increment), &notified);
+
+  adap_breakpoint_bin_set_settle_frames (bin, 3);
+  g_assert_cmpuint (adap_breakpoint_bin_get_settle_frames (bin), ==, 3);
+  g_assert_cmpint (notified, ==, 1);
+
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+  adap_breakpoint_bin_set_child (bin, gtk_box_new (GTK_ORIENTATION_VERTICAL, 0));
+
+  narrow = add_breakpoint (bin, "max-width: 400px");
+
+  g_assert_null (allocate_bin (bin, 500, 300));
+
+  /* Without any frames, the size never settles */
+  g_assert_null (allocate_bin (bin, 300, 300));
+  g_assert_null (allocate_bin (bin, 300, 300));
+
+  adap_breakpoint_bin_set_settle_frames (bin, 0);
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_true (allocate_bin (bin, 300, 300) == narrow);
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+test_adap_breakpoint_bin_transition_mode (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  AdapBreakpointTransitionMode mode;
+  int notified = 0;
+
+  g_signal_connect_swapped (bin, "notify::transition-mode", G_CALLBACK (increment), &notified);
+
+  g_object_get (bin, "transition-mode", &mode, NULL);
+  g_assert_cmpint (mode, ==, ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE);
+
+  adap_breakpoint_bin_set_transition_mode (bin, ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE);
+  g_assert_cmpint (notified, ==, 0);
+
+  adap_breakpoint_bin_set_transition_mode (bin, ADAP_BREAKPOINT_TRANSITION_FAST);
+  g_assert_cmpint (adap_breakpoint_bin_get_transition_mode (bin), ==, ADAP_BREAKPOINT_TRANSITION_FAST);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (bin, "transition-mode", ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE, NULL);
+  g_assert_cmpint (adap_breakpoint_bin_get_transition_mode (bin), ==, ADAP_BREAKPOINT_TRANSITION_FLICKER_FREE);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (bin);
+}
+
+static void
+test_adap_breakpoint_bin_transition_fast_no_frame (void)
+{
+  AdapBreakpointBin *bin = g_object_ref_sink (ADAP_BREAKPOINT_BIN (adap_breakpoint_bin_new ()));
+  GtkWidget *child = gtk_label_new ("");
+  AdapBreakpoint *breakpoint;
+
+  adap_breakpoint_bin_set_transition_mode (bin, ADAP_BREAKPOINT_TRANSITION_FAST);
+  adap_breakpoint_bin_set_child (bin, child);
+  gtk_widget_set_size_request (GTK_WIDGET (bin), 100, 100);
+
+  breakpoint = add_breakpoint (bin, "max-width: 200px");
+
+  g_assert_null (allocate_bin (bin, 300, 300));
+  g_assert_cmpint (gtk_widget_get_width (child), ==, 300);
+
+  /* Nothing was rendered yet, so the old layout is allocated at the new size
+   * to render the transition frame instead */
+  g_assert_true (allocate_bin (bin, 150, 300) == breakpoint);
+  g_assert_cmpint (gtk_widget_get_width (child), ==, 150);
+
+  g_assert_finalize_object (bin);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -51,6 +285,12 @@ main (int   argc,
   adap_init ();
 
   g_test_add_func ("/Adapta/BreakpointBin/child", test_adap_breakpoint_bin_child);
+  g_test_add_func ("/Adapta/BreakpointBin/breakpoints", test_adap_breakpoint_bin_breakpoints);
+  g_test_add_func ("/Adapta/BreakpointBin/setters", test_adap_breakpoint_bin_setters);
+  g_test_add_func ("/Adapta/BreakpointBin/hysteresis", test_adap_breakpoint_bin_hysteresis);
+  g_test_add_func ("/Adapta/BreakpointBin/settle_frames", test_adap_breakpoint_bin_settle_frames);
+  g_test_add_func ("/Adapta/BreakpointBin/transition_mode", test_adap_breakpoint_bin_transition_mode);
+  g_test_add_func ("/Adapta/BreakpointBin/transition_fast_no_frame", test_adap_breakpoint_bin_transition_fast_no_frame);
 
   return g_test_run ();
 }
@@ -41,6 +41,56 @@ test_adap_carousel_indicator_dots_carousel (void)
   g_assert_finalize_object (carousel);
 }
 
+static int
+measure_indicator (GtkWidget *widget)
+{
+  int size;
+
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &size, NULL, NULL);
+
+  return size;
+}
+
+static void
+test_adap_carousel_indicator_dots_max_dots (void)
+{
+  AdapCarouselIndicatorDots *dots = g_object_ref_sink (ADAP_CAROUSEL_INDICATOR_DOTS (adap_carousel_indicator_dots_new ()));
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  guint max_dots;
+  int i, width, height, notified = 0;
+
+  g_signal_connect_swapped (dots, "notify::max-dots", G_CALLBACK (increment), &notified);
+
+  for (i = 0; i < 20; i++)
+    adap_carousel_append (carousel, gtk_label_new (""));
+
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_VERTICAL, width,
+                      NULL, &height, NULL, NULL);
+  gtk_widget_allocate (GTK_WIDGET (carousel), width, height, 0, NULL);
+
+  adap_carousel_indicator_dots_set_carousel (dots, carousel);
+
+  g_assert_cmpuint (adap_carousel_indicator_dots_get_max_dots (dots), ==, 0);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (dots)), ==, 20 * (2 * 4 + 7) + 2 * 6);
+
+  adap_carousel_indicator_dots_set_max_dots (dots, 5);
+  g_assert_cmpuint (adap_carousel_indicator_dots_get_max_dots (dots), ==, 5);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (dots)), ==, 5 * (2 * 4 + 7) + 2 * 6);
+
+  g_object_set (dots, "max-dots", 30, NULL);
+  g_object_get (dots, "max-dots", &max_dots, NULL);
+  g_assert_cmpuint (max_dots, ==, 30);
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (dots)), ==, 20 * (2 * 4 + 7) + 2 * 6);
+
+  g_assert_finalize_object (dots);
+  g_assert_finalize_object (carousel);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -49,5 +99,6 @@ main (int   argc,
   adap_init ();
 
   g_test_add_func("/Adapta/CarouselIndicatorDots/carousel", test_adap_carousel_indicator_dots_carousel);
+  g_test_add_func("/Adapta/CarouselIndicatorDots/max_dots", test_adap_carousel_indicator_dots_max_dots);
   return g_test_run();
 }
@@ -41,6 +41,56 @@ test_adap_carousel_indicator_lines_carousel (void)
   g_assert_finalize_object (carousel);
 }
 
+static int
+measure_indicator (GtkWidget *widget)
+{
+  int size;
+
+  gtk_widget_measure (widget, GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &size, NULL, NULL);
+
+  return size;
+}
+
+static void
+test_adap_carousel_indicator_lines_max_lines (void)
+{
+  AdapCarouselIndicatorLines *lines = g_object_ref_sink (ADAP_CAROUSEL_INDICATOR_LINES (adap_carousel_indicator_lines_new ()));
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  guint max_lines;
+  int i, width, height, notified = 0;
+
+  g_signal_connect_swapped (lines, "notify::max-lines", G_CALLBACK (increment), &notified);
+
+  for (i = 0; i < 20; i++)
+    adap_carousel_append (carousel, gtk_label_new (""));
+
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_HORIZONTAL, -1,
+                      NULL, &width, NULL, NULL);
+  gtk_widget_measure (GTK_WIDGET (carousel), GTK_ORIENTATION_VERTICAL, width,
+                      NULL, &height, NULL, NULL);
+  gtk_widget_allocate (GTK_WIDGET (carousel), width, height, 0, NULL);
+
+  adap_carousel_indicator_lines_set_carousel (lines, carousel);
+
+  g_assert_cmpuint (adap_carousel_indicator_lines_get_max_lines (lines), ==, 0);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (lines)), ==, 20 * (35 + 5) + 2 * 2);
+
+  adap_carousel_indicator_lines_set_max_lines (lines, 5);
+  g_assert_cmpuint (adap_carousel_indicator_lines_get_max_lines (lines), ==, 5);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (lines)), ==, 5 * (35 + 5) + 2 * 2);
+
+  g_object_set (lines, "max-lines", 30, NULL);
+  g_object_get (lines, "max-lines", &max_lines, NULL);
+  g_assert_cmpuint (max_lines, ==, 30);
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_cmpint (measure_indicator (GTK_WIDGET (lines)), ==, 20 * (35 + 5) + 2 * 2);
+
+  g_assert_finalize_object (lines);
+  g_assert_finalize_object (carousel);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -49,5 +99,6 @@ main (int   argc,
   adap_init ();
 
   g_test_add_func("/Adapta/CarouselInidicatorLines/carousel", test_adap_carousel_indicator_lines_carousel);
+  g_test_add_func("/Adapta/CarouselIndicatorLines/max_lines", test_adap_carousel_indicator_lines_max_lines);
   return g_test_run();
 }
@@ -5,6 +5,7 @@
  */
 
 #include <adapta.h>
+#include "adap-swipeable-private.h"
 
 static void
 increment (int *data)
@@ -12,6 +13,69 @@ increment (int *data)
   (*data)++;
 }
 
+#define TEST_TYPE_CHILD (test_child_get_type ())
+
+G_DECLARE_FINAL_TYPE (TestChild, test_child, TEST, CHILD, GtkWidget)
+
+struct _TestChild
+{
+  GtkWidget parent_instance;
+
+  int size;
+  int n_measured;
+};
+
+G_DEFINE_FINAL_TYPE (TestChild, test_child, GTK_TYPE_WIDGET)
+
+static void
+test_child_measure (GtkWidget      *widget,
+                    GtkOrientation  orientation,
+                    int             for_size,
+                    int            *minimum,
+                    int            *natural,
+                    int            *minimum_baseline,
+                    int            *natural_baseline)
+{
+  TestChild *self = TEST_CHILD (widget);
+
+  self->n_measured++;
+
+  *minimum = 0;
+  *natural = self->size;
+}
+
+static void
+test_child_class_init (TestChildClass *klass)
+{
+  GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+
+  widget_class->measure = test_child_measure;
+}
+
+static void
+test_child_init (TestChild *self)
+{
+}
+
+static TestChild *
+test_child_new (int size)
+{
+  TestChild *self = g_object_new (TEST_TYPE_CHILD, NULL);
+
+  self->size = size;
+
+  return self;
+}
+
+static void
+test_child_set_size (TestChild *self,
+                     int        size)
+{
+  self->size = size;
+
+  gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
 static void
 allocate_carousel (AdapCarousel *carousel)
 {
@@ -296,6 +360,303 @@ test_adap_carousel_reveal_duration (void)
   g_assert_finalize_object (carousel);
 }
 
+static void
+assert_snap_points_cached (AdapCarousel *carousel)
+{
+  double *points;
+  const double *cached;
+  int i, n, n_cached;
+
+  points = adap_swipeable_get_snap_points (ADAP_SWIPEABLE (carousel), &n);
+  cached = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (carousel), &n_cached);
+
+  g_assert_cmpint (n, ==, n_cached);
+
+  for (i = 0; i < n; i++)
+    g_assert_true (G_APPROX_VALUE (points[i], cached[i], DBL_EPSILON));
+
+  g_free (points);
+}
+
+static void
+test_adap_carousel_snap_points (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  GtkWidget *child1, *child2, *child3;
+  const double *points;
+  int n;
+
+  child1 = gtk_label_new ("");
+  child2 = gtk_label_new ("");
+  child3 = gtk_label_new ("");
+
+  assert_snap_points_cached (carousel);
+
+  adap_carousel_append (carousel, child1);
+  adap_carousel_append (carousel, child2);
+  allocate_carousel (carousel);
+  assert_snap_points_cached (carousel);
+
+  points = adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (carousel), &n);
+  g_assert_true (points == adap_swipeable_peek_snap_points (ADAP_SWIPEABLE (carousel), NULL));
+  g_assert_cmpint (n, ==, 2);
+
+  adap_carousel_insert (carousel, child3, 1);
+  allocate_carousel (carousel);
+  assert_snap_points_cached (carousel);
+
+  adap_carousel_reorder (carousel, child3, 0);
+  allocate_carousel (carousel);
+  assert_snap_points_cached (carousel);
+
+  adap_carousel_remove (carousel, child1);
+  allocate_carousel (carousel);
+  assert_snap_points_cached (carousel);
+
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adap_carousel_measure_cache (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  TestChild *child1 = test_child_new (50);
+  TestChild *child2 = test_child_new (50);
+  int i;
+
+  adap_carousel_append (carousel, GTK_WIDGET (child1));
+  adap_carousel_append (carousel, GTK_WIDGET (child2));
+  allocate_carousel (carousel);
+  gtk_widget_allocate (GTK_WIDGET (carousel), 200, 100, 0, NULL);
+  g_assert_cmpfloat (adap_swipeable_get_distance (ADAP_SWIPEABLE (carousel)), ==, 50);
+
+  child1->n_measured = 0;
+  child2->n_measured = 0;
+
+  /* Allocating on every frame of a swipe doesn't measure the children */
+  for (i = 0; i < 10; i++)
+    gtk_widget_allocate (GTK_WIDGET (carousel), 200, 100, 0, NULL);
+
+  g_assert_cmpint (child1->n_measured, ==, 0);
+  g_assert_cmpint (child2->n_measured, ==, 0);
+
+  /* Only the child that queued a resize is measured again */
+  test_child_set_size (child1, 100);
+  gtk_widget_allocate (GTK_WIDGET (carousel), 200, 100, 0, NULL);
+
+  g_assert_cmpint (child1->n_measured, >, 0);
+  g_assert_cmpint (child2->n_measured, ==, 0);
+  g_assert_cmpfloat (adap_swipeable_get_distance (ADAP_SWIPEABLE (carousel)), ==, 100);
+
+  g_assert_finalize_object (carousel);
+}
+
+static void
+test_adap_carousel_child_grows (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  GtkWidget *child = gtk_label_new ("a");
+  int width, height;
+
+  adap_carousel_append (carousel, child);
+  gtk_widget_set_size_request (child, 50, -1);
+  allocate_carousel (carousel);
+
+  width = gtk_widget_get_width (GTK_WIDGET (carousel)) + 100;
+  height = gtk_widget_get_height (GTK_WIDGET (carousel));
+
+  gtk_widget_allocate (GTK_WIDGET (carousel), width, height, 0, NULL);
+  g_assert_cmpint (gtk_widget_get_width (child), ==, 50);
+
+  /* Reallocating without measuring the carousel again must still use the
+   * child's new size */
+  gtk_widget_set_size_request (child, 100, -1);
+  gtk_widget_allocate (GTK_WIDGET (carousel), width, height, 0, NULL);
+  g_assert_cmpint (gtk_widget_get_width (child), ==, 100);
+
+  g_assert_finalize_object (carousel);
+}
+
+static GtkWidget *
+create_page_cb (GtkStringObject *item,
+                int             *n_created)
+{
+  (*n_created)++;
+
+  return gtk_label_new (gtk_string_object_get_string (item));
+}
+
+static int
+count_widgets (AdapCarousel *carousel)
+{
+  GtkWidget *child;
+  int n = 0;
+
+  for (child = gtk_widget_get_first_child (GTK_WIDGET (carousel));
+       child;
+       child = gtk_widget_get_next_sibling (child))
+    if (gtk_widget_get_child_visible (child))
+      n++;
+
+  return n;
+}
+
+static void
+test_adap_carousel_bind_model (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  GtkStringList *list = gtk_string_list_new (NULL);
+  int notified = 0, n_created = 0;
+  int i;
+
+  for (i = 0; i < 100; i++) {
+    char *str = g_strdup_printf ("%d", i);
+
+    gtk_string_list_append (list, str);
+    g_free (str);
+  }
+
+  g_signal_connect_swapped (carousel, "notify::n-pages", G_CALLBACK (increment), &notified);
+
+  adap_carousel_bind_model (carousel, G_LIST_MODEL (list),
+                            (AdapCarouselCreatePageFunc) create_page_cb,
+                            &n_created, NULL);
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 100);
+  g_assert_cmpint (notified, ==, 1);
+
+  /* Only the current page and its neighbor are instantiated */
+  g_assert_cmpint (n_created, ==, 2);
+  g_assert_cmpint (count_widgets (carousel), ==, 2);
+  g_assert_nonnull (adap_carousel_get_nth_page (carousel, 0));
+  g_assert_nonnull (adap_carousel_get_nth_page (carousel, 1));
+  g_assert_null (adap_carousel_get_nth_page (carousel, 2));
+
+  allocate_carousel (carousel);
+  adap_carousel_scroll_to_nth_page (carousel, 50, FALSE);
+  g_assert_cmpfloat_with_epsilon (adap_carousel_get_position (carousel), 50, DBL_EPSILON);
+  g_assert_cmpint (count_widgets (carousel), ==, 3);
+  g_assert_null (adap_carousel_get_nth_page (carousel, 0));
+  g_assert_nonnull (adap_carousel_get_nth_page (carousel, 49));
+  g_assert_nonnull (adap_carousel_get_nth_page (carousel, 50));
+  g_assert_nonnull (adap_carousel_get_nth_page (carousel, 51));
+
+  gtk_string_list_splice (list, 90, 10, NULL);
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 90);
+  g_assert_cmpint (notified, ==, 2);
+
+  gtk_string_list_append (list, "100");
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 91);
+  g_assert_cmpint (notified, ==, 3);
+
+  adap_carousel_bind_model (carousel, NULL, NULL, NULL, NULL);
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 0);
+  g_assert_cmpint (count_widgets (carousel), ==, 0);
+
+  g_assert_finalize_object (carousel);
+  g_assert_finalize_object (list);
+}
+
+static const char *
+get_page_label (AdapCarousel *carousel,
+                guint        n)
+{
+  GtkWidget *page = adap_carousel_get_nth_page (carousel, n);
+
+  g_assert_nonnull (page);
+
+  return gtk_label_get_label (GTK_LABEL (page));
+}
+
+static void
+test_adap_carousel_bind_model_changes (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  GtkStringList *list = gtk_string_list_new (NULL);
+  const char * const prepended[] = { "a", "b", "c", "d", "e", NULL };
+  const char * const replaced[] = { "x", NULL };
+  int notified = 0, n_created = 0;
+  int i;
+
+  for (i = 0; i < 100; i++) {
+    char *str = g_strdup_printf ("%d", i);
+
+    gtk_string_list_append (list, str);
+    g_free (str);
+  }
+
+  adap_carousel_bind_model (carousel, G_LIST_MODEL (list),
+                            (AdapCarouselCreatePageFunc) create_page_cb,
+                            &n_created, NULL);
+  allocate_carousel (carousel);
+
+  g_signal_connect_swapped (carousel, "notify::n-pages", G_CALLBACK (increment), &notified);
+
+  /* Prepending several items notifies once and stays on the current item */
+  gtk_string_list_splice (list, 0, 0, prepended);
+  allocate_carousel (carousel);
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 105);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpfloat_with_epsilon (adap_carousel_get_position (carousel), 5, DBL_EPSILON);
+  g_assert_cmpstr (get_page_label (carousel, 5), ==, "0");
+
+  /* Replacing the current item doesn't change the number of pages */
+  gtk_string_list_splice (list, 5, 1, replaced);
+  allocate_carousel (carousel);
+  g_assert_cmpuint (adap_carousel_get_n_pages (carousel), ==, 105);
+  g_assert_cmpint (notified, ==, 1);
+  g_assert_cmpfloat_with_epsilon (adap_carousel_get_position (carousel), 5, DBL_EPSILON);
+  g_assert_cmpstr (get_page_label (carousel, 5), ==, "x");
+
+  adap_carousel_bind_model (carousel, NULL, NULL, NULL, NULL);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (carousel);
+  g_assert_finalize_object (list);
+}
+
+static void
+test_adap_carousel_bind_model_recycle (void)
+{
+  AdapCarousel *carousel = g_object_ref_sink (ADAP_CAROUSEL (adap_carousel_new ()));
+  GtkStringList *list = gtk_string_list_new (NULL);
+  GtkWidget *page0, *page1;
+  int n_created = 0;
+  int i;
+
+  for (i = 0; i < 100; i++) {
+    char *str = g_strdup_printf ("%d", i);
+
+    gtk_string_list_append (list, str);
+    g_free (str);
+  }
+
+  adap_carousel_bind_model (carousel, G_LIST_MODEL (list),
+                            (AdapCarouselCreatePageFunc) create_page_cb,
+                            &n_created, NULL);
+  allocate_carousel (carousel);
+
+  page0 = adap_carousel_get_nth_page (carousel, 0);
+  page1 = adap_carousel_get_nth_page (carousel, 1);
+  g_assert_cmpint (n_created, ==, 2);
+
+  adap_carousel_scroll_to_nth_page (carousel, 50, FALSE);
+  g_assert_cmpint (n_created, ==, 5);
+  g_assert_cmpint (count_widgets (carousel), ==, 3);
+
+  /* Scrolling back reuses the widgets that were scrolled away from */
+  adap_carousel_scroll_to_nth_page (carousel, 0, FALSE);
+  g_assert_cmpint (n_created, ==, 5);
+  g_assert_cmpint (count_widgets (carousel), ==, 2);
+  g_assert_true (adap_carousel_get_nth_page (carousel, 0) == page0);
+  g_assert_true (adap_carousel_get_nth_page (carousel, 1) == page1);
+
+  adap_carousel_bind_model (carousel, NULL, NULL, NULL, NULL);
+  g_assert_null (gtk_widget_get_first_child (GTK_WIDGET (carousel)));
+
+  g_assert_finalize_object (carousel);
+  g_assert_finalize_object (list);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -310,5 +671,11 @@ main (int   argc,
   g_test_add_func("/Adapta/Carousel/allow_mouse_drag", test_adap_carousel_allow_mouse_drag);
   g_test_add_func("/Adapta/Carousel/allow_long_swipes", test_adap_carousel_allow_long_swipes);
   g_test_add_func("/Adapta/Carousel/reveal_duration", test_adap_carousel_reveal_duration);
+  g_test_add_func("/Adapta/Carousel/snap_points", test_adap_carousel_snap_points);
+  g_test_add_func("/Adapta/Carousel/measure_cache", test_adap_carousel_measure_cache);
+  g_test_add_func("/Adapta/Carousel/child_grows", test_adap_carousel_child_grows);
+  g_test_add_func("/Adapta/Carousel/bind_model", test_adap_carousel_bind_model);
+  g_test_add_func("/Adapta/Carousel/bind_model_changes", test_adap_carousel_bind_model_changes);
+  g_test_add_func("/Adapta/Carousel/bind_model_recycle", test_adap_carousel_bind_model_recycle);
   return g_test_run();
 }
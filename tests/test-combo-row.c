@@ -5,6 +5,7 @@
  */
 
 #include <adapta.h>
+#include "adap-combo-row-private.h"
 
 static void
 increment (int *data)
@@ -12,6 +13,44 @@ increment (int *data)
   (*data)++;
 }
 
+static void
+wait_for_filter (GListModel *results)
+{
+  int i;
+
+  /* The filter model is incremental, let it run but don't hang if it's stuck */
+  for (i = 0; i < 100 && gtk_filter_list_model_get_pending (GTK_FILTER_LIST_MODEL (results)) > 0; i++)
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_cmpuint (gtk_filter_list_model_get_pending (GTK_FILTER_LIST_MODEL (results)), ==, 0);
+}
+
+static void
+filter_changed_cb (GtkFilter       *filter,
+                   GtkFilterChange  change,
+                   GtkFilterChange *last_change)
+{
+  *last_change = change;
+}
+
+static AdapComboRow *
+create_orientation_row (const char *property)
+{
+  AdapComboRow *row = g_object_ref_sink (ADAP_COMBO_ROW (adap_combo_row_new ()));
+  GtkExpression *expr;
+  GListModel *model;
+
+  expr = gtk_property_expression_new (ADAP_TYPE_ENUM_LIST_ITEM, NULL, property);
+  adap_combo_row_set_expression (row, expr);
+  gtk_expression_unref (expr);
+
+  model = G_LIST_MODEL (adap_enum_list_model_new (GTK_TYPE_ORIENTATION));
+  adap_combo_row_set_model (row, model);
+  g_object_unref (model);
+
+  return row;
+}
+
 static void
 test_adap_combo_row_set_for_enum (void)
 {
@@ -111,6 +150,144 @@ test_adap_combo_row_use_subtitle (void)
   g_assert_finalize_object (row);
 }
 
+static void
+test_adap_combo_row_search (void)
+{
+  AdapComboRow *row = create_orientation_row ("nick");
+  GListModel *results = adap_combo_row_get_search_results (row);
+  AdapEnumListItem *item;
+
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 2);
+
+  adap_combo_row_set_search_text (row, "HOR");
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 1);
+
+  item = g_list_model_get_item (results, 0);
+  g_assert_cmpstr (adap_enum_list_item_get_nick (item), ==, "horizontal");
+  g_object_unref (item);
+
+  adap_combo_row_set_search_text (row, "nothing");
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 0);
+
+  adap_combo_row_set_search_text (row, NULL);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 2);
+
+  g_assert_finalize_object (row);
+}
+
+static void
+test_adap_combo_row_search_no_expression (void)
+{
+  AdapComboRow *row = g_object_ref_sink (ADAP_COMBO_ROW (adap_combo_row_new ()));
+  GListModel *model = G_LIST_MODEL (adap_enum_list_model_new (GTK_TYPE_ORIENTATION));
+  GListModel *results;
+
+  adap_combo_row_set_model (row, model);
+  results = adap_combo_row_get_search_results (row);
+
+  adap_combo_row_set_search_text (row, "nothing");
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 2);
+
+  g_assert_finalize_object (row);
+  g_assert_finalize_object (model);
+}
+
+static void
+test_adap_combo_row_search_expression_changed (void)
+{
+  AdapComboRow *row = create_orientation_row ("nick");
+  GListModel *results = adap_combo_row_get_search_results (row);
+  GtkExpression *expr;
+
+  /* Nicks don't contain the prefix, but names do */
+  adap_combo_row_set_search_text (row, "gtk_orientation");
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 0);
+
+  expr = gtk_property_expression_new (ADAP_TYPE_ENUM_LIST_ITEM, NULL, "name");
+  adap_combo_row_set_expression (row, expr);
+  gtk_expression_unref (expr);
+
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 2);
+
+  g_assert_finalize_object (row);
+}
+
+static void
+test_adap_combo_row_search_model_changed (void)
+{
+  AdapComboRow *row = g_object_ref_sink (ADAP_COMBO_ROW (adap_combo_row_new ()));
+  GListStore *store = g_list_store_new (GTK_TYPE_STRING_OBJECT);
+  GtkStringObject *string = gtk_string_object_new ("Item");
+  GtkExpression *expr;
+  GListModel *model;
+  GListModel *results;
+
+  expr = gtk_property_expression_new (GTK_TYPE_STRING_OBJECT, NULL, "string");
+  adap_combo_row_set_expression (row, expr);
+  gtk_expression_unref (expr);
+
+  g_list_store_append (store, string);
+  adap_combo_row_set_model (row, G_LIST_MODEL (store));
+
+  /* Searching caches the key of every item */
+  adap_combo_row_set_search_text (row, "item");
+  wait_for_filter (adap_combo_row_get_search_results (row));
+  g_assert_cmpuint (g_list_model_get_n_items (adap_combo_row_get_search_results (row)), ==, 1);
+
+  model = G_LIST_MODEL (gtk_string_list_new ((const char *[]) { "Other item", "Something else", NULL }));
+  adap_combo_row_set_model (row, model);
+  g_object_unref (model);
+
+  /* The cached keys must not outlive the old model */
+  g_assert_finalize_object (store);
+  g_assert_finalize_object (string);
+
+  results = adap_combo_row_get_search_results (row);
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 1);
+
+  g_assert_finalize_object (row);
+}
+
+static void
+test_adap_combo_row_search_change_hints (void)
+{
+  AdapComboRow *row = create_orientation_row ("nick");
+  GListModel *results = adap_combo_row_get_search_results (row);
+  GtkFilterChange last_change = -1;
+  GtkFilter *filter;
+
+  adap_combo_row_set_search_text (row, "h");
+  wait_for_filter (results);
+
+  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (results));
+  g_assert_nonnull (filter);
+  g_signal_connect (filter, "changed", G_CALLBACK (filter_changed_cb), &last_change);
+
+  adap_combo_row_set_search_text (row, "ho");
+  g_assert_cmpint (last_change, ==, GTK_FILTER_CHANGE_MORE_STRICT);
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 1);
+
+  adap_combo_row_set_search_text (row, "h");
+  g_assert_cmpint (last_change, ==, GTK_FILTER_CHANGE_LESS_STRICT);
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 1);
+
+  adap_combo_row_set_search_text (row, "v");
+  g_assert_cmpint (last_change, ==, GTK_FILTER_CHANGE_DIFFERENT);
+  wait_for_filter (results);
+  g_assert_cmpuint (g_list_model_get_n_items (results), ==, 1);
+
+  g_signal_handlers_disconnect_by_func (filter, filter_changed_cb, &last_change);
+
+  g_assert_finalize_object (row);
+}
 
 int
 main (int   argc,
@@ -122,6 +299,11 @@ main (int   argc,
   g_test_add_func("/Adapta/ComboRow/set_for_enum", test_adap_combo_row_set_for_enum);
   g_test_add_func("/Adapta/ComboRow/selected", test_adap_combo_row_selected);
   g_test_add_func("/Adapta/ComboRow/use_subtitle", test_adap_combo_row_use_subtitle);
+  g_test_add_func("/Adapta/ComboRow/search", test_adap_combo_row_search);
+  g_test_add_func("/Adapta/ComboRow/search_no_expression", test_adap_combo_row_search_no_expression);
+  g_test_add_func("/Adapta/ComboRow/search_expression_changed", test_adap_combo_row_search_expression_changed);
+  g_test_add_func("/Adapta/ComboRow/search_model_changed", test_adap_combo_row_search_model_changed);
+  g_test_add_func("/Adapta/ComboRow/search_change_hints", test_adap_combo_row_search_change_hints);
 
   return g_test_run();
 }
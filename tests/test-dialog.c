@@ -153,6 +153,62 @@ test_adap_dialog_presentation_mode (void)
   g_assert_finalize_object (dialog);
 }
 
+static void
+test_adap_dialog_breakpoint_hysteresis (void)
+{
+  AdapDialog *dialog = g_object_ref_sink (adap_dialog_new ());
+  int hysteresis;
+  int notified = 0;
+
+  g_assert_nonnull (dialog);
+
+  g_signal_connect_swapped (dialog, "notify::breakpoint-hysteresis", G_CALLBACK (increment), &notified);
+
+  g_object_get (dialog, "breakpoint-hysteresis", &hysteresis, NULL);
+  g_assert_cmpint (hysteresis, ==, 0);
+
+  adap_dialog_set_breakpoint_hysteresis (dialog, 0);
+  g_assert_cmpint (notified, ==, 0);
+
+  adap_dialog_set_breakpoint_hysteresis (dialog, 20);
+  g_assert_cmpint (adap_dialog_get_breakpoint_hysteresis (dialog), ==, 20);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (dialog, "breakpoint-hysteresis", 10, NULL);
+  g_assert_cmpint (adap_dialog_get_breakpoint_hysteresis (dialog), ==, 10);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (dialog);
+}
+
+static void
+test_adap_dialog_breakpoint_settle_frames (void)
+{
+  AdapDialog *dialog = g_object_ref_sink (adap_dialog_new ());
+  guint settle_frames;
+  int notified = 0;
+
+  g_assert_nonnull (dialog);
+
+  g_signal_connect_swapped (dialog, "notify::breakpoint-settle-frames", G_CALLBACK (increment), &notified);
+
+  g_object_get (dialog, "breakpoint-settle-frames", &settle_frames, NULL);
+  g_assert_cmpuint (settle_frames, ==, 0);
+
+  adap_dialog_set_breakpoint_settle_frames (dialog, 0);
+  g_assert_cmpint (notified, ==, 0);
+
+  adap_dialog_set_breakpoint_settle_frames (dialog, 5);
+  g_assert_cmpuint (adap_dialog_get_breakpoint_settle_frames (dialog), ==, 5);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (dialog, "breakpoint-settle-frames", 3, NULL);
+  g_assert_cmpuint (adap_dialog_get_breakpoint_settle_frames (dialog), ==, 3);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (dialog);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -165,6 +221,8 @@ main (int   argc,
   g_test_add_func ("/Adapta/Dialog/can-close", test_adap_dialog_can_close);
   g_test_add_func ("/Adapta/Dialog/follows-content-size", test_adap_dialog_follows_content_size);
   g_test_add_func ("/Adapta/Dialog/presentation-mode", test_adap_dialog_presentation_mode);
+  g_test_add_func ("/Adapta/Dialog/breakpoint-hysteresis", test_adap_dialog_breakpoint_hysteresis);
+  g_test_add_func ("/Adapta/Dialog/breakpoint-settle-frames", test_adap_dialog_breakpoint_settle_frames);
 
   return g_test_run ();
 }
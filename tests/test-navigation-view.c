@@ -7,6 +7,7 @@
  */
 
 #include <adapta.h>
+#include "adap-navigation-view-private.h"
 
 static void
 increment (int *data)
@@ -598,6 +599,315 @@ test_adap_navigation_view_pop_on_escape (void)
   g_assert_finalize_object (view);
 }
 
+static void
+test_adap_navigation_view_transition_cache (void)
+{
+  AdapNavigationView *view = g_object_ref_sink (ADAP_NAVIGATION_VIEW (adap_navigation_view_new ()));
+  AdapNavigationTransitionCache transition_cache;
+  int notified = 0;
+
+  g_assert_nonnull (view);
+
+  g_signal_connect_swapped (view, "notify::transition-cache", G_CALLBACK (increment), &notified);
+
+  g_object_get (view, "transition-cache", &transition_cache, NULL);
+  g_assert_cmpint (transition_cache, ==, ADAP_NAVIGATION_TRANSITION_CACHE_NONE);
+
+  adap_navigation_view_set_transition_cache (view, ADAP_NAVIGATION_TRANSITION_CACHE_NONE);
+  g_assert_cmpint (notified, ==, 0);
+
+  adap_navigation_view_set_transition_cache (view, ADAP_NAVIGATION_TRANSITION_CACHE_HIDING);
+  g_assert_cmpint (adap_navigation_view_get_transition_cache (view), ==, ADAP_NAVIGATION_TRANSITION_CACHE_HIDING);
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (view, "transition-cache", ADAP_NAVIGATION_TRANSITION_CACHE_ALL, NULL);
+  g_assert_cmpint (adap_navigation_view_get_transition_cache (view), ==, ADAP_NAVIGATION_TRANSITION_CACHE_ALL);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (view);
+}
+
+static void
+wait_for_signal (int *counter)
+{
+  gint64 deadline = g_get_monotonic_time () + 2 * G_USEC_PER_SEC;
+
+  /* Let the transition run frame by frame, but don't hang if it's stuck */
+  while (*counter == 0 && g_get_monotonic_time () < deadline)
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_cmpint (*counter, ==, 1);
+}
+
+static void
+test_adap_navigation_view_transition_cache_transitions (void)
+{
+  AdapNavigationTransitionCache modes[] = {
+    ADAP_NAVIGATION_TRANSITION_CACHE_NONE,
+    ADAP_NAVIGATION_TRANSITION_CACHE_HIDING,
+    ADAP_NAVIGATION_TRANSITION_CACHE_ALL,
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (modes); i++) {
+    GtkWidget *window = gtk_window_new ();
+    AdapNavigationView *view = ADAP_NAVIGATION_VIEW (adap_navigation_view_new ());
+    AdapNavigationPage *page_1 = adap_navigation_page_new (gtk_label_new ("First"), "Page 1");
+    AdapNavigationPage *page_2 = g_object_ref_sink (adap_navigation_page_new (gtk_label_new ("Second"), "Page 2"));
+    int shown_1 = 0, shown_2 = 0, hidden_2 = 0;
+
+    adap_navigation_view_set_transition_cache (view, modes[i]);
+    adap_navigation_view_add (view, page_1);
+
+    gtk_window_set_default_size (GTK_WINDOW (window), 200, 200);
+    gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (view));
+    gtk_window_present (GTK_WINDOW (window));
+
+    g_signal_connect_swapped (page_1, "shown", G_CALLBACK (increment), &shown_1);
+    g_signal_connect_swapped (page_2, "shown", G_CALLBACK (increment), &shown_2);
+    g_signal_connect_swapped (page_2, "hidden", G_CALLBACK (increment), &hidden_2);
+
+    adap_navigation_view_push (view, page_2);
+    wait_for_signal (&shown_2);
+    g_assert_true (adap_navigation_view_get_visible_page (view) == page_2);
+    g_assert_true (gtk_widget_get_child_visible (GTK_WIDGET (page_2)));
+    g_assert_false (gtk_widget_get_child_visible (GTK_WIDGET (page_1)));
+
+    g_assert_true (adap_navigation_view_pop (view));
+    wait_for_signal (&hidden_2);
+    g_assert_cmpint (shown_1, ==, 1);
+    g_assert_true (adap_navigation_view_get_visible_page (view) == page_1);
+    g_assert_true (gtk_widget_get_child_visible (GTK_WIDGET (page_1)));
+
+    g_assert_finalize_object (window);
+    g_assert_finalize_object (page_2);
+  }
+}
+
+static void
+test_adap_navigation_view_transition_cache_reuse (void)
+{
+  GtkWidget *window = gtk_window_new ();
+  AdapNavigationView *view = ADAP_NAVIGATION_VIEW (adap_navigation_view_new ());
+  GtkWidget *label = gtk_label_new ("First");
+  AdapNavigationPage *page_1 = adap_navigation_page_new (label, "Page 1");
+  AdapNavigationPage *page_2 = adap_navigation_page_new (gtk_label_new ("Second"), "Page 2");
+  GdkPaintable *image;
+  gint64 deadline;
+  int shown_2 = 0;
+  int i;
+
+  adap_navigation_view_set_transition_cache (view, ADAP_NAVIGATION_TRANSITION_CACHE_HIDING);
+  adap_navigation_view_add (view, page_1);
+
+  gtk_window_set_default_size (GTK_WINDOW (window), 200, 200);
+  gtk_window_set_child (GTK_WINDOW (window), GTK_WIDGET (view));
+  gtk_window_present (GTK_WINDOW (window));
+
+  g_signal_connect_swapped (page_2, "shown", G_CALLBACK (increment), &shown_2);
+
+  adap_navigation_view_push (view, page_2);
+
+  /* The hiding page is captured on the first frame of the transition */
+  deadline = g_get_monotonic_time () + 2 * G_USEC_PER_SEC;
+  while (!adap_navigation_page_get_transition_image (page_1) && !shown_2 &&
+         g_get_monotonic_time () < deadline)
+    g_main_context_iteration (NULL, FALSE);
+
+  image = adap_navigation_page_get_transition_image (page_1);
+  g_assert_nonnull (image);
+  g_assert_null (adap_navigation_page_get_transition_image (page_2));
+
+  /* Later frames reuse the same image */
+  for (i = 0; i < 3 && !shown_2; i++) {
+    g_main_context_iteration (NULL, TRUE);
+
+    if (!shown_2)
+      g_assert_true (adap_navigation_page_get_transition_image (page_1) == image);
+  }
+
+  /* Changing the page drops the image from within its invalidation */
+  if (!shown_2) {
+    gtk_label_set_label (GTK_LABEL (label), "Changed");
+    g_assert_null (adap_navigation_page_get_transition_image (page_1));
+  }
+
+  wait_for_signal (&shown_2);
+  g_assert_null (adap_navigation_page_get_transition_image (page_1));
+
+  g_assert_finalize_object (window);
+}
+
+static void
+test_adap_navigation_view_max_retained_pages (void)
+{
+  AdapNavigationView *view = g_object_ref_sink (ADAP_NAVIGATION_VIEW (adap_navigation_view_new ()));
+  AdapNavigationPage *page_1, *page_2;
+  guint max_retained_pages;
+  int notified = 0;
+
+  g_assert_nonnull (view);
+
+  adap_navigation_view_set_animate_transitions (view, FALSE);
+
+  g_signal_connect_swapped (view, "notify::max-retained-pages", G_CALLBACK (increment), &notified);
+
+  g_object_get (view, "max-retained-pages", &max_retained_pages, NULL);
+  g_assert_cmpuint (max_retained_pages, ==, 0);
+
+  adap_navigation_view_set_max_retained_pages (view, 0);
+  g_assert_cmpint (notified, ==, 0);
+
+  adap_navigation_view_set_max_retained_pages (view, 1);
+  g_assert_cmpuint (adap_navigation_view_get_max_retained_pages (view), ==, 1);
+  g_assert_cmpint (notified, ==, 1);
+
+  page_1 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 1", "page-1");
+  page_2 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 2", "page-2");
+
+  adap_navigation_view_push (view, page_1);
+  adap_navigation_view_push (view, page_2);
+
+  /* The popped page is kept and can be pushed again by its tag */
+  g_assert_true (adap_navigation_view_pop (view));
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+
+  adap_navigation_view_push_by_tag (view, "page-2");
+  g_assert_true (adap_navigation_view_get_visible_page (view) == page_2);
+
+  /* Dropping the limit removes the page again */
+  g_assert_true (adap_navigation_view_pop (view));
+  g_assert_nonnull (adap_navigation_view_find_page (view, "page-2"));
+
+  g_object_set (view, "max-retained-pages", 0, NULL);
+  g_assert_cmpuint (adap_navigation_view_get_max_retained_pages (view), ==, 0);
+  g_assert_cmpint (notified, ==, 2);
+  g_assert_null (adap_navigation_view_find_page (view, "page-2"));
+
+  g_assert_finalize_object (view);
+}
+
+static void
+test_adap_navigation_view_preload (void)
+{
+  AdapNavigationView *view = g_object_ref_sink (ADAP_NAVIGATION_VIEW (adap_navigation_view_new ()));
+  AdapNavigationPage *page_1, *page_2;
+
+  g_assert_nonnull (view);
+
+  adap_navigation_view_set_animate_transitions (view, FALSE);
+
+  page_1 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 1", "page-1");
+  page_2 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 2", "page-2");
+
+  adap_navigation_view_push (view, page_1);
+
+  /* A preloaded page can be found, but isn't on the stack */
+  adap_navigation_view_preload (view, page_2);
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+  g_assert_true (adap_navigation_view_get_visible_page (view) == page_1);
+
+  adap_navigation_view_preload_tag (view, "page-2");
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  adap_navigation_view_push_by_tag (view, "page-2");
+  g_assert_true (adap_navigation_view_get_visible_page (view) == page_2);
+
+  /* Once pushed, it's removed on pop like any other pushed page */
+  g_assert_true (adap_navigation_view_pop (view));
+  g_assert_null (adap_navigation_view_find_page (view, "page-2"));
+
+  g_assert_finalize_object (view);
+}
+
+static void
+test_adap_navigation_view_preload_retained (void)
+{
+  AdapNavigationView *view = g_object_ref_sink (ADAP_NAVIGATION_VIEW (adap_navigation_view_new ()));
+  AdapNavigationPage *page_1, *page_2, *page_3, *page_4, *page_5, *page_6;
+
+  adap_navigation_view_set_animate_transitions (view, FALSE);
+
+  page_1 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 1", "page-1");
+  page_2 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 2", "page-2");
+  page_3 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 3", "page-3");
+  page_4 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 4", "page-4");
+  page_5 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 5", "page-5");
+  page_6 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 6", "page-6");
+
+  adap_navigation_view_push (view, page_1);
+
+  /* Preloaded pages are kept even without retained pages */
+  adap_navigation_view_preload (view, page_2);
+  adap_navigation_view_preload (view, page_3);
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+  g_assert_true (adap_navigation_view_find_page (view, "page-3") == page_3);
+
+  /* They have their own limit, least recently preloaded first */
+  adap_navigation_view_preload_tag (view, "page-2");
+  adap_navigation_view_preload (view, page_4);
+  adap_navigation_view_preload (view, page_5);
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+  g_assert_true (adap_navigation_view_find_page (view, "page-4") == page_4);
+  g_assert_true (adap_navigation_view_find_page (view, "page-5") == page_5);
+  g_assert_null (adap_navigation_view_find_page (view, "page-3"));
+
+  /* Changing the retention limit doesn't affect them */
+  adap_navigation_view_set_max_retained_pages (view, 1);
+  adap_navigation_view_set_max_retained_pages (view, 0);
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+
+  /* Once pushed, a preloaded page is retained like any other popped page */
+  adap_navigation_view_set_max_retained_pages (view, 1);
+  adap_navigation_view_push_by_tag (view, "page-2");
+  g_assert_true (adap_navigation_view_pop (view));
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+
+  /* And preloading doesn't evict popped pages */
+  adap_navigation_view_preload (view, page_6);
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+  g_assert_true (adap_navigation_view_find_page (view, "page-4") == page_4);
+  g_assert_true (adap_navigation_view_find_page (view, "page-5") == page_5);
+  g_assert_true (adap_navigation_view_find_page (view, "page-6") == page_6);
+
+  g_assert_finalize_object (view);
+}
+
+static void
+test_adap_navigation_view_replace_retained (void)
+{
+  AdapNavigationView *view = g_object_ref_sink (ADAP_NAVIGATION_VIEW (adap_navigation_view_new ()));
+  AdapNavigationPage *page_1, *page_2, *page_3;
+
+  adap_navigation_view_set_animate_transitions (view, FALSE);
+  adap_navigation_view_set_max_retained_pages (view, 1);
+
+  page_1 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 1", "page-1");
+  page_2 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 2", "page-2");
+  page_3 = adap_navigation_page_new_with_tag (gtk_button_new (), "Page 3", "page-3");
+
+  adap_navigation_view_push (view, page_1);
+  adap_navigation_view_push (view, page_2);
+
+  /* Pages dropped from the stack are retained like popped ones */
+  adap_navigation_view_replace (view, &page_3, 1);
+  check_navigation_stack (view, 1, "page-3");
+  g_assert_true (adap_navigation_view_get_visible_page (view) == page_3);
+  g_assert_null (adap_navigation_view_find_page (view, "page-1"));
+  g_assert_true (adap_navigation_view_find_page (view, "page-2") == page_2);
+  g_assert_false (gtk_widget_get_child_visible (GTK_WIDGET (page_2)));
+
+  /* Retained pages that are pushed again aren't evicted by the dropped ones */
+  adap_navigation_view_replace_with_tags (view, (const char *[]) { "page-2" }, 1);
+  check_navigation_stack (view, 1, "page-2");
+  g_assert_true (adap_navigation_view_get_visible_page (view) == page_2);
+  g_assert_true (adap_navigation_view_find_page (view, "page-3") == page_3);
+
+  g_assert_finalize_object (view);
+}
+
 static void
 test_adap_navigation_page_child (void)
 {
@@ -801,6 +1111,13 @@ main (int   argc,
   g_test_add_func ("/Adapta/NavigationView/find_page", test_adap_navigation_view_find_page);
   g_test_add_func ("/Adapta/NavigationView/animate_transitions", test_adap_navigation_view_animate_transitions);
   g_test_add_func ("/Adapta/NavigationView/pop_on_escape", test_adap_navigation_view_pop_on_escape);
+  g_test_add_func ("/Adapta/NavigationView/transition_cache", test_adap_navigation_view_transition_cache);
+  g_test_add_func ("/Adapta/NavigationView/transition_cache_transitions", test_adap_navigation_view_transition_cache_transitions);
+  g_test_add_func ("/Adapta/NavigationView/transition_cache_reuse", test_adap_navigation_view_transition_cache_reuse);
+  g_test_add_func ("/Adapta/NavigationView/max_retained_pages", test_adap_navigation_view_max_retained_pages);
+  g_test_add_func ("/Adapta/NavigationView/preload", test_adap_navigation_view_preload);
+  g_test_add_func ("/Adapta/NavigationView/preload_retained", test_adap_navigation_view_preload_retained);
+  g_test_add_func ("/Adapta/NavigationView/replace_retained", test_adap_navigation_view_replace_retained);
   g_test_add_func ("/Adapta/NavigationPage/child", test_adap_navigation_page_child);
   g_test_add_func ("/Adapta/NavigationPage/title", test_adap_navigation_page_title);
   g_test_add_func ("/Adapta/NavigationPage/tag", test_adap_navigation_page_tag);
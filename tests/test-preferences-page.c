@@ -5,6 +5,14 @@
  */
 
 #include <adapta.h>
+#include "adap-preferences-page-private.h"
+#include "adap-preferences-row-descriptor-private.h"
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
 
 
 static void
@@ -101,6 +109,134 @@ test_adap_preferences_page_use_underline (void)
 }
 
 
+static void
+add_content (AdapPreferencesPage *page,
+             int                 *n_calls)
+{
+  AdapPreferencesGroup *group = ADAP_PREFERENCES_GROUP (adap_preferences_group_new ());
+  GtkWidget *row = adap_action_row_new ();
+
+  adap_preferences_row_set_title (ADAP_PREFERENCES_ROW (row), "Dummy row");
+  adap_preferences_group_add (group, row);
+  adap_preferences_page_add (page, group);
+
+  (*n_calls)++;
+}
+
+
+static void
+test_adap_preferences_page_content_func (void)
+{
+  AdapPreferencesPage *page = g_object_ref_sink (ADAP_PREFERENCES_PAGE (adap_preferences_page_new ()));
+  AdapPreferencesRow *row;
+  int n_calls = 0;
+
+  adap_preferences_page_set_content_func (page,
+                                          (AdapPreferencesPageContentFunc) add_content,
+                                          &n_calls,
+                                          NULL);
+  adap_preferences_page_add_row_descriptor (page, "Dummy row", "Dummy subtitle");
+  g_assert_cmpint (n_calls, ==, 0);
+
+  row = adap_preferences_page_find_row (page, "Dummy row");
+  g_assert_nonnull (row);
+  g_assert_cmpint (n_calls, ==, 1);
+
+  g_assert_null (adap_preferences_page_find_row (page, "Missing row"));
+  adap_preferences_page_ensure_content (page);
+  g_assert_cmpint (n_calls, ==, 1);
+
+  g_assert_finalize_object (page);
+}
+
+
+static void
+test_adap_preferences_page_content_resource (void)
+{
+  AdapPreferencesPage *page = g_object_ref_sink (ADAP_PREFERENCES_PAGE (adap_preferences_page_new ()));
+  int notified = 0;
+
+  g_signal_connect_swapped (page, "notify::content-resource", G_CALLBACK (increment), &notified);
+
+  g_assert_null (adap_preferences_page_get_content_resource (page));
+
+  adap_preferences_page_set_content_resource (page, "/org/example/page.ui");
+  g_assert_cmpstr (adap_preferences_page_get_content_resource (page), ==, "/org/example/page.ui");
+  g_assert_cmpint (notified, ==, 1);
+
+  adap_preferences_page_set_content_resource (page, "/org/example/page.ui");
+  g_assert_cmpint (notified, ==, 1);
+
+  adap_preferences_page_set_content_resource (page, NULL);
+  g_assert_null (adap_preferences_page_get_content_resource (page));
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (page);
+}
+
+
+static void
+assert_rows (AdapPreferencesPage *page,
+             gboolean             built,
+             ...)
+{
+  GListModel *rows = adap_preferences_page_get_rows (page);
+  const char *title;
+  va_list args;
+  guint i = 0;
+
+  va_start (args, built);
+
+  while ((title = va_arg (args, const char *))) {
+    GObject *item = g_list_model_get_item (rows, i++);
+
+    g_assert_nonnull (item);
+
+    /* Descriptors stand in for the rows until the content is built */
+    if (built) {
+      g_assert_true (ADAP_IS_PREFERENCES_ROW (item));
+      g_assert_cmpstr (adap_preferences_row_get_title (ADAP_PREFERENCES_ROW (item)), ==, title);
+    } else {
+      g_assert_false (ADAP_IS_PREFERENCES_ROW (item));
+      g_assert_cmpstr (adap_preferences_row_descriptor_get_title ((AdapPreferencesRowDescriptor *) item), ==, title);
+    }
+
+    g_object_unref (item);
+  }
+
+  va_end (args);
+
+  g_assert_cmpuint (g_list_model_get_n_items (rows), ==, i);
+
+  g_object_unref (rows);
+}
+
+static void
+test_adap_preferences_page_content_template (void)
+{
+  AdapPreferencesPage *page = g_object_ref_sink (ADAP_PREFERENCES_PAGE (adap_preferences_page_new ()));
+  AdapPreferencesRow *row;
+
+  adap_preferences_page_set_content_resource (page, "/org/gnome/Adapta1/Test/test-preferences-page-content.ui");
+  adap_preferences_page_add_row_descriptor (page, "First Row", NULL);
+  adap_preferences_page_add_row_descriptor (page, "Second Row", NULL);
+
+  assert_rows (page, FALSE, "First Row", "Second Row", NULL);
+
+  adap_preferences_page_ensure_content (page);
+
+  assert_rows (page, TRUE, "First Row", "Second Row", NULL);
+
+  row = adap_preferences_page_find_row (page, "Second Row");
+  g_assert_true (ADAP_IS_ACTION_ROW (row));
+
+  /* The content is only built once */
+  adap_preferences_page_ensure_content (page);
+  assert_rows (page, TRUE, "First Row", "Second Row", NULL);
+
+  g_assert_finalize_object (page);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -113,6 +249,9 @@ main (int   argc,
   g_test_add_func("/Adapta/PreferencesPage/title", test_adap_preferences_page_title);
   g_test_add_func("/Adapta/PreferencesPage/description", test_adap_preferences_page_description);
   g_test_add_func("/Adapta/PreferencesPage/use_underline", test_adap_preferences_page_use_underline);
+  g_test_add_func("/Adapta/PreferencesPage/content_func", test_adap_preferences_page_content_func);
+  g_test_add_func("/Adapta/PreferencesPage/content_resource", test_adap_preferences_page_content_resource);
+  g_test_add_func("/Adapta/PreferencesPage/content_template", test_adap_preferences_page_content_template);
 
   return g_test_run();
 }
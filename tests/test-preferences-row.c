@@ -5,6 +5,7 @@
  */
 
 #include <adapta.h>
+#include "adap-preferences-row-private.h"
 
 
 static void
@@ -49,6 +50,70 @@ test_adap_preferences_row_use_undeline (void)
 }
 
 
+static int
+get_search_score (AdapPreferencesRow *row,
+                  const char         *text)
+{
+  char **tokens = adap_preferences_row_tokenize_search (text);
+  int score = adap_preferences_row_get_search_score (row, (const char * const *) tokens);
+
+  g_strfreev (tokens);
+
+  return score;
+}
+
+static void
+test_adap_preferences_row_search_score (void)
+{
+  AdapPreferencesRow *row = g_object_ref_sink (ADAP_PREFERENCES_ROW (adap_action_row_new ()));
+
+  adap_preferences_row_set_title (row, "<b>Dummy</b> _Title");
+  adap_action_row_set_subtitle (ADAP_ACTION_ROW (row), "Some Subtitle");
+
+  g_assert_cmpint (get_search_score (row, ""), >, 0);
+  g_assert_cmpint (get_search_score (row, "dummy _title"), >, 0);
+  g_assert_cmpint (get_search_score (row, "<b>"), ==, 0);
+  g_assert_cmpint (get_search_score (row, "subtitle"), >, 0);
+  g_assert_cmpint (get_search_score (row, "  TITLE   some "), >, 0);
+  g_assert_cmpint (get_search_score (row, "title missing"), ==, 0);
+
+  adap_preferences_row_set_use_underline (row, TRUE);
+  g_assert_cmpint (get_search_score (row, "dummy title"), >, 0);
+  g_assert_cmpint (get_search_score (row, "dummy _title"), ==, 0);
+
+  adap_preferences_row_set_use_markup (row, FALSE);
+  g_assert_cmpint (get_search_score (row, "<b>"), >, 0);
+
+  adap_preferences_row_set_title (row, "Other");
+  g_assert_cmpint (get_search_score (row, "dummy"), ==, 0);
+  g_assert_cmpint (get_search_score (row, "other"), >, 0);
+
+  adap_action_row_set_subtitle (ADAP_ACTION_ROW (row), "Changed");
+  g_assert_cmpint (get_search_score (row, "subtitle"), ==, 0);
+  g_assert_cmpint (get_search_score (row, "changed"), >, 0);
+
+  g_assert_finalize_object (row);
+}
+
+static void
+test_adap_preferences_row_search_ranking (void)
+{
+  AdapPreferencesRow *row = g_object_ref_sink (ADAP_PREFERENCES_ROW (adap_action_row_new ()));
+
+  adap_preferences_row_set_title (row, "Night Light Schedule");
+  adap_action_row_set_subtitle (ADAP_ACTION_ROW (row), "Reduce blue light at night");
+
+  /* Start of the title, then start of a word, then the middle of one */
+  g_assert_cmpint (get_search_score (row, "night"), >, get_search_score (row, "light"));
+  g_assert_cmpint (get_search_score (row, "light"), >, get_search_score (row, "ight"));
+
+  /* Title matches beat subtitle matches */
+  g_assert_cmpint (get_search_score (row, "ight"), >, get_search_score (row, "blue"));
+  g_assert_cmpint (get_search_score (row, "blue"), >, get_search_score (row, "lue"));
+
+  g_assert_finalize_object (row);
+}
+
 int
 main (int   argc,
       char *argv[])
@@ -58,6 +123,8 @@ main (int   argc,
 
   g_test_add_func("/Adapta/PreferencesRow/title", test_adap_preferences_row_title);
   g_test_add_func("/Adapta/PreferencesRow/use_underline", test_adap_preferences_row_use_undeline);
+  g_test_add_func("/Adapta/PreferencesRow/search_score", test_adap_preferences_row_search_score);
+  g_test_add_func("/Adapta/PreferencesRow/search_ranking", test_adap_preferences_row_search_ranking);
 
   return g_test_run();
 }
@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adapta.h>
+#include "adap-settings-impl-private.h"
+
+#define PORTAL_BUS_NAME "org.freedesktop.portal.Desktop"
+#define PORTAL_OBJECT_PATH "/org/freedesktop/portal/desktop"
+
+static const char introspection_xml[] =
+  "<node>"
+  "  <interface name='org.freedesktop.portal.Settings'>"
+  "    <method name='ReadAll'>"
+  "      <arg type='as' name='namespaces' direction='in'/>"
+  "      <arg type='a{sa{sv}}' name='value' direction='out'/>"
+  "    </method>"
+  "    <method name='Read'>"
+  "      <arg type='s' name='namespace' direction='in'/>"
+  "      <arg type='s' name='key' direction='in'/>"
+  "      <arg type='v' name='value' direction='out'/>"
+  "    </method>"
+  "    <signal name='SettingChanged'>"
+  "      <arg type='s' name='namespace'/>"
+  "      <arg type='s' name='key'/>"
+  "      <arg type='v' name='value'/>"
+  "    </signal>"
+  "  </interface>"
+  "</node>";
+
+typedef struct {
+  gboolean has_read_all;
+  gboolean change_on_read;
+  gboolean hang;
+  guint32 color_scheme;
+  GDBusMethodInvocation *held;
+  int n_read_all;
+  int n_read;
+} MockPortal;
+
+static void
+reset_portal (MockPortal *portal,
+              gboolean    has_read_all)
+{
+  portal->has_read_all = has_read_all;
+  portal->change_on_read = FALSE;
+  portal->hang = FALSE;
+  portal->color_scheme = 1;
+  portal->n_read_all = 0;
+  portal->n_read = 0;
+}
+
+static void
+emit_color_scheme (GDBusConnection *connection,
+                   MockPortal      *portal,
+                   guint32          color_scheme)
+{
+  portal->color_scheme = color_scheme;
+
+  g_dbus_connection_emit_signal (connection,
+                                 NULL,
+                                 PORTAL_OBJECT_PATH,
+                                 "org.freedesktop.portal.Settings",
+                                 "SettingChanged",
+                                 g_variant_new ("(ssv)",
+                                                "org.freedesktop.appearance",
+                                                "color-scheme",
+                                                g_variant_new_uint32 (color_scheme)),
+                                 NULL);
+}
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+static void
+name_acquired_cb (GDBusConnection *connection,
+                  const char      *name,
+                  gboolean        *acquired)
+{
+  *acquired = TRUE;
+}
+
+static GVariant *
+mock_lookup (MockPortal *portal,
+             const char *namespace,
+             const char *key)
+{
+  if (!g_strcmp0 (namespace, "org.freedesktop.appearance") &&
+      !g_strcmp0 (key, "color-scheme"))
+    return g_variant_new_uint32 (portal->color_scheme);
+
+  if (!g_strcmp0 (namespace, "org.gnome.desktop.interface") &&
+      !g_strcmp0 (key, "gtk-theme"))
+    return g_variant_new_string ("Mock");
+
+  if (!g_strcmp0 (namespace, "org.gnome.desktop.a11y.interface") &&
+      !g_strcmp0 (key, "high-contrast"))
+    return g_variant_new_boolean (TRUE);
+
+  return NULL;
+}
+
+static void
+mock_method_call (GDBusConnection       *connection,
+                  const char            *sender,
+                  const char            *object_path,
+                  const char            *interface_name,
+                  const char            *method_name,
+                  GVariant              *parameters,
+                  GDBusMethodInvocation *invocation,
+                  gpointer               user_data)
+{
+  MockPortal *portal = user_data;
+
+  if (!g_strcmp0 (method_name, "ReadAll")) {
+    GVariantBuilder builder;
+
+    portal->n_read_all++;
+
+    if (portal->hang) {
+      /* Never reply, the caller has to time out */
+      portal->held = g_object_ref (invocation);
+      return;
+    }
+
+    if (!portal->has_read_all) {
+      g_dbus_method_invocation_return_error (invocation,
+                                             G_DBUS_ERROR,
+                                             G_DBUS_ERROR_UNKNOWN_METHOD,
+                                             "No such method");
+      return;
+    }
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+
+    g_variant_builder_open (&builder, G_VARIANT_TYPE ("{sa{sv}}"));
+    g_variant_builder_add (&builder, "s", "org.freedesktop.appearance");
+    g_variant_builder_open (&builder, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add (&builder, "{sv}", "color-scheme", g_variant_new_uint32 (portal->color_scheme));
+    g_variant_builder_add (&builder, "{sv}", "contrast", g_variant_new_uint32 (1));
+    g_variant_builder_close (&builder);
+    g_variant_builder_close (&builder);
+
+    g_variant_builder_open (&builder, G_VARIANT_TYPE ("{sa{sv}}"));
+    g_variant_builder_add (&builder, "s", "org.gnome.desktop.interface");
+    g_variant_builder_open (&builder, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add (&builder, "{sv}", "gtk-theme", g_variant_new_string ("Mock"));
+    g_variant_builder_close (&builder);
+    g_variant_builder_close (&builder);
+
+    g_dbus_method_invocation_return_value (invocation,
+                                           g_variant_new ("(a{sa{sv}})", &builder));
+    return;
+  }
+
+  if (!g_strcmp0 (method_name, "Read")) {
+    const char *namespace, *key;
+    GVariant *value;
+
+    portal->n_read++;
+
+    g_variant_get (parameters, "(&s&s)", &namespace, &key);
+
+    value = mock_lookup (portal, namespace, key);
+
+    if (!value) {
+      g_dbus_method_invocation_return_dbus_error (invocation,
+                                                  "org.freedesktop.portal.Error.NotFound",
+                                                  "Requested setting not found");
+      return;
+    }
+
+    g_dbus_method_invocation_return_value (invocation,
+                                           g_variant_new ("(v)", g_variant_new_variant (value)));
+
+    /* Change the setting after replying, while the other reads are pending */
+    if (portal->change_on_read && !g_strcmp0 (key, "color-scheme"))
+      emit_color_scheme (connection, portal, 2);
+
+    return;
+  }
+
+  g_assert_not_reached ();
+}
+
+static const GDBusInterfaceVTable mock_vtable = {
+  mock_method_call,
+  NULL,
+  NULL,
+};
+
+static AdapSettingsImpl *
+create_impl (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+  int features_changed = 0;
+
+  impl = adap_settings_impl_portal_new (TRUE, TRUE, TRUE);
+
+  g_signal_connect_swapped (impl, "features-changed", G_CALLBACK (increment), &features_changed);
+
+  /* Nothing has been read yet, the call must not block */
+  g_assert_false (adap_settings_impl_get_has_theme_name (impl));
+  g_assert_false (adap_settings_impl_get_has_color_scheme (impl));
+  g_assert_false (adap_settings_impl_get_has_high_contrast (impl));
+
+  while (!features_changed)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (features_changed, ==, 1);
+
+  return impl;
+}
+
+static void
+test_adap_settings_portal_read_all (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+
+  reset_portal (portal, TRUE);
+
+  impl = create_impl (portal);
+
+  g_assert_cmpint (portal->n_read_all, ==, 1);
+  g_assert_cmpint (portal->n_read, ==, 0);
+
+  g_assert_false (adap_settings_impl_get_has_theme_name (impl));
+  g_assert_true (adap_settings_impl_get_has_color_scheme (impl));
+  g_assert_true (adap_settings_impl_get_has_high_contrast (impl));
+
+  g_assert_cmpstr (adap_settings_impl_get_theme_name (impl), ==, "Mock");
+  g_assert_cmpint (adap_settings_impl_get_color_scheme (impl), ==, ADAP_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+  g_assert_true (adap_settings_impl_get_high_contrast (impl));
+
+  g_assert_finalize_object (impl);
+}
+
+static void
+test_adap_settings_portal_read_fallback (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+
+  reset_portal (portal, FALSE);
+
+  impl = create_impl (portal);
+
+  g_assert_cmpint (portal->n_read_all, ==, 1);
+  g_assert_cmpint (portal->n_read, ==, 4);
+
+  g_assert_false (adap_settings_impl_get_has_theme_name (impl));
+  g_assert_true (adap_settings_impl_get_has_color_scheme (impl));
+  g_assert_true (adap_settings_impl_get_has_high_contrast (impl));
+
+  g_assert_cmpstr (adap_settings_impl_get_theme_name (impl), ==, "Mock");
+  g_assert_cmpint (adap_settings_impl_get_color_scheme (impl), ==, ADAP_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+
+  /* The FDO contrast key is missing, so the GNOME one is used */
+  g_assert_true (adap_settings_impl_get_high_contrast (impl));
+
+  g_assert_finalize_object (impl);
+}
+
+static void
+test_adap_settings_portal_dispose (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+  int i;
+
+  reset_portal (portal, TRUE);
+
+  /* Dropping the impl before the reply arrives must not crash */
+  impl = adap_settings_impl_portal_new (TRUE, TRUE, TRUE);
+  g_assert_finalize_object (impl);
+
+  for (i = 0; i < 10; i++)
+    g_main_context_iteration (NULL, FALSE);
+}
+
+static void
+test_adap_settings_portal_setting_changed (MockPortal *portal)
+{
+  GDBusConnection *connection;
+  AdapSettingsImpl *impl;
+
+  reset_portal (portal, TRUE);
+
+  impl = create_impl (portal);
+
+  g_assert_cmpint (adap_settings_impl_get_color_scheme (impl), ==, ADAP_SYSTEM_COLOR_SCHEME_PREFER_DARK);
+
+  connection = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  emit_color_scheme (connection, portal, 2);
+
+  while (adap_settings_impl_get_color_scheme (impl) == ADAP_SYSTEM_COLOR_SCHEME_PREFER_DARK)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (adap_settings_impl_get_color_scheme (impl), ==, ADAP_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+
+  g_object_unref (connection);
+  g_assert_finalize_object (impl);
+}
+
+static void
+test_adap_settings_portal_changed_while_reading (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+
+  reset_portal (portal, FALSE);
+  portal->change_on_read = TRUE;
+
+  impl = create_impl (portal);
+
+  g_assert_cmpint (portal->n_read, ==, 4);
+
+  /* The reply said dark, but the signal after it said light */
+  g_assert_true (adap_settings_impl_get_has_color_scheme (impl));
+  g_assert_cmpint (adap_settings_impl_get_color_scheme (impl), ==, ADAP_SYSTEM_COLOR_SCHEME_PREFER_LIGHT);
+
+  g_assert_finalize_object (impl);
+}
+
+static void
+test_adap_settings_portal_timeout (MockPortal *portal)
+{
+  AdapSettingsImpl *impl;
+
+  reset_portal (portal, TRUE);
+  portal->hang = TRUE;
+
+  /* The portal never replies, the read has to time out with no features */
+  impl = create_impl (portal);
+
+  g_assert_cmpint (portal->n_read_all, ==, 1);
+  g_assert_cmpint (portal->n_read, ==, 0);
+
+  g_assert_false (adap_settings_impl_get_has_theme_name (impl));
+  g_assert_false (adap_settings_impl_get_has_color_scheme (impl));
+  g_assert_false (adap_settings_impl_get_has_high_contrast (impl));
+
+  g_assert_nonnull (portal->held);
+  g_dbus_method_invocation_return_dbus_error (g_steal_pointer (&portal->held),
+                                              "org.freedesktop.DBus.Error.Failed",
+                                              "Too late");
+
+  g_assert_finalize_object (impl);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GTestDBus *bus;
+  GDBusConnection *connection;
+  GDBusNodeInfo *info;
+  MockPortal portal = { 0 };
+  gboolean name_acquired = FALSE;
+  guint registration_id, owner_id;
+  int ret;
+
+  g_test_init (&argc, &argv, NULL);
+
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+
+  connection = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  g_assert_nonnull (connection);
+
+  info = g_dbus_node_info_new_for_xml (introspection_xml, NULL);
+  g_assert_nonnull (info);
+
+  registration_id = g_dbus_connection_register_object (connection,
+                                                       PORTAL_OBJECT_PATH,
+                                                       info->interfaces[0],
+                                                       &mock_vtable,
+                                                       &portal,
+                                                       NULL,
+                                                       NULL);
+  g_assert_cmpuint (registration_id, >, 0);
+
+  owner_id = g_bus_own_name_on_connection (connection,
+                                           PORTAL_BUS_NAME,
+                                           G_BUS_NAME_OWNER_FLAGS_NONE,
+                                           (GBusNameAcquiredCallback) name_acquired_cb,
+                                           NULL,
+                                           &name_acquired,
+                                           NULL);
+
+  while (!name_acquired)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_test_add_data_func ("/Adapta/SettingsPortal/read_all", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_read_all);
+  g_test_add_data_func ("/Adapta/SettingsPortal/read_fallback", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_read_fallback);
+  g_test_add_data_func ("/Adapta/SettingsPortal/dispose", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_dispose);
+  g_test_add_data_func ("/Adapta/SettingsPortal/setting_changed", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_setting_changed);
+  g_test_add_data_func ("/Adapta/SettingsPortal/changed_while_reading", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_changed_while_reading);
+  g_test_add_data_func ("/Adapta/SettingsPortal/timeout", &portal,
+                        (GTestDataFunc) test_adap_settings_portal_timeout);
+
+  ret = g_test_run ();
+
+  g_bus_unown_name (owner_id);
+  g_dbus_connection_unregister_object (connection, registration_id);
+  g_dbus_node_info_unref (info);
+  g_object_unref (connection);
+
+  g_test_dbus_down (bus);
+  g_object_unref (bus);
+
+  return ret;
+}
@@ -9,6 +9,10 @@
 #include <adapta.h>
 #include "adap-settings-private.h"
 
+#include <glib/gstdio.h>
+
+#define TEST_THEME_NAME "AdapTestTheme"
+
 static void
 increment (int *data)
 {
@@ -200,10 +204,139 @@ test_adap_style_manager_inheritance (void)
   adap_style_manager_set_color_scheme (default_manager, ADAP_COLOR_SCHEME_DEFAULT);
 }
 
+static void
+test_adap_style_manager_theme_fragments (void)
+{
+  GtkWidget *window, *widget;
+  GdkRGBA color;
+
+  /* Creates the avatar fragment */
+  g_type_ensure (ADAP_TYPE_AVATAR);
+
+  window = gtk_window_new ();
+  widget = g_object_new (GTK_TYPE_LABEL, "css-name", "avatar", NULL);
+  gtk_widget_add_css_class (widget, "contrasted");
+  gtk_window_set_child (GTK_WINDOW (window), widget);
+
+  /* The test theme has no fragments, so its own avatar styles must not be
+   * overridden by the bundled fragment */
+  gtk_widget_get_color (widget, &color);
+  g_assert_cmpfloat (color.red, ==, 1);
+  g_assert_cmpfloat (color.green, ==, 0);
+  g_assert_cmpfloat (color.blue, ==, 0);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+}
+
+static void
+test_adap_style_manager_fragment_position (void)
+{
+  GtkCssProvider *provider;
+  GtkWidget *window, *widget;
+  GdkRGBA color;
+
+  window = gtk_window_new ();
+  widget = gtk_label_new (NULL);
+  gtk_widget_add_css_class (widget, "fragment-position");
+  gtk_window_set_child (GTK_WINDOW (window), widget);
+
+  /* Added after the library stylesheets, at the same priority */
+  provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_string (provider, "label.fragment-position { color: rgb(0, 255, 0); }");
+  gtk_style_context_add_provider_for_display (gdk_display_get_default (),
+                                              GTK_STYLE_PROVIDER (provider),
+                                              GTK_STYLE_PROVIDER_PRIORITY_THEME);
+
+  /* Loads the theme's tab view fragment. It must stay where the base
+   * stylesheet is instead of being added after the provider above */
+  g_type_ensure (ADAP_TYPE_TAB_VIEW);
+
+  gtk_widget_get_color (widget, &color);
+  g_assert_cmpfloat (color.red, ==, 0);
+  g_assert_cmpfloat (color.green, ==, 1);
+  g_assert_cmpfloat (color.blue, ==, 0);
+
+  gtk_style_context_remove_provider_for_display (gdk_display_get_default (),
+                                                 GTK_STYLE_PROVIDER (provider));
+
+  /* The fragment was still loaded */
+  gtk_widget_get_color (widget, &color);
+  g_assert_cmpfloat (color.red, ==, 0);
+  g_assert_cmpfloat (color.green, ==, 0);
+  g_assert_cmpfloat (color.blue, ==, 1);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+  g_object_unref (provider);
+}
+
+static char *
+create_test_theme (void)
+{
+  g_autofree char *version_dir = NULL;
+  g_autofree char *theme_dir = NULL;
+  g_autofree char *base_path = NULL;
+  g_autofree char *colors_path = NULL;
+  g_autofree char *fragment_path = NULL;
+  char *data_dir;
+
+  data_dir = g_dir_make_tmp ("adapta-test-XXXXXX", NULL);
+  g_assert_nonnull (data_dir);
+
+  version_dir = g_strdup_printf ("libadapta-%d.%d", ADAP_MAJOR_VERSION, ADAP_MINOR_VERSION);
+  theme_dir = g_build_filename (data_dir, "themes", TEST_THEME_NAME, version_dir, NULL);
+  base_path = g_build_filename (theme_dir, "base.css", NULL);
+  colors_path = g_build_filename (theme_dir, "defaults-light.css", NULL);
+  fragment_path = g_build_filename (theme_dir, "fragment-tab-view.css", NULL);
+
+  g_assert_cmpint (g_mkdir_with_parents (theme_dir, 0755), ==, 0);
+  g_assert_true (g_file_set_contents (base_path, "avatar.contrasted { color: rgb(255, 0, 0); }", -1, NULL));
+  g_assert_true (g_file_set_contents (colors_path, "", -1, NULL));
+  g_assert_true (g_file_set_contents (fragment_path, "label.fragment-position { color: rgb(0, 0, 255); }", -1, NULL));
+
+  g_setenv ("XDG_DATA_HOME", data_dir, TRUE);
+  g_setenv ("ADAP_DEBUG_THEME_NAME", TEST_THEME_NAME, TRUE);
+
+  return data_dir;
+}
+
+static void
+remove_test_theme (const char *data_dir)
+{
+  g_autofree char *version_dir = NULL;
+  g_autofree char *theme_dir = NULL;
+  g_autofree char *base_path = NULL;
+  g_autofree char *colors_path = NULL;
+  g_autofree char *fragment_path = NULL;
+  g_autofree char *parent_dir = NULL;
+  g_autofree char *themes_dir = NULL;
+
+  version_dir = g_strdup_printf ("libadapta-%d.%d", ADAP_MAJOR_VERSION, ADAP_MINOR_VERSION);
+  themes_dir = g_build_filename (data_dir, "themes", NULL);
+  parent_dir = g_build_filename (themes_dir, TEST_THEME_NAME, NULL);
+  theme_dir = g_build_filename (parent_dir, version_dir, NULL);
+  base_path = g_build_filename (theme_dir, "base.css", NULL);
+  colors_path = g_build_filename (theme_dir, "defaults-light.css", NULL);
+  fragment_path = g_build_filename (theme_dir, "fragment-tab-view.css", NULL);
+
+  g_unlink (base_path);
+  g_unlink (colors_path);
+  g_unlink (fragment_path);
+  g_rmdir (theme_dir);
+  g_rmdir (parent_dir);
+  g_rmdir (themes_dir);
+  g_rmdir (data_dir);
+}
+
 int
 main (int   argc,
       char *argv[])
 {
+  g_autofree char *data_dir = NULL;
+  int ret;
+
+  /* Must be set up before GLib caches the user data directory */
+  data_dir = create_test_theme ();
+
   gtk_test_init (&argc, &argv, NULL);
   adap_init ();
 
@@ -212,6 +345,12 @@ main (int   argc,
   g_test_add_func("/Adapta/StyleManager/high_contrast", test_adap_style_manager_high_contrast);
   g_test_add_func("/Adapta/StyleManager/system_supports_color_schemes", test_adap_style_manager_system_supports_color_schemes);
   g_test_add_func("/Adapta/StyleManager/inheritance", test_adap_style_manager_inheritance);
+  g_test_add_func("/Adapta/StyleManager/theme_fragments", test_adap_style_manager_theme_fragments);
+  g_test_add_func("/Adapta/StyleManager/fragment_position", test_adap_style_manager_fragment_position);
+
+  ret = g_test_run();
+
+  remove_test_theme (data_dir);
 
-  return g_test_run();
+  return ret;
 }
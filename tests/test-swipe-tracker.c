@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2019 Alice Mikhaylenko <alicem@gnome.org>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adapta.h>
+#include "adap-swipe-tracker-private.h"
+
+#define TEST_DISTANCE 100
+#define TEST_REFRESH_INTERVAL_MS (16667 / 1000.0)
+
+static void
+increment (int *data)
+{
+  (*data)++;
+}
+
+#define TEST_TYPE_SWIPEABLE (test_swipeable_get_type ())
+
+G_DECLARE_FINAL_TYPE (TestSwipeable, test_swipeable, TEST, SWIPEABLE, GtkWidget)
+
+struct _TestSwipeable
+{
+  GtkWidget parent_instance;
+
+  double progress;
+};
+
+static void test_swipeable_swipeable_init (AdapSwipeableInterface *iface);
+
+G_DEFINE_FINAL_TYPE_WITH_CODE (TestSwipeable, test_swipeable, GTK_TYPE_WIDGET,
+                               G_IMPLEMENT_INTERFACE (ADAP_TYPE_SWIPEABLE, test_swipeable_swipeable_init))
+
+static void
+test_swipeable_class_init (TestSwipeableClass *klass)
+{
+}
+
+static void
+test_swipeable_init (TestSwipeable *self)
+{
+}
+
+static double
+test_swipeable_get_distance (AdapSwipeable *swipeable)
+{
+  return TEST_DISTANCE;
+}
+
+static double *
+test_swipeable_get_snap_points (AdapSwipeable *swipeable,
+                                int           *n_snap_points)
+{
+  double *points = g_new0 (double, 3);
+
+  points[0] = 0;
+  points[1] = 1;
+  points[2] = 2;
+
+  if (n_snap_points)
+    *n_snap_points = 3;
+
+  return points;
+}
+
+static double
+test_swipeable_get_progress (AdapSwipeable *swipeable)
+{
+  return TEST_SWIPEABLE (swipeable)->progress;
+}
+
+static double
+test_swipeable_get_cancel_progress (AdapSwipeable *swipeable)
+{
+  return 0;
+}
+
+static void
+test_swipeable_swipeable_init (AdapSwipeableInterface *iface)
+{
+  iface->get_distance = test_swipeable_get_distance;
+  iface->get_snap_points = test_swipeable_get_snap_points;
+  iface->get_progress = test_swipeable_get_progress;
+  iface->get_cancel_progress = test_swipeable_get_cancel_progress;
+}
+
+typedef struct {
+  double progress;
+  double end_progress;
+  double max_progress;
+} ReplayResult;
+
+static void
+update_swipe_cb (ReplayResult *result,
+                 double        progress)
+{
+  result->progress = progress;
+  result->max_progress = MAX (result->max_progress, progress);
+}
+
+static void
+end_swipe_cb (ReplayResult *result,
+              double        velocity,
+              double        to)
+{
+  result->end_progress = to;
+}
+
+/* Replays a drag with @n_events events spaced by @event_interval ms, moving
+ * by @velocity px/ms, and returns the average distance in pixels between the
+ * displayed progress and the finger at the expected presentation time */
+static double
+replay_trace (gboolean      predict_progress,
+              int           n_events,
+              guint32       event_interval,
+              double        velocity,
+              ReplayResult *result)
+{
+  TestSwipeable *swipeable = g_object_ref_sink (g_object_new (TEST_TYPE_SWIPEABLE, NULL));
+  AdapSwipeTracker *tracker = adap_swipe_tracker_new (ADAP_SWIPEABLE (swipeable));
+  double finger = 0, total_lag = 0;
+  guint32 time = 1000;
+  int i;
+
+  adap_swipe_tracker_set_predict_progress (tracker, predict_progress);
+
+  g_signal_connect_swapped (tracker, "update-swipe", G_CALLBACK (update_swipe_cb), result);
+  g_signal_connect_swapped (tracker, "end-swipe", G_CALLBACK (end_swipe_cb), result);
+
+  adap_swipe_tracker_replay_begin (tracker, ADAP_NAVIGATION_DIRECTION_FORWARD);
+
+  for (i = 0; i < n_events; i++) {
+    double presented_finger;
+
+    time += event_interval;
+    finger += velocity * event_interval;
+
+    adap_swipe_tracker_replay_update (tracker, velocity * event_interval, time);
+
+    /* The first event has no velocity to extrapolate from */
+    if (i == 0)
+      continue;
+
+    presented_finger = finger + velocity * TEST_REFRESH_INTERVAL_MS;
+    presented_finger = MIN (presented_finger, TEST_DISTANCE);
+
+    total_lag += ABS (presented_finger - result->progress * TEST_DISTANCE);
+  }
+
+  adap_swipe_tracker_replay_end (tracker, time);
+
+  g_assert_finalize_object (tracker);
+  g_assert_finalize_object (swipeable);
+
+  return total_lag / (n_events - 1);
+}
+
+static void
+test_adap_swipe_tracker_predict_progress (void)
+{
+  AdapSwipeable *swipeable;
+  AdapSwipeTracker *tracker;
+  gboolean predict_progress;
+  int notified = 0;
+
+  /* The default comes from the environment, make sure it's the usual one */
+  g_unsetenv ("ADAP_SWIPE_PREDICTION");
+
+  swipeable = g_object_ref_sink (g_object_new (TEST_TYPE_SWIPEABLE, NULL));
+  tracker = adap_swipe_tracker_new (swipeable);
+
+  g_signal_connect_swapped (tracker, "notify::predict-progress", G_CALLBACK (increment), &notified);
+
+  g_assert_false (adap_swipe_tracker_get_predict_progress (tracker));
+  adap_swipe_tracker_set_predict_progress (tracker, TRUE);
+  g_assert_true (adap_swipe_tracker_get_predict_progress (tracker));
+  g_assert_cmpint (notified, ==, 1);
+
+  g_object_set (tracker, "predict-progress", FALSE, NULL);
+  g_object_get (tracker, "predict-progress", &predict_progress, NULL);
+  g_assert_false (predict_progress);
+  g_assert_cmpint (notified, ==, 2);
+
+  adap_swipe_tracker_set_predict_progress (tracker, FALSE);
+  g_assert_cmpint (notified, ==, 2);
+
+  g_assert_finalize_object (tracker);
+  g_assert_finalize_object (swipeable);
+}
+
+static void
+test_adap_swipe_tracker_replay_lag (void)
+{
+  ReplayResult raw = { 0 }, predicted = { 0 };
+  double raw_lag, predicted_lag;
+
+  /* 10 events at 125Hz, 0.5px/ms */
+  raw_lag = replay_trace (FALSE, 10, 8, 0.5, &raw);
+  predicted_lag = replay_trace (TRUE, 10, 8, 0.5, &predicted);
+
+  g_test_message ("Average lag: %.2fpx raw, %.2fpx predicted", raw_lag, predicted_lag);
+
+  g_assert_cmpfloat (raw_lag, >, 0.5 * TEST_REFRESH_INTERVAL_MS - 0.1);
+  g_assert_cmpfloat (predicted_lag, <, raw_lag / 4);
+
+  /* The end of the gesture uses the actual progress either way */
+  g_assert_cmpfloat_with_epsilon (raw.end_progress, predicted.end_progress, DBL_EPSILON);
+}
+
+static void
+test_adap_swipe_tracker_replay_clamp (void)
+{
+  ReplayResult result = { 0 };
+
+  /* Fast enough to reach the next snap point and keep going */
+  replay_trace (TRUE, 10, 8, 2, &result);
+
+  g_assert_cmpfloat (result.max_progress, <=, 1);
+  g_assert_cmpfloat_with_epsilon (result.end_progress, 1, DBL_EPSILON);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adap_init ();
+
+  g_test_add_func("/Adapta/SwipeTracker/predict_progress", test_adap_swipe_tracker_predict_progress);
+  g_test_add_func("/Adapta/SwipeTracker/replay_lag", test_adap_swipe_tracker_replay_lag);
+  g_test_add_func("/Adapta/SwipeTracker/replay_clamp", test_adap_swipe_tracker_replay_clamp);
+
+  return g_test_run();
+}
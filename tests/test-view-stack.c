@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 GNOME Foundation, Inc.
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include <adapta.h>
+
+static GtkWidget *
+create_child (AdapViewStackPage *page,
+              int               *n_calls)
+{
+  (*n_calls)++;
+
+  return gtk_label_new ("Lazy");
+}
+
+
+static void
+test_adap_view_stack_get_child_by_name (void)
+{
+  AdapViewStack *stack = g_object_ref_sink (ADAP_VIEW_STACK (adap_view_stack_new ()));
+  GtkWidget *child1 = gtk_label_new ("1");
+  GtkWidget *child2 = gtk_label_new ("2");
+  AdapViewStackPage *page;
+
+  g_assert_nonnull (stack);
+
+  adap_view_stack_add_named (stack, child1, "first");
+  adap_view_stack_add_named (stack, child2, "second");
+
+  g_assert_true (adap_view_stack_get_child_by_name (stack, "first") == child1);
+  g_assert_true (adap_view_stack_get_child_by_name (stack, "second") == child2);
+  g_assert_null (adap_view_stack_get_child_by_name (stack, "third"));
+
+  page = adap_view_stack_get_page (stack, child2);
+  g_assert_nonnull (page);
+  g_assert_true (adap_view_stack_page_get_child (page) == child2);
+
+  adap_view_stack_page_set_name (page, "third");
+  g_assert_null (adap_view_stack_get_child_by_name (stack, "second"));
+  g_assert_true (adap_view_stack_get_child_by_name (stack, "third") == child2);
+
+  adap_view_stack_set_visible_child_name (stack, "third");
+  g_assert_true (adap_view_stack_get_visible_child (stack) == child2);
+
+  adap_view_stack_remove (stack, child1);
+  g_assert_null (adap_view_stack_get_child_by_name (stack, "first"));
+  g_assert_true (adap_view_stack_get_child_by_name (stack, "third") == child2);
+
+  g_assert_finalize_object (stack);
+}
+
+
+static void
+test_adap_view_stack_lazy (void)
+{
+  AdapViewStack *stack = g_object_ref_sink (ADAP_VIEW_STACK (adap_view_stack_new ()));
+  GtkWidget *child = gtk_label_new ("Eager");
+  AdapViewStackPage *page;
+  gint64 deadline;
+  int n_calls = 0;
+
+  adap_view_stack_add_named (stack, child, "eager");
+
+  page = adap_view_stack_add_lazy (stack, (AdapViewStackChildFunc) create_child, &n_calls, NULL);
+  g_assert_nonnull (page);
+  adap_view_stack_page_set_name (page, "lazy");
+  adap_view_stack_page_set_title (page, "Lazy");
+
+  g_assert_true (adap_view_stack_page_get_loaded (adap_view_stack_get_page (stack, child)));
+  g_assert_false (adap_view_stack_page_get_loaded (page));
+  g_assert_cmpint (n_calls, ==, 0);
+
+  adap_view_stack_set_visible_child_name (stack, "lazy");
+  g_assert_true (adap_view_stack_page_get_loaded (page));
+  g_assert_cmpint (n_calls, ==, 1);
+
+  /* Children are kept by default */
+  adap_view_stack_set_visible_child_name (stack, "eager");
+  adap_view_stack_set_visible_child_name (stack, "lazy");
+  g_assert_cmpint (n_calls, ==, 1);
+
+  adap_view_stack_set_unload_policy (stack, ADAP_VIEW_STACK_UNLOAD_TIMEOUT);
+  adap_view_stack_set_unload_timeout (stack, 0);
+  g_assert_cmpint (adap_view_stack_get_unload_policy (stack), ==, ADAP_VIEW_STACK_UNLOAD_TIMEOUT);
+  g_assert_cmpuint (adap_view_stack_get_unload_timeout (stack), ==, 0);
+
+  /* The visible page is never unloaded */
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+  g_assert_true (adap_view_stack_page_get_loaded (page));
+
+  adap_view_stack_set_visible_child_name (stack, "eager");
+
+  /* Give the unload timeout a second to run, but don't hang if it never does */
+  deadline = g_get_monotonic_time () + G_USEC_PER_SEC;
+  while (adap_view_stack_page_get_loaded (page) && g_get_monotonic_time () < deadline)
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_false (adap_view_stack_page_get_loaded (page));
+  g_assert_true (adap_view_stack_page_get_loaded (adap_view_stack_get_page (stack, child)));
+
+  adap_view_stack_set_visible_child_name (stack, "lazy");
+  g_assert_true (adap_view_stack_page_get_loaded (page));
+  g_assert_cmpint (n_calls, ==, 2);
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adap_view_stack_lazy_child (void)
+{
+  AdapViewStack *stack = g_object_ref_sink (ADAP_VIEW_STACK (adap_view_stack_new ()));
+  GtkWidget *child = gtk_label_new ("Eager");
+  GtkWidget *lazy_child;
+  AdapViewStackPage *page;
+  int n_calls = 0;
+
+  adap_view_stack_add_named (stack, child, "eager");
+
+  page = adap_view_stack_add_lazy (stack, (AdapViewStackChildFunc) create_child, &n_calls, NULL);
+  adap_view_stack_page_set_name (page, "lazy");
+
+  adap_view_stack_set_visible_child_name (stack, "lazy");
+  lazy_child = adap_bin_get_child (ADAP_BIN (adap_view_stack_page_get_child (page)));
+  g_assert_nonnull (lazy_child);
+
+  /* The created child maps back to its page */
+  g_assert_true (adap_view_stack_get_page (stack, lazy_child) == page);
+
+  adap_view_stack_set_visible_child_name (stack, "eager");
+  adap_view_stack_set_visible_child (stack, lazy_child);
+  g_assert_cmpstr (adap_view_stack_get_visible_child_name (stack), ==, "lazy");
+
+  adap_view_stack_remove (stack, lazy_child);
+  g_assert_null (adap_view_stack_get_child_by_name (stack, "lazy"));
+  g_assert_cmpstr (adap_view_stack_get_visible_child_name (stack), ==, "eager");
+
+  g_assert_finalize_object (stack);
+}
+
+static void
+test_adap_view_stack_lazy_low_memory (void)
+{
+  AdapViewStack *stack = g_object_ref_sink (ADAP_VIEW_STACK (adap_view_stack_new ()));
+  GMemoryMonitor *monitor;
+  AdapViewStackPage *page;
+  int n_calls = 0;
+
+  adap_view_stack_add_named (stack, gtk_label_new ("Eager"), "eager");
+
+  page = adap_view_stack_add_lazy (stack, (AdapViewStackChildFunc) create_child, &n_calls, NULL);
+  adap_view_stack_page_set_name (page, "lazy");
+
+  adap_view_stack_set_unload_policy (stack, ADAP_VIEW_STACK_UNLOAD_LOW_MEMORY);
+
+  adap_view_stack_set_visible_child_name (stack, "lazy");
+  adap_view_stack_set_visible_child_name (stack, "eager");
+  g_assert_true (adap_view_stack_page_get_loaded (page));
+
+  monitor = g_memory_monitor_dup_default ();
+
+  /* Below the low level, nothing is unloaded */
+  g_signal_emit_by_name (monitor, "low-memory-warning", 0);
+  g_assert_true (adap_view_stack_page_get_loaded (page));
+
+  g_signal_emit_by_name (monitor, "low-memory-warning", G_MEMORY_MONITOR_WARNING_LEVEL_LOW);
+  g_assert_false (adap_view_stack_page_get_loaded (page));
+
+  g_object_unref (monitor);
+  g_assert_finalize_object (stack);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adap_init ();
+
+  g_test_add_func("/Adapta/ViewStack/get_child_by_name", test_adap_view_stack_get_child_by_name);
+  g_test_add_func("/Adapta/ViewStack/lazy", test_adap_view_stack_lazy);
+  g_test_add_func("/Adapta/ViewStack/lazy_child", test_adap_view_stack_lazy_child);
+  g_test_add_func("/Adapta/ViewStack/lazy_low_memory", test_adap_view_stack_lazy_low_memory);
+
+  return g_test_run();
+}
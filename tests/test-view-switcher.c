@@ -48,6 +48,67 @@ test_adap_view_switcher_stack (void)
 }
 
 
+static void
+assert_buttons (AdapViewSwitcher *view_switcher,
+                const char      *expected)
+{
+  GString *labels = g_string_new (NULL);
+  GtkWidget *child;
+
+  for (child = gtk_widget_get_first_child (GTK_WIDGET (view_switcher));
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    char *label;
+
+    g_object_get (child, "label", &label, NULL);
+    g_string_append (labels, label);
+    g_free (label);
+  }
+
+  g_assert_cmpstr (labels->str, ==, expected);
+
+  g_string_free (labels, TRUE);
+}
+
+
+static void
+test_adap_view_switcher_items_changed (void)
+{
+  AdapViewSwitcher *view_switcher = g_object_ref_sink (ADAP_VIEW_SWITCHER (adap_view_switcher_new ()));
+  AdapViewStack *stack = g_object_ref_sink (ADAP_VIEW_STACK (adap_view_stack_new ()));
+  GtkWidget *child_a = gtk_label_new ("a");
+  GtkWidget *child_b = gtk_label_new ("b");
+  GtkWidget *first_button;
+
+  adap_view_stack_add_titled (stack, child_a, NULL, "A");
+  adap_view_stack_add_titled (stack, child_b, NULL, "B");
+
+  adap_view_switcher_set_stack (view_switcher, stack);
+  assert_buttons (view_switcher, "AB");
+
+  first_button = gtk_widget_get_first_child (GTK_WIDGET (view_switcher));
+
+  adap_view_stack_add_titled (stack, gtk_label_new ("c"), NULL, "C");
+  assert_buttons (view_switcher, "ABC");
+
+  /* Existing buttons are kept */
+  g_assert_true (gtk_widget_get_first_child (GTK_WIDGET (view_switcher)) == first_button);
+
+  adap_view_stack_remove (stack, child_b);
+  assert_buttons (view_switcher, "AC");
+  g_assert_true (gtk_widget_get_first_child (GTK_WIDGET (view_switcher)) == first_button);
+
+  adap_view_stack_remove (stack, child_a);
+  assert_buttons (view_switcher, "C");
+
+  adap_view_switcher_set_stack (view_switcher, NULL);
+  assert_buttons (view_switcher, "");
+
+  g_assert_finalize_object (view_switcher);
+  g_assert_finalize_object (stack);
+}
+
+
 int
 main (int   argc,
       char *argv[])
@@ -57,6 +118,7 @@ main (int   argc,
 
   g_test_add_func("/Adapta/ViewSwitcher/policy", test_adap_view_switcher_policy);
   g_test_add_func("/Adapta/ViewSwitcher/stack", test_adap_view_switcher_stack);
+  g_test_add_func("/Adapta/ViewSwitcher/items_changed", test_adap_view_switcher_items_changed);
 
   return g_test_run();
 }